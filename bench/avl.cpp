@@ -0,0 +1,100 @@
+/**
+ * @file avl.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks the AVL balancing scheme against the red-black one
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "map.h"
+
+template <typename Map>
+void bench_map(const char *name, const std::vector<std::uint64_t> &inserted,
+               const std::vector<std::uint64_t> &keys,
+               const std::vector<std::uint64_t> &probes, std::size_t rounds)
+{
+    Map m;
+    std::uint64_t sum = 0;
+
+    double insert = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : inserted)
+                m.emplace(k, k);
+        });
+
+    // Lookups dominate: every key is found several times.
+    double find = time_ms(
+        [&]
+        {
+            for (std::size_t r = 0; r < rounds; r++)
+                for (std::uint64_t k : keys)
+                    sum += m.find(k)->second;
+        });
+
+    // Most probes miss, so lower_bound goes all the way down to a leaf.
+    double lower_bound = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : probes)
+            {
+                auto it = m.lower_bound(k);
+                if (it != m.end())
+                    sum += it->second;
+            }
+        });
+
+    double erase = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.erase(k);
+        });
+
+    std::cout << name << ": insert " << insert << " ms, find " << find
+              << " ms, lower_bound " << lower_bound << " ms, erase " << erase
+              << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n      = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t rounds = (argc > 2) ? std::stoul(argv[2]) : 4;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    std::vector<std::uint64_t> probes(n);
+    for (std::uint64_t &k : keys)
+        k = rng();
+    for (std::uint64_t &k : probes)
+        k = rng();
+
+    // Inserting ascending keys makes one side of a red-black tree about twice
+    // as deep as the other, while an AVL tree stays nearly perfectly balanced.
+    std::vector<std::uint64_t> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::cout << "n = " << n << ", find rounds = " << rounds << "\n";
+
+    std::cout << "Random insertion order\n";
+    bench_map<opendsa::map<std::uint64_t, std::uint64_t>>(
+        "red-black map", keys, keys, probes, rounds);
+    bench_map<opendsa::avl_map<std::uint64_t, std::uint64_t>>(
+        "AVL map", keys, keys, probes, rounds);
+
+    std::cout << "Ascending insertion order\n";
+    bench_map<opendsa::map<std::uint64_t, std::uint64_t>>(
+        "red-black map", sorted, keys, probes, rounds);
+    bench_map<opendsa::avl_map<std::uint64_t, std::uint64_t>>(
+        "AVL map", sorted, keys, probes, rounds);
+
+    return 0;
+}
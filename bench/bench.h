@@ -0,0 +1,29 @@
+/**
+ * @file bench.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Helpers shared by the benchmark programs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_BENCH_H
+#define __OPENDSA_BENCH_H 1
+
+#include <chrono>
+
+/**
+ * @brief Returns the wall-clock time taken by a call to @a fn, in
+ * milliseconds.
+ */
+template <typename Fn>
+double time_ms(Fn &&fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+#endif /* __OPENDSA_BENCH_H */
@@ -0,0 +1,86 @@
+/**
+ * @file btree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks opendsa::btree_map against binary search trees
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "btree_map.h"
+#include "map.h"
+
+template <typename Map>
+void bench_map(const char *name, const std::vector<std::uint64_t> &keys,
+               std::size_t scan_len)
+{
+    Map m;
+    std::uint64_t sum = 0;
+
+    double insert = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.emplace(k, k);
+        });
+
+    double find = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                sum += m.find(k)->second;
+        });
+
+    // Range queries: seek to a key, then read the following entries.
+    double range = time_ms(
+        [&]
+        {
+            for (std::size_t i = 0; i < keys.size(); i += 16)
+            {
+                auto it = m.lower_bound(keys[i]);
+                for (std::size_t j = 0; j < scan_len && it != m.end();
+                     j++, ++it)
+                    sum += it->second;
+            }
+        });
+
+    double erase = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.erase(k);
+        });
+
+    std::cout << name << ": insert " << insert << " ms, find " << find
+              << " ms, range " << range << " ms, erase " << erase
+              << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t scan_len = (argc > 2) ? std::stoul(argv[2]) : 100;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    for (std::uint64_t &k : keys)
+        k = rng();
+
+    std::cout << "n = " << n << ", range length = " << scan_len << "\n";
+    bench_map<std::map<std::uint64_t, std::uint64_t>>("std::map", keys,
+                                                      scan_len);
+    bench_map<opendsa::map<std::uint64_t, std::uint64_t>>("opendsa::map",
+                                                         keys, scan_len);
+    bench_map<opendsa::btree_map<std::uint64_t, std::uint64_t>>(
+        "opendsa::btree_map", keys, scan_len);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file bulk_load.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks loading sorted keys into ordered maps
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "map.h"
+
+using entry = std::pair<std::uint64_t, std::uint64_t>;
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<entry> snapshot(n);
+    std::vector<entry> batch(n / 4);
+    for (entry &e : snapshot)
+        e.first = e.second = rng();
+    for (entry &e : batch)
+        e.first = e.second = rng();
+
+    std::sort(snapshot.begin(), snapshot.end());
+    std::sort(batch.begin(), batch.end());
+
+    std::cout << "n = " << n << ", batch = " << batch.size() << "\n";
+
+    {
+        std::map<std::uint64_t, std::uint64_t> m;
+        double load = time_ms(
+            [&]
+            {
+                for (const entry &e : snapshot)
+                    m.emplace_hint(m.end(), e);
+            });
+        double merge = time_ms(
+            [&]
+            {
+                for (const entry &e : batch)
+                    m.insert(e);
+            });
+        std::cout << "std::map hinted insert: load " << load << " ms, merge "
+                  << merge << " ms (size " << m.size() << ")\n";
+    }
+
+    {
+        opendsa::map<std::uint64_t, std::uint64_t> m;
+        double load = time_ms(
+            [&]
+            {
+                for (const entry &e : snapshot)
+                    m.emplace_hint(m.end(), e);
+            });
+        double merge = time_ms(
+            [&]
+            {
+                for (const entry &e : batch)
+                    m.insert(e);
+            });
+        std::cout << "opendsa::map hinted insert: load " << load
+                  << " ms, merge " << merge << " ms (size " << m.size()
+                  << ")\n";
+    }
+
+    {
+        opendsa::map<std::uint64_t, std::uint64_t> m;
+        double load = time_ms(
+            [&]
+            {
+                m = opendsa::map<std::uint64_t, std::uint64_t>::from_sorted(
+                    snapshot.begin(), snapshot.end());
+            });
+        double merge = time_ms(
+            [&] { m.insert_sorted(batch.begin(), batch.end()); });
+        std::cout << "opendsa::map from_sorted: load " << load
+                  << " ms, merge " << merge << " ms (size " << m.size()
+                  << ")\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file concurrent_skip_list.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks a shared ordered index under a mix of reads and writes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "concurrent_skip_list.h"
+#include "map.h"
+
+// opendsa::map behind a global lock, the usual way to share it
+class locked_map
+{
+public:
+    bool
+    insert(std::uint64_t k, std::uint64_t v)
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _map.emplace(k, v).second;
+    }
+
+    bool
+    erase(std::uint64_t k)
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _map.erase(k) != 0;
+    }
+
+    bool
+    contains(std::uint64_t k)
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _map.find(k) != _map.end();
+    }
+
+private:
+    std::mutex _mutex;
+    opendsa::map<std::uint64_t, std::uint64_t> _map;
+};
+
+class skip_list_map
+{
+public:
+    bool
+    insert(std::uint64_t k, std::uint64_t v)
+    {
+        return _list.insert({k, v});
+    }
+
+    bool
+    erase(std::uint64_t k)
+    {
+        return _list.erase(k) != 0;
+    }
+
+    bool
+    contains(std::uint64_t k)
+    {
+        return _list.contains(k);
+    }
+
+private:
+    opendsa::concurrent_skip_list<std::uint64_t, std::uint64_t> _list;
+};
+
+// Every thread runs the same mix: 80% lookups, 10% insertions, 10% removals
+template <typename Index>
+void bench_index(const char *name, std::size_t n_threads, std::size_t n_ops,
+                 std::uint64_t key_space)
+{
+    Index index;
+    for (std::uint64_t k = 0; k < key_space; k += 2)
+        index.insert(k, k);
+
+    std::atomic<std::uint64_t> hits(0);
+    double t = time_ms(
+        [&]
+        {
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < n_threads; i++)
+                threads.emplace_back(
+                    [&, i]
+                    {
+                        std::mt19937_64 rng(i);
+                        std::uint64_t local = 0;
+                        for (std::size_t j = 0; j < n_ops; j++)
+                        {
+                            const std::uint64_t k  = rng() % key_space;
+                            const std::uint64_t op = rng() % 10;
+                            if (op == 0)
+                                local += index.insert(k, k);
+                            else if (op == 1)
+                                local += index.erase(k);
+                            else
+                                local += index.contains(k);
+                        }
+                        hits += local;
+                    });
+            for (std::thread &th : threads)
+                th.join();
+        });
+
+    std::cout << name << ": " << t << " ms (checksum " << hits << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n_threads =
+        (argc > 1) ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+    const std::size_t n_ops     = (argc > 2) ? std::stoul(argv[2]) : 1000000;
+    const std::uint64_t space   = (argc > 3) ? std::stoul(argv[3]) : 1000000;
+
+    std::cout << "threads = " << n_threads << ", operations per thread = "
+              << n_ops << ", keys = " << space << "\n";
+
+    bench_index<locked_map>("opendsa::map with a mutex", n_threads, n_ops,
+                            space);
+    bench_index<skip_list_map>("opendsa::concurrent_skip_list", n_threads,
+                               n_ops, space);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file flat_hash_map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks opendsa::flat_hash_map against std::unordered_map
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "flat_hash_map.h"
+
+template <typename Map>
+void bench_map(const char *name, const std::vector<std::uint64_t> &keys,
+               const std::vector<std::uint64_t> &probes)
+{
+    Map m;
+    std::uint64_t sum = 0;
+
+    double insert = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.emplace(k, k);
+        });
+
+    double hit = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : probes)
+                sum += m.find(k)->second;
+        });
+
+    // Keys that are not in the map
+    double miss = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : probes)
+                sum += m.count(~k);
+        });
+
+    double erase = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.erase(k);
+        });
+
+    std::cout << name << ": insert " << insert << " ms, find hit " << hit
+              << " ms, find miss " << miss << " ms, erase " << erase
+              << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t queries = (argc > 2) ? std::stoul(argv[2]) : 10000000;
+
+    // Odd keys, so that the complement of a key is never a key
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    for (std::uint64_t &k : keys)
+        k = rng() | 1;
+
+    std::vector<std::uint64_t> probes(queries);
+    for (std::uint64_t &k : probes)
+        k = keys[rng() % n];
+
+    std::cout << "n = " << n << ", queries = " << queries << "\n";
+    bench_map<std::unordered_map<std::uint64_t, std::uint64_t>>(
+        "std::unordered_map", keys, probes);
+    bench_map<opendsa::flat_hash_map<std::uint64_t, std::uint64_t>>(
+        "opendsa::flat_hash_map", keys, probes);
+
+    return 0;
+}
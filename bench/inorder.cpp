@@ -0,0 +1,91 @@
+/**
+ * @file inorder.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks full in-order scans of ordered maps
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "map.h"
+
+template <typename Map>
+Map make_map(const std::vector<std::uint64_t> &keys)
+{
+    Map m;
+    for (std::uint64_t k : keys)
+        m.emplace(k, k);
+    return m;
+}
+
+template <typename Map>
+double scan_iterators(const Map &m, std::size_t rounds, std::uint64_t &sum)
+{
+    return time_ms(
+        [&]
+        {
+            for (std::size_t r = 0; r < rounds; r++)
+                for (const auto &e : m)
+                    sum += e.second;
+        });
+}
+
+template <typename Map>
+double scan_for_each(const Map &m, std::size_t rounds, std::uint64_t &sum)
+{
+    return time_ms(
+        [&]
+        {
+            for (std::size_t r = 0; r < rounds; r++)
+                m.for_each_inorder([&sum](const auto &e) { sum += e.second; });
+        });
+}
+
+void bench(const char *order, const std::vector<std::uint64_t> &keys,
+           std::size_t rounds)
+{
+    using opendsa_map = opendsa::map<std::uint64_t, std::uint64_t>;
+
+    auto sm = make_map<std::map<std::uint64_t, std::uint64_t>>(keys);
+    auto om = make_map<opendsa_map>(keys);
+
+    std::uint64_t sum = 0;
+    double t_std      = scan_iterators(sm, rounds, sum);
+    double t_iter     = scan_iterators(om, rounds, sum);
+    double t_each     = scan_for_each(om, rounds, sum);
+
+    std::cout << order << ": std::map iterators " << t_std
+              << " ms, opendsa::map iterators " << t_iter
+              << " ms, opendsa::map for_each_inorder " << t_each
+              << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n      = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t rounds = (argc > 2) ? std::stoul(argv[2]) : 10;
+
+    std::vector<std::uint64_t> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    std::cout << "n = " << n << ", rounds = " << rounds << "\n";
+
+    // Nodes are allocated in insertion order, so inserting ascending keys
+    // lays the nodes out in key order while random keys scatter them.
+    bench("ascending insertion", keys, rounds);
+
+    std::mt19937_64 rng(42);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    bench("random insertion", keys, rounds);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file interval_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks overlap queries of time ranges
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "interval_tree.h"
+
+int main(int argc, const char **argv)
+{
+    using interval = opendsa::interval<std::int64_t>;
+    using element  = std::pair<interval, std::uint32_t>;
+
+    const std::size_t n         = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t n_queries = (argc > 2) ? std::stoul(argv[2]) : 1000;
+
+    // Sessions of a few seconds to an hour spread over a year, in seconds
+    const std::int64_t horizon = 365 * 24 * 3600;
+    std::mt19937_64 rng(42);
+    std::vector<element> elements;
+    elements.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const std::int64_t low = std::int64_t(rng() % horizon);
+        elements.emplace_back(
+            interval{low, low + 1 + std::int64_t(rng() % 3600)},
+            std::uint32_t(i));
+    }
+
+    std::vector<interval> queries(n_queries);
+    for (interval &q : queries)
+    {
+        q.low  = std::int64_t(rng() % horizon);
+        q.high = q.low + 1 + std::int64_t(rng() % 600);
+    }
+
+    std::cout << "n = " << n << ", queries = " << n_queries << "\n";
+
+    // Baseline: scan every interval
+    {
+        std::uint64_t sum = 0;
+        double t          = time_ms(
+            [&]
+            {
+                for (const interval &q : queries)
+                    for (const element &e : elements)
+                        if (e.first.overlaps(q.low, q.high))
+                            sum += e.second;
+            });
+        std::cout << "linear scan: " << t << " ms (checksum " << sum << ")\n";
+    }
+
+    {
+        std::vector<element> sorted(elements.begin(), elements.end());
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const element &a, const element &b)
+                  { return a.first < b.first; });
+
+        opendsa::interval_tree<std::int64_t, std::uint32_t> tree;
+        double t_build = time_ms(
+            [&]
+            {
+                tree = opendsa::interval_tree<std::int64_t, std::uint32_t>::
+                    from_sorted(sorted.begin(), sorted.end());
+            });
+
+        std::uint64_t sum = 0;
+        double t          = time_ms(
+            [&]
+            {
+                for (const interval &q : queries)
+                {
+                    auto range = tree.overlapping(q.low, q.high);
+                    for (auto it = range.first; it != range.second; ++it)
+                        sum += it->second;
+                }
+            });
+        std::cout << "interval_tree: build " << t_build << " ms, queries " << t
+                  << " ms (checksum " << sum << ")\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks opendsa::map against std::map
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "map.h"
+
+template <typename Map>
+void bench_map(const char *name, const std::vector<std::uint64_t> &keys)
+{
+    Map m;
+    std::uint64_t sum = 0;
+
+    double insert = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.emplace(k, k);
+        });
+
+    double find = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                sum += m.find(k)->second;
+        });
+
+    double scan = time_ms(
+        [&]
+        {
+            for (const auto &kv : m)
+                sum += kv.second;
+        });
+
+    Map copy(m);
+    double clear = time_ms([&] { copy.clear(); });
+
+    double erase = time_ms(
+        [&]
+        {
+            for (std::uint64_t k : keys)
+                m.erase(k);
+        });
+
+    std::cout << name << ": insert " << insert << " ms, find " << find
+              << " ms, scan " << scan << " ms, clear " << clear
+              << " ms, erase " << erase << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    for (std::uint64_t &k : keys)
+        k = rng();
+
+    std::cout << "n = " << n << "\n";
+    bench_map<std::map<std::uint64_t, std::uint64_t>>("std::map", keys);
+    bench_map<opendsa::map<std::uint64_t, std::uint64_t>>("opendsa::map",
+                                                         keys);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file median.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks the median of two sorted latency histograms
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "algorithm.h"
+#include "bench.h"
+
+// Merges the two arrays up to their middle, as opendsa::median used to
+double merge_median(std::vector<std::uint32_t> a, std::vector<std::uint32_t> b)
+{
+    const std::size_t total = a.size() + b.size();
+    std::size_t i = 0, j = 0;
+    std::uint32_t prev = 0, curr = 0;
+
+    for (std::size_t n = 0; n <= total / 2; n++)
+    {
+        prev = curr;
+        if (j == b.size() || (i < a.size() && a[i] < b[j]))
+            curr = a[i++];
+        else
+            curr = b[j++];
+    }
+
+    return total % 2 == 1 ? curr : (double(prev) + curr) / 2;
+}
+
+std::vector<std::uint32_t> latencies(std::mt19937_64 &rng, std::size_t n,
+                                     double mean)
+{
+    std::lognormal_distribution<double> dist(std::log(mean), 0.5);
+    std::vector<std::uint32_t> res(n);
+    for (std::uint32_t &x : res)
+        x = static_cast<std::uint32_t>(dist(rng));
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n       = (argc > 1) ? std::stoul(argv[1]) : 4000000;
+    const std::size_t queries = (argc > 2) ? std::stoul(argv[2]) : 100;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint32_t> a = latencies(rng, n, 800);
+    std::vector<std::uint32_t> b = latencies(rng, n / 2 + 1, 1200);
+
+    // Each query looks at a different prefix of the histograms, i.e. a
+    // different time window
+    double sum = 0;
+    double t   = time_ms(
+        [&]
+        {
+            for (std::size_t q = 0; q < queries; q++)
+            {
+                std::size_t m = a.size() - q;
+                sum += merge_median(std::vector<std::uint32_t>(
+                                        a.begin(), a.begin() + m),
+                                    b);
+            }
+        });
+    std::cout << "Merge to the middle: " << t << " ms (checksum " << sum
+              << ")\n";
+
+    sum = 0;
+    t   = time_ms(
+        [&]
+        {
+            for (std::size_t q = 0; q < queries; q++)
+            {
+                std::size_t m = a.size() - q;
+                sum += opendsa::median(std::span(a.data(), m), b);
+            }
+        });
+    std::cout << "opendsa::median: " << t << " ms (checksum " << sum << ")\n";
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file merge.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks k-way merges of sorted runs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "merge.h"
+
+using run_type = std::vector<std::uint64_t>;
+
+std::uint64_t checksum(const std::vector<std::uint64_t> &out)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < out.size(); i += 4099)
+        sum += out[i] * (i + 1);
+    return sum;
+}
+
+// Pops the smallest head from a binary heap of (head, run) pairs
+void heap_merge(const std::vector<run_type> &runs,
+                std::vector<std::uint64_t> &out)
+{
+    using entry = std::pair<std::uint64_t, std::size_t>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+    std::vector<std::size_t> pos(runs.size(), 0);
+    for (std::size_t r = 0; r < runs.size(); r++)
+        if (!runs[r].empty())
+            heap.push({runs[r][0], r});
+
+    while (!heap.empty())
+    {
+        auto [key, r] = heap.top();
+        heap.pop();
+        out.push_back(key);
+        if (++pos[r] < runs[r].size())
+            heap.push({runs[r][pos[r]], r});
+    }
+}
+
+// Merges the runs two by two, log2(k) passes over the data
+void pairwise_merge(const std::vector<run_type> &runs,
+                    std::vector<std::uint64_t> &out)
+{
+    std::vector<run_type> level(runs);
+    while (level.size() > 1)
+    {
+        std::vector<run_type> next;
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2)
+        {
+            run_type merged(level[i].size() + level[i + 1].size());
+            std::merge(level[i].begin(), level[i].end(), level[i + 1].begin(),
+                       level[i + 1].end(), merged.begin());
+            next.push_back(std::move(merged));
+        }
+        if (level.size() % 2 == 1)
+            next.push_back(std::move(level.back()));
+        level = std::move(next);
+    }
+    out = std::move(level[0]);
+}
+
+template <typename Fn>
+void bench(const char *name, const std::vector<run_type> &runs,
+           std::size_t total, Fn &&merge)
+{
+    std::vector<std::uint64_t> out;
+    out.reserve(total);
+    double t = time_ms([&] { merge(out); });
+    std::cout << name << ": " << t << " ms (checksum " << checksum(out)
+              << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t k = (argc > 1) ? std::stoul(argv[1]) : 64;
+    const std::size_t n = (argc > 2) ? std::stoul(argv[2]) : 16000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<run_type> runs(k);
+    for (std::size_t i = 0; i < n; i++)
+        runs[rng() % k].push_back(rng());
+    for (run_type &run : runs)
+        std::sort(run.begin(), run.end());
+
+    bench("Binary heap", runs, n,
+          [&](std::vector<std::uint64_t> &out) { heap_merge(runs, out); });
+    bench("Pairwise std::merge", runs, n,
+          [&](std::vector<std::uint64_t> &out) { pairwise_merge(runs, out); });
+
+    // A comparator other than std::less takes the generic loser tree
+    bench("loser_tree", runs, n,
+          [&](std::vector<std::uint64_t> &out)
+          {
+              opendsa::multiway_merge(
+                  runs, std::back_inserter(out),
+                  [](std::uint64_t a, std::uint64_t b) { return a < b; });
+          });
+    bench("multiway_merge, arithmetic keys", runs, n,
+          [&](std::vector<std::uint64_t> &out)
+          { opendsa::multiway_merge(runs, std::back_inserter(out)); });
+
+    // The same runs in the library's own vectors, which are read through
+    // their data() pointers
+    opendsa::vector<opendsa::vector<std::uint64_t>> own_runs(k);
+    for (std::size_t r = 0; r < k; r++)
+    {
+        opendsa::vector<std::uint64_t> run(runs[r].begin(), runs[r].end());
+        own_runs[r].swap(run);
+    }
+
+    bench("loser_tree on opendsa::vector", runs, n,
+          [&](std::vector<std::uint64_t> &out)
+          {
+              opendsa::multiway_merge(
+                  own_runs, std::back_inserter(out),
+                  [](std::uint64_t a, std::uint64_t b) { return a < b; });
+          });
+    bench("multiway_merge on opendsa::vector", runs, n,
+          [&](std::vector<std::uint64_t> &out)
+          { opendsa::multiway_merge(own_runs, std::back_inserter(out)); });
+
+    return 0;
+}
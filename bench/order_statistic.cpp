@@ -0,0 +1,86 @@
+/**
+ * @file order_statistic.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks rolling percentiles over a sliding window
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "set.h"
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n      = (argc > 1) ? std::stoul(argv[1]) : 50000;
+    const std::size_t window = (argc > 2) ? std::stoul(argv[2]) : 10000;
+    const std::size_t every  = (argc > 3) ? std::stoul(argv[3]) : 10;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> stream(n + window);
+    for (std::uint64_t &x : stream)
+        x = rng();
+
+    std::cout << "n = " << n << ", window = " << window
+              << ", query every = " << every << "\n";
+
+    // Baseline: keep the window in a vector and sort a copy on every query.
+    {
+        std::vector<std::uint64_t> live(stream.begin(),
+                                        stream.begin() + window);
+        std::vector<std::uint64_t> sorted;
+        std::uint64_t sum = 0;
+
+        double t = time_ms(
+            [&]
+            {
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    live[i % window] = stream[window + i];
+                    if (i % every == 0)
+                    {
+                        sorted = live;
+                        std::sort(sorted.begin(), sorted.end());
+                        sum += sorted[window / 2] + sorted[window * 99 / 100];
+                        sum += std::lower_bound(sorted.begin(), sorted.end(),
+                                                stream[i]) -
+                               sorted.begin();
+                    }
+                }
+            });
+        std::cout << "sorted vector: " << t << " ms (checksum " << sum
+                  << ")\n";
+    }
+
+    {
+        opendsa::order_statistic_set<std::uint64_t> live(
+            stream.begin(), stream.begin() + window);
+        std::uint64_t sum = 0;
+
+        double t = time_ms(
+            [&]
+            {
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    live.erase(stream[i]);
+                    live.insert(stream[window + i]);
+                    if (i % every == 0)
+                    {
+                        sum += *live.select(window / 2) +
+                               *live.select(window * 99 / 100);
+                        sum += live.rank(stream[i]);
+                    }
+                }
+            });
+        std::cout << "order_statistic_set: " << t << " ms (checksum " << sum
+                  << ")\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file parallel_sort.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks parallel_sort against std::sort
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "bench.h"
+#include "sort.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 20000000;
+    const std::size_t threads =
+        (argc > 2) ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+
+    std::mt19937_64 rng(42);
+    opendsa::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; i++)
+        keys[i] = rng();
+
+    opendsa::vector<std::uint64_t> v(keys);
+    double t = time_ms([&] { std::sort(v.begin(), v.end()); });
+    std::cout << "std::sort: " << t << " ms (checksum " << v[n / 2] << ")\n";
+
+    opendsa::thread_pool pool(threads);
+
+    opendsa::vector<std::uint64_t> w(keys);
+    t = time_ms([&] { opendsa::parallel_sort(w, std::less<>(), pool); });
+    std::cout << "parallel_sort, " << pool.size() << " threads: " << t
+              << " ms (checksum " << w[n / 2] << ")\n";
+
+    opendsa::vector<std::uint64_t> x(keys);
+    t = time_ms([&] { std::stable_sort(x.begin(), x.end()); });
+    std::cout << "std::stable_sort: " << t << " ms (checksum " << x[n / 2]
+              << ")\n";
+
+    opendsa::vector<std::uint64_t> y(keys);
+    t = time_ms([&]
+                { opendsa::parallel_stable_sort(y, std::less<>(), pool); });
+    std::cout << "parallel_stable_sort, " << pool.size() << " threads: " << t
+              << " ms (checksum " << y[n / 2] << ")\n";
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file persistent_map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks a writer that publishes periodic snapshots of a map
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "map.h"
+#include "persistent_map.h"
+
+// Applies the updates and takes a snapshot every so often, keeping the last
+// one alive as a reader would.
+template <typename Map>
+void bench_map(const char *name, const std::vector<std::uint64_t> &keys,
+               const std::vector<std::uint64_t> &updates, std::size_t every)
+{
+    Map m;
+    for (std::uint64_t k : keys)
+        m.insert_or_assign(k, k);
+
+    std::uint64_t sum = 0;
+    double t          = time_ms(
+        [&]
+        {
+            Map snapshot(m);
+            for (std::size_t i = 0; i < updates.size(); i++)
+            {
+                m.insert_or_assign(updates[i], i);
+                if (i % every == 0)
+                {
+                    Map next(m);
+                    sum += next.size();
+                    snapshot = std::move(next);
+                }
+            }
+            sum += snapshot.size();
+        });
+
+    std::cout << name << ": " << t << " ms (checksum " << sum << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n     = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const std::size_t n_upd = (argc > 2) ? std::stoul(argv[2]) : 1000000;
+    const std::size_t every = (argc > 3) ? std::stoul(argv[3]) : 10000;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(n);
+    for (std::uint64_t &k : keys)
+        k = rng();
+
+    // Half of the updates overwrite existing keys
+    std::vector<std::uint64_t> updates(n_upd);
+    for (std::uint64_t &k : updates)
+        k = (rng() % 2) ? keys[rng() % n] : rng();
+
+    std::cout << "n = " << n << ", updates = " << n_upd
+              << ", snapshot every = " << every << "\n";
+
+    bench_map<opendsa::map<std::uint64_t, std::uint64_t>>(
+        "opendsa::map deep copies", keys, updates, every);
+    bench_map<opendsa::persistent_map<std::uint64_t, std::uint64_t>>(
+        "opendsa::persistent_map snapshots", keys, updates, every);
+
+    return 0;
+}
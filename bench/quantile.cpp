@@ -0,0 +1,85 @@
+/**
+ * @file quantile.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks the p99 latency of a stream, exactly and with a sketch
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "quantile.h"
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n     = (argc > 1) ? std::stoul(argv[1]) : 20000000;
+    const std::size_t batch = (argc > 2) ? std::stoul(argv[2]) : 4096;
+
+    std::mt19937_64 rng(42);
+    std::lognormal_distribution<double> dist(std::log(800.0), 0.7);
+    std::vector<std::uint32_t> events(n);
+    for (std::uint32_t &x : events)
+        x = static_cast<std::uint32_t>(dist(rng));
+
+    // Keeps every event and selects the p99 at the end
+    std::uint32_t exact = 0;
+    double t            = time_ms(
+        [&]
+        {
+            std::vector<std::uint32_t> kept;
+            for (std::uint32_t x : events)
+                kept.push_back(x);
+            auto rank = static_cast<std::size_t>(std::ceil(0.99 * n)) - 1;
+            std::nth_element(kept.begin(), kept.begin() + rank, kept.end());
+            exact = kept[rank];
+        });
+    std::cout << "Exact, " << n * sizeof(std::uint32_t) << " bytes: " << t
+              << " ms (p99 " << exact << ")\n";
+
+    std::uint32_t p99  = 0;
+    std::size_t values = 0;
+    t                  = time_ms(
+        [&]
+        {
+            opendsa::kll_sketch<std::uint32_t> sketch;
+            for (std::uint32_t x : events)
+                sketch.insert(x);
+            p99    = sketch.quantile(0.99);
+            values = sketch.retained();
+        });
+    std::cout << "kll_sketch, " << values << " values: " << t << " ms (p99 "
+              << p99 << ")\n";
+
+    // Four sketches fed by batches, as per-thread sketches would be, then
+    // merged
+    t = time_ms(
+        [&]
+        {
+            opendsa::kll_sketch<std::uint32_t> shards[4];
+            opendsa::vector<std::uint32_t> buffer;
+            buffer.reserve(batch);
+            for (std::size_t i = 0; i < n; i += batch)
+            {
+                buffer.clear();
+                for (std::size_t j = i; j < std::min(n, i + batch); j++)
+                    buffer.push_back(events[j]);
+                shards[(i / batch) % 4].insert(buffer);
+            }
+
+            for (int s = 1; s < 4; s++)
+                shards[0].merge(shards[s]);
+            p99    = shards[0].quantile(0.99);
+            values = shards[0].retained();
+        });
+    std::cout << "kll_sketch, batches and merges, " << values
+              << " values: " << t << " ms (p99 " << p99 << ")\n";
+
+    return 0;
+}
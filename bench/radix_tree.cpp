@@ -0,0 +1,109 @@
+/**
+ * @file radix_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks longest-prefix matching of URL routes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "radix_tree.h"
+
+// Builds a path of 1 to max_depth segments picked among a few names per level
+std::string random_path(std::mt19937_64 &rng, std::size_t max_depth,
+                        std::size_t fanout)
+{
+    static const char *words[] = {"api",   "v1",     "v2",    "users",
+                                  "items", "orders", "admin", "static",
+                                  "img",   "css",    "js",    "search"};
+    constexpr std::size_t n_words = sizeof(words) / sizeof(words[0]);
+
+    std::string path;
+    const std::size_t depth = 1 + rng() % max_depth;
+    for (std::size_t i = 0; i < depth; i++)
+    {
+        path += '/';
+        path += words[rng() % n_words];
+        path += std::to_string(rng() % fanout);
+    }
+    return path;
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n_routes  = (argc > 1) ? std::stoul(argv[1]) : 100000;
+    const std::size_t n_queries = (argc > 2) ? std::stoul(argv[2]) : 1000000;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::string> routes(n_routes);
+    for (std::string &r : routes)
+        r = random_path(rng, 4, 8);
+
+    // Requests extend a route with a few more segments
+    std::vector<std::string> queries(n_queries);
+    for (std::string &q : queries)
+        q = routes[rng() % n_routes] + random_path(rng, 3, 100);
+
+    std::cout << "routes = " << n_routes << ", queries = " << n_queries
+              << "\n";
+
+    // Baseline: hash every prefix of the request, longest first. A route may
+    // end anywhere, e.g. "/img1" also matches "/img12/a.png".
+    {
+        std::unordered_map<std::string_view, std::size_t> table;
+        for (std::size_t i = 0; i < routes.size(); i++)
+            table.emplace(routes[i], i);
+
+        std::uint64_t sum = 0;
+        double t          = time_ms(
+            [&]
+            {
+                for (const std::string &q : queries)
+                {
+                    std::string_view path = q;
+                    for (std::size_t len = path.size(); len > 0; len--)
+                    {
+                        auto it = table.find(path.substr(0, len));
+                        if (it != table.end())
+                        {
+                            sum += it->second;
+                            break;
+                        }
+                    }
+                }
+            });
+        std::cout << "std::unordered_map probing: " << t << " ms (checksum "
+                  << sum << ")\n";
+    }
+
+    {
+        opendsa::radix_tree<std::size_t> tree;
+        for (std::size_t i = 0; i < routes.size(); i++)
+            tree.try_emplace(routes[i], i);
+
+        std::uint64_t sum = 0;
+        double t          = time_ms(
+            [&]
+            {
+                for (const std::string &q : queries)
+                {
+                    auto it = tree.longest_prefix_match(q);
+                    if (it != tree.end())
+                        sum += it->second;
+                }
+            });
+        std::cout << "opendsa::radix_tree: " << t << " ms (checksum " << sum
+                  << ")\n";
+    }
+
+    return 0;
+}
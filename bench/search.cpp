@@ -0,0 +1,78 @@
+/**
+ * @file search.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks the searches of search.h against std::lower_bound
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "bench.h"
+#include "search.h"
+#include "vector.h"
+
+void bench_search(std::size_t n, std::size_t queries)
+{
+    // Sorted keys of the build side of a join, and the keys of the probes
+    std::mt19937_64 rng(42);
+    opendsa::vector<std::uint64_t> table(n);
+    for (std::size_t i = 0; i < n; i++)
+        table[i] = rng();
+    std::sort(table.begin(), table.end());
+
+    opendsa::vector<std::uint64_t> probes(queries);
+    for (std::size_t i = 0; i < queries; i++)
+        probes[i] = rng();
+
+    std::size_t sum_std = 0;
+    double t_std        = time_ms(
+        [&]
+        {
+            for (std::size_t i = 0; i < queries; i++)
+                sum_std += std::lower_bound(table.begin(), table.end(),
+                                            probes[i]) -
+                           table.begin();
+        });
+
+    std::size_t sum_one = 0;
+    double t_one        = time_ms(
+        [&]
+        {
+            for (std::size_t i = 0; i < queries; i++)
+                sum_one += opendsa::lower_bound(table, probes[i]);
+        });
+
+    std::size_t sum_batch = 0;
+    double t_batch        = time_ms(
+        [&]
+        {
+            auto pos = opendsa::lower_bound_batch(table, probes);
+            for (std::size_t i = 0; i < queries; i++)
+                sum_batch += pos[i];
+        });
+
+    std::cout << "n = " << n << ": std::lower_bound " << t_std
+              << " ms, lower_bound " << t_one << " ms, lower_bound_batch "
+              << t_batch << " ms"
+              << (sum_std == sum_one && sum_std == sum_batch ? ""
+                                                             : " (MISMATCH)")
+              << "\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t queries = (argc > 1) ? std::stoul(argv[1]) : 4000000;
+
+    std::cout << "uint64, queries = " << queries << "\n";
+
+    for (std::size_t n : {std::size_t(1) << 12, std::size_t(1) << 20,
+                          std::size_t(1) << 26})
+        bench_search(n, queries);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file sort.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks radix_sort against std::sort on 64-bit keys
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "bench.h"
+#include "sort.h"
+#include "vector.h"
+
+struct record
+{
+    std::uint64_t key;
+    std::uint32_t payload;
+};
+
+template <typename T>
+std::uint64_t checksum(const opendsa::vector<T> &v)
+{
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < v.size(); i += 997)
+        sum = sum * 31 + v[i];
+    return sum;
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 20000000;
+
+    std::mt19937_64 rng(42);
+    opendsa::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; i++)
+        keys[i] = rng();
+
+    opendsa::vector<std::uint64_t> v(keys);
+    double t = time_ms([&] { std::sort(v.begin(), v.end()); });
+    std::cout << "std::sort u64: " << t << " ms (checksum " << checksum(v)
+              << ")\n";
+
+    opendsa::vector<std::uint64_t> w(keys);
+    t = time_ms([&] { opendsa::radix_sort(w); });
+    std::cout << "radix_sort u64: " << t << " ms (checksum " << checksum(w)
+              << ")\n";
+
+    opendsa::vector<double> d(n);
+    std::normal_distribution<double> dist(0, 1e6);
+    for (std::size_t i = 0; i < n; i++)
+        d[i] = dist(rng);
+
+    opendsa::vector<double> e(d);
+    t = time_ms([&] { std::sort(e.begin(), e.end()); });
+    std::cout << "std::sort double: " << t << " ms (checksum "
+              << std::uint64_t(e[n / 2]) << ")\n";
+
+    t = time_ms([&] { opendsa::radix_sort(d); });
+    std::cout << "radix_sort double: " << t << " ms (checksum "
+              << std::uint64_t(d[n / 2]) << ")\n";
+
+    opendsa::vector<record> recs(n), recs2(n);
+    for (std::size_t i = 0; i < n; i++)
+        recs[i] = recs2[i] = {keys[i] % 1000000, std::uint32_t(i)};
+
+    t = time_ms(
+        [&]
+        {
+            std::stable_sort(recs.begin(), recs.end(),
+                             [](const record &a, const record &b)
+                             { return a.key < b.key; });
+        });
+    std::cout << "std::stable_sort records: " << t << " ms (payload "
+              << recs[n / 2].payload << ")\n";
+
+    t = time_ms([&] { opendsa::radix_sort(recs2, &record::key); });
+    std::cout << "radix_sort records: " << t << " ms (payload "
+              << recs2[n / 2].payload << ")\n";
+
+    return 0;
+}
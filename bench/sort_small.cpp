@@ -0,0 +1,64 @@
+/**
+ * @file sort_small.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks sort_small against std::sort on many tiny arrays
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "bench.h"
+#include "sort.h"
+#include "vector.h"
+
+template <typename T, typename Gen>
+void run(const char *name, std::size_t size, std::size_t arrays, Gen gen)
+{
+    std::mt19937_64 rng(size);
+    opendsa::vector<T> data(size * arrays);
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = gen(rng);
+
+    opendsa::vector<T> a(data);
+    double t = time_ms(
+        [&]
+        {
+            for (std::size_t i = 0; i < arrays; i++)
+                std::sort(a.data() + i * size, a.data() + (i + 1) * size);
+        });
+    std::cout << name << " x" << size << " std::sort: " << t << " ms (first "
+              << a[0] << ")\n";
+
+    opendsa::vector<T> b(data);
+    t = time_ms(
+        [&]
+        {
+            for (std::size_t i = 0; i < arrays; i++)
+                opendsa::sort_small(b.data() + i * size,
+                                    b.data() + (i + 1) * size);
+        });
+    std::cout << name << " x" << size << " sort_small: " << t << " ms (first "
+              << b[0] << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t total = (argc > 1) ? std::stoul(argv[1]) : 16000000;
+
+    for (std::size_t size : {8, 16, 33, 64})
+    {
+        run<std::int32_t>("int32", size, total / size,
+                          [](auto &rng) { return std::int32_t(rng()); });
+        run<float>("float", size, total / size,
+                   [](auto &rng) { return float(rng() % 100000) / 7; });
+        run<std::int64_t>("int64", size, total / size,
+                          [](auto &rng) { return std::int64_t(rng()); });
+    }
+
+    return 0;
+}
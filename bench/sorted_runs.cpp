@@ -0,0 +1,98 @@
+/**
+ * @file sorted_runs.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks latency percentiles over sorted per-shard runs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "algorithm.h"
+#include "bench.h"
+
+int main(int argc, const char **argv)
+{
+    const std::size_t shards = (argc > 1) ? std::stoul(argv[1]) : 48;
+    const std::size_t n      = (argc > 2) ? std::stoul(argv[2]) : 200000;
+
+    // Each shard sees a slightly different latency distribution
+    std::mt19937_64 rng(42);
+    std::vector<std::vector<std::uint32_t>> runs(shards);
+    for (std::size_t s = 0; s < shards; s++)
+    {
+        std::lognormal_distribution<double> dist(std::log(500.0 + 20 * s),
+                                                 0.6);
+        runs[s].resize(n);
+        for (std::uint32_t &x : runs[s])
+            x = static_cast<std::uint32_t>(dist(rng));
+        std::sort(runs[s].begin(), runs[s].end());
+    }
+
+    const opendsa::vector<double> fractions = {0.5, 0.99, 0.999};
+    const std::size_t total                 = shards * n;
+
+    // Copies the runs together and selects each percentile in linear time
+    std::uint64_t sum = 0;
+    double t          = time_ms(
+        [&]
+        {
+            std::vector<std::uint32_t> all;
+            all.reserve(total);
+            for (const auto &run : runs)
+                all.insert(all.end(), run.begin(), run.end());
+            for (std::size_t i = 0; i < fractions.size(); i++)
+            {
+                auto rank = static_cast<std::size_t>(
+                    std::ceil(fractions[i] * static_cast<double>(total)));
+                std::nth_element(all.begin(), all.begin() + rank - 1,
+                                 all.end());
+                sum += all[rank - 1];
+            }
+        });
+    std::cout << "Copy and nth_element: " << t << " ms (checksum " << sum
+              << ")\n";
+
+    sum = 0;
+    t   = time_ms(
+        [&]
+        {
+            std::vector<std::span<const std::uint32_t>> spans(runs.begin(),
+                                                              runs.end());
+            opendsa::vector<std::uint32_t> res =
+                opendsa::quantiles_of_sorted_runs(spans, fractions);
+            for (std::size_t i = 0; i < res.size(); i++)
+                sum += res[i];
+        });
+    std::cout << "quantiles_of_sorted_runs: " << t << " ms (checksum " << sum
+              << ")\n";
+
+    // The same runs in the library's own vectors, searched in place
+    opendsa::vector<opendsa::vector<std::uint32_t>> own_runs(shards);
+    for (std::size_t s = 0; s < shards; s++)
+    {
+        opendsa::vector<std::uint32_t> run(runs[s].begin(), runs[s].end());
+        own_runs[s].swap(run);
+    }
+
+    sum = 0;
+    t   = time_ms(
+        [&]
+        {
+            opendsa::vector<std::uint32_t> res =
+                opendsa::quantiles_of_sorted_runs(own_runs, fractions);
+            for (std::size_t i = 0; i < res.size(); i++)
+                sum += res[i];
+        });
+    std::cout << "quantiles_of_sorted_runs on opendsa::vector: " << t
+              << " ms (checksum " << sum << ")\n";
+
+    return 0;
+}
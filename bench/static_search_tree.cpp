@@ -0,0 +1,83 @@
+/**
+ * @file static_search_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks opendsa::static_search_tree against std::lower_bound
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "static_search_tree.h"
+#include "vector.h"
+
+template <typename Key>
+void bench_search(const char *name, std::size_t n, std::size_t queries)
+{
+    std::mt19937_64 rng(42);
+    std::vector<Key> keys(n);
+    for (Key &k : keys)
+        k = static_cast<Key>(rng());
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<Key> probes(queries);
+    for (Key &k : probes)
+        k = static_cast<Key>(rng());
+
+    opendsa::vector<Key> sorted(keys.begin(), keys.end());
+    opendsa::static_search_tree<Key> tree(sorted);
+
+    std::uint64_t sum_std = 0;
+
+    double t_std = time_ms(
+        [&]
+        {
+            for (Key k : probes)
+            {
+                auto it = std::lower_bound(keys.begin(), keys.end(), k);
+                if (it != keys.end())
+                    sum_std += *it;
+            }
+        });
+
+    std::uint64_t sum_tree = 0;
+
+    double t_tree = time_ms(
+        [&]
+        {
+            for (Key k : probes)
+            {
+                auto it = tree.lower_bound(k);
+                if (it != tree.end())
+                    sum_tree += *it;
+            }
+        });
+
+    std::cout << name << ", n = " << keys.size()
+              << ": std::lower_bound " << t_std
+              << " ms, static_search_tree " << t_tree << " ms"
+              << (sum_std == sum_tree ? "" : " (MISMATCH)") << "\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t queries = (argc > 1) ? std::stoul(argv[1]) : 4000000;
+
+    std::cout << "queries = " << queries << "\n";
+
+    for (std::size_t n : {std::size_t(1) << 10, std::size_t(1) << 16,
+                          std::size_t(1) << 20, std::size_t(1) << 24})
+    {
+        bench_search<std::uint32_t>("uint32", n, queries);
+        bench_search<std::uint64_t>("uint64", n, queries);
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file top_k.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks top_k against std::partial_sort and std::sort
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+
+#include "bench.h"
+#include "top_k.h"
+#include "vector.h"
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 10000000;
+    const std::size_t k = (argc > 2) ? std::stoul(argv[2]) : 100;
+
+    // Scores of the candidates of a request
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<float> dist(0, 1);
+    opendsa::vector<float> scores(n);
+    for (std::size_t i = 0; i < n; i++)
+        scores[i] = dist(rng);
+
+    double sum = 0;
+    double t   = time_ms(
+        [&]
+        {
+            opendsa::vector<float> all(scores);
+            std::sort(all.begin(), all.end(), std::greater<>());
+            for (std::size_t i = 0; i < k; i++)
+                sum += all[i];
+        });
+    std::cout << "Copy and std::sort: " << t << " ms (checksum " << sum
+              << ")\n";
+
+    sum = 0;
+    t   = time_ms(
+        [&]
+        {
+            opendsa::vector<float> all(scores);
+            std::partial_sort(all.begin(), all.begin() + k, all.end(),
+                              std::greater<>());
+            for (std::size_t i = 0; i < k; i++)
+                sum += all[i];
+        });
+    std::cout << "Copy and std::partial_sort: " << t << " ms (checksum "
+              << sum << ")\n";
+
+    sum = 0;
+    t   = time_ms(
+        [&]
+        {
+            opendsa::vector<float> res = opendsa::top_k(scores, k);
+            for (std::size_t i = 0; i < res.size(); i++)
+                sum += res[i];
+        });
+    std::cout << "top_k: " << t << " ms (checksum " << sum << ")\n";
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file treap.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Benchmarks set operations on posting lists against a linear merge
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "set.h"
+#include "treap.h"
+
+std::vector<std::uint64_t> posting_list(std::mt19937_64 &rng, std::size_t n,
+                                        std::uint64_t range)
+{
+    std::vector<std::uint64_t> list(n);
+    for (std::uint64_t &k : list)
+        k = rng() % range;
+    std::sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+    return list;
+}
+
+// Intersects and unites ordered sets of the lists built beforehand, by
+// merging them into new sets
+void bench_merge(const char *name, const std::vector<std::uint64_t> &a,
+                 const std::vector<std::uint64_t> &b)
+{
+    using set_type = opendsa::set<std::uint64_t>;
+
+    set_type sa = set_type::from_sorted(a.begin(), a.end());
+    set_type sb = set_type::from_sorted(b.begin(), b.end());
+    set_type res;
+    double t = time_ms(
+        [&]
+        {
+            std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(),
+                                  std::inserter(res, res.end()));
+        });
+    std::cout << name << ", intersection, set merge: " << t
+              << " ms (checksum " << res.size() << ")\n";
+
+    res.clear();
+    t = time_ms(
+        [&]
+        {
+            std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(),
+                           std::inserter(res, res.end()));
+        });
+    std::cout << name << ", union, set merge: " << t << " ms (checksum "
+              << res.size() << ")\n";
+}
+
+// Intersects and unites treaps of the lists built beforehand. The
+// intersection frees the nodes of the keys that are not common, which takes
+// linear time anyway.
+void bench_treap(const char *name, const std::vector<std::uint64_t> &a,
+                 const std::vector<std::uint64_t> &b)
+{
+    using set_type = opendsa::treap_set<std::uint64_t>;
+
+    set_type ta = set_type::from_sorted(a.begin(), a.end());
+    set_type tb = set_type::from_sorted(b.begin(), b.end());
+    double t    = time_ms([&] { ta.intersect(std::move(tb)); });
+    std::cout << name << ", intersection, treap_set: " << t
+              << " ms (checksum " << ta.size() << ")\n";
+
+    ta = set_type::from_sorted(a.begin(), a.end());
+    tb = set_type::from_sorted(b.begin(), b.end());
+    t  = time_ms([&] { ta.unite(std::move(tb)); });
+    std::cout << name << ", union, treap_set: " << t << " ms (checksum "
+              << ta.size() << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+    const std::size_t n = (argc > 1) ? std::stoul(argv[1]) : 4000000;
+
+    std::mt19937_64 rng(42);
+    const std::uint64_t range = 4 * n;
+
+    std::vector<std::uint64_t> large = posting_list(rng, n, range);
+    std::vector<std::uint64_t> other = posting_list(rng, n, range);
+    std::vector<std::uint64_t> small = posting_list(rng, n / 1000, range);
+
+    bench_merge("Similar sizes", large, other);
+    bench_merge("Small and large", small, large);
+    bench_treap("Similar sizes", large, other);
+    bench_treap("Small and large", small, large);
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file btree_map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Driver for btree_map and btree_set
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "btree_map.h"
+#include "btree_set.h"
+
+int main(int argc, const char **argv)
+{
+    opendsa::btree_map<int, std::string> m = {
+        {3, "three"}, {1, "one"}, {2, "two"}};
+
+    for (int i = 4; i <= 100; i++)
+        m.emplace_hint(m.end(), i, std::to_string(i));
+    m[0] = "zero";
+    m.erase(50);
+
+    std::cout << "==========Btree map==========\n\n";
+    std::cout << "Size: " << m.size() << "\n";
+    std::cout << "m.at(3): " << m.at(3) << "\n";
+    std::cout << "m.contains(50): " << (m.contains(50) ? "yes" : "no") << "\n";
+
+    std::cout << "Range [45, 55): { ";
+    for (auto it = m.lower_bound(45); it != m.lower_bound(55); ++it)
+        std::cout << it->first << ": " << it->second << " ";
+    std::cout << "}\n";
+
+    std::cout << "Last three (backward): { ";
+    auto it = m.end();
+    for (int i = 0; i < 3; i++)
+    {
+        --it;
+        std::cout << it->first << " ";
+    }
+    std::cout << "}\n\n";
+
+    opendsa::btree_set<std::string> s = {"pear", "apple", "orange", "apple"};
+    s.emplace("banana");
+    s.erase("orange");
+
+    std::cout << "Btree set: { ";
+    for (const std::string &x : s)
+        std::cout << x << " ";
+    std::cout << "}\n";
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file concurrent_skip_list.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::concurrent_skip_list works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "concurrent_skip_list.h"
+
+template <typename K, typename T>
+void test_get_skip_list_info(const opendsa::concurrent_skip_list<K, T> &l,
+                             const char *lname)
+{
+    std::cout << "==========" << lname << "==========\n\n";
+    std::cout << "Empty?: " << (l.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << l.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const auto &e : l)
+        std::cout << "(" << e.first << ", " << e.second << ") ";
+    std::cout << "}\n\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::concurrent_skip_list<int, int> l;
+
+    // Four threads insert the squares of interleaved keys at the same time
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back(
+            [&l, t]
+            {
+                for (int k = t; k < 20; k += 4)
+                    l.insert({k, k * k});
+            });
+    for (std::thread &th : threads)
+        th.join();
+    test_get_skip_list_info(l, "List 1");
+
+    // Then two threads remove the odd and the even multiples of 3
+    threads.clear();
+    for (int t = 0; t < 2; t++)
+        threads.emplace_back(
+            [&l, t]
+            {
+                for (int k = 3 * t; k < 20; k += 6)
+                    l.erase(k);
+            });
+    for (std::thread &th : threads)
+        th.join();
+
+    // No other thread uses the list anymore, so the removed nodes can be
+    // recycled
+    l.collect();
+    test_get_skip_list_info(l, "List 1 after erasing");
+
+    std::cout << "l.find(7)->second: " << l.find(7)->second << "\n";
+    std::cout << "l.contains(9): " << (l.contains(9) ? "yes" : "no") << "\n";
+    std::cout << "l.lower_bound(10)->first: " << l.lower_bound(10)->first
+              << "\n";
+
+    return 0;
+}
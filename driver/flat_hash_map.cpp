@@ -0,0 +1,75 @@
+/**
+ * @file flat_hash_map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Driver for flat_hash_map and flat_hash_set
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+#include "flat_hash_map.h"
+#include "flat_hash_set.h"
+
+int main(int argc, const char **argv)
+{
+    opendsa::flat_hash_map<int, std::string> m = {
+        {3, "three"}, {1, "one"}, {2, "two"}};
+
+    m.reserve(100);
+    const std::size_t buckets = m.bucket_count();
+    for (int i = 4; i <= 100; i++)
+        m.try_emplace(i, std::to_string(i));
+    m[0] = "zero";
+    m.erase(50);
+
+    std::cout << "==========Flat hash map==========\n\n";
+    std::cout << "Size: " << m.size() << "\n";
+    std::cout << "m.at(3): " << m.at(3) << "\n";
+    std::cout << "m.contains(50): " << (m.contains(50) ? "yes" : "no") << "\n";
+    std::cout << "Buckets: " << m.bucket_count() << " (reserved "
+              << buckets << "), load factor " << m.load_factor() << "\n";
+
+    int sum = 0;
+    for (const auto &[k, v] : m)
+        sum += k;
+    std::cout << "Sum of the keys: " << sum << "\n\n";
+
+    opendsa::flat_hash_set<std::string> s = {"pear", "apple", "orange",
+                                             "apple"};
+    s.emplace("banana");
+    s.erase("orange");
+
+    std::cout << "Flat hash set (in no particular order): { ";
+    for (const std::string &x : s)
+        std::cout << x << " ";
+    std::cout << "}\n\n";
+
+    // Maps on two arenas: assignments copy or move the elements into the
+    // arena of the target, since a polymorphic allocator never propagates
+    using pmr_map =
+        opendsa::flat_hash_map<int, int, std::hash<int>, std::equal_to<int>,
+                               std::pmr::polymorphic_allocator<
+                                   std::pair<const int, int>>>;
+
+    std::pmr::monotonic_buffer_resource arena_a, arena_b;
+    pmr_map a(&arena_a), b(&arena_b);
+    for (int i = 0; i < 1000; i++)
+        a[i] = i * i;
+
+    b = a;
+    std::cout << "Copied into arena b: " << b.size() << " elements, b[30] = "
+              << b.at(30) << ", same arena: "
+              << (b.get_allocator() == a.get_allocator() ? "yes" : "no")
+              << "\n";
+
+    pmr_map c(&arena_b);
+    c = std::move(a);
+    std::cout << "Moved into arena b: " << c.size() << " elements, c[30] = "
+              << c.at(30) << "\n";
+
+    return 0;
+}
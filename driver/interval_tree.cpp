@@ -0,0 +1,61 @@
+/**
+ * @file interval_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::interval_tree works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "interval_tree.h"
+
+template <typename T, typename M>
+void test_get_interval_tree_info(const opendsa::interval_tree<T, M> &t,
+                                 const char *tname)
+{
+    std::cout << "==========" << tname << "==========\n\n";
+    std::cout << "Empty?: " << (t.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << t.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const auto &e : t)
+        std::cout << "([" << e.first.low << ", " << e.first.high << "), "
+                  << e.second << ") ";
+    std::cout << "}\n\n";
+}
+
+template <typename T, typename M>
+void print_overlapping(const opendsa::interval_tree<T, M> &t, T low, T high)
+{
+    std::cout << "Overlapping [" << low << ", " << high << "): { ";
+    auto range = t.overlapping(low, high);
+    for (auto it = range.first; it != range.second; ++it)
+        std::cout << it->second << " ";
+    std::cout << "}\n";
+}
+
+int main(int argc, const char **argv)
+{
+    // Meetings of a day, in minutes since midnight
+    opendsa::interval_tree<int, std::string> t = {
+        {{540, 600}, "standup"}, {{600, 720}, "review"},
+        {{570, 630}, "call"},    {{780, 840}, "lunch talk"},
+        {{900, 960}, "1:1"},     {{540, 1020}, "on call"}};
+    test_get_interval_tree_info(t, "Tree 1");
+
+    print_overlapping(t, 590, 610);
+    print_overlapping(t, 720, 780);
+    print_overlapping(t, 1020, 1080);
+    std::cout << "t.overlaps(840, 900): "
+              << (t.overlaps(840, 900) ? "yes" : "no") << "\n\n";
+
+    t.erase({540, 1020});
+    t.emplace(opendsa::interval<int>{600, 720}, "review (again)");
+    test_get_interval_tree_info(t, "Tree 1 after erasing");
+    print_overlapping(t, 840, 1000);
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::map and opendsa::set work
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "map.h"
+#include "set.h"
+
+template <typename K, typename T, typename C, typename A, typename B>
+void test_get_map_info(const opendsa::map<K, T, C, A, B> &m,
+                       const char *mname)
+{
+    std::cout << "==========" << mname << "==========\n\n";
+    std::cout << "Empty?: " << (m.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << m.size() << "\n";
+
+    std::cout << "Elements (forward): { ";
+    for (const auto &[k, v] : m)
+        std::cout << k << ": " << v << " ";
+    std::cout << "}\n";
+
+    std::cout << "Elements (backward): { ";
+    for (auto it = m.crbegin(); it != m.crend(); ++it)
+        std::cout << it->first << ": " << it->second << " ";
+    std::cout << "}\n\n";
+}
+
+// A stateful allocator that keeps its tag when a container is assigned, as
+// it does not propagate
+template <typename T>
+struct tagged_allocator
+{
+    using value_type = T;
+
+    int tag;
+
+    explicit tagged_allocator(int tag) : tag(tag) { }
+
+    template <typename U>
+    tagged_allocator(const tagged_allocator<U> &other) : tag(other.tag)
+    {
+    }
+
+    T *allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    friend bool operator==(const tagged_allocator &lhs,
+                           const tagged_allocator &rhs)
+    {
+        return lhs.tag == rhs.tag;
+    }
+};
+
+int main(int argc, const char **argv)
+{
+    opendsa::map<int, std::string> m = {{3, "three"}, {1, "one"}, {2, "two"}};
+    m.insert({5, "five"});
+    m.emplace(4, "four");
+    m.emplace_hint(m.end(), 6, "six");
+    m.insert(m.end(), {7, "seven"});
+    m[0] = "zero";
+    m.try_emplace(3, "not three");
+    test_get_map_info(m, "Map 1");
+
+    opendsa::map<int, std::string> m1(m);
+    m1.erase(m1.find(0));
+    m1.erase(5);
+    m1.erase(m1.lower_bound(6), m1.end());
+    test_get_map_info(m1, "Map 2");
+
+    std::cout << "m.at(4): " << m.at(4) << "\n";
+    std::cout << "m.contains(8): " << (m.contains(8) ? "yes" : "no") << "\n";
+    std::cout << "m.upper_bound(4): " << m.upper_bound(4)->first << "\n\n";
+
+    std::pair<int, std::string> sorted[] = {
+        {10, "ten"}, {20, "twenty"}, {30, "thirty"}, {40, "forty"}};
+    opendsa::map<int, std::string> m2 =
+        opendsa::map<int, std::string>::from_sorted(sorted, sorted + 2);
+    m2.insert_sorted(sorted + 2, sorted + 4);
+    test_get_map_info(m2, "Map 3");
+
+    opendsa::avl_map<int, std::string> m3;
+    for (int i = 0; i < 8; i++)
+        m3.emplace(i, std::to_string(i));
+    m3.erase(3);
+    test_get_map_info(m3, "Map 4");
+
+    opendsa::order_statistic_map<int, std::string> m4(m.begin(), m.end());
+    std::cout << "m4.select(2): " << m4.select(2)->first << "\n";
+    std::cout << "m4.rank(5): " << m4.rank(5) << "\n";
+    std::cout << "m4.count_range(2, 6): " << m4.count_range(2, 6) << "\n\n";
+
+    opendsa::set<std::string> s = {"pear", "apple", "orange", "apple"};
+    s.emplace("banana");
+    s.erase("orange");
+
+    std::cout << "Set: { ";
+    for (const std::string &x : s)
+        std::cout << x << " ";
+    std::cout << "}\n\n";
+
+    // Assignments between maps of unequal allocators copy or move the
+    // elements into nodes from the allocator of the target
+    using tagged_map =
+        opendsa::map<int, std::string, std::less<int>,
+                     tagged_allocator<std::pair<const int, std::string>>>;
+    using tagged = tagged_allocator<std::pair<const int, std::string>>;
+
+    tagged_map t1(std::less<int>(), tagged(1)), t2(std::less<int>(), tagged(2));
+    for (int i = 0; i < 5; i++)
+        t1.emplace(i, std::to_string(i));
+
+    t2 = t1;
+    std::cout << "Copied into map of allocator " << t2.get_allocator().tag
+              << ": " << t2.size() << " elements\n";
+
+    tagged_map t3(std::less<int>(), tagged(3));
+    t3 = std::move(t1);
+    std::cout << "Moved into map of allocator " << t3.get_allocator().tag
+              << ": " << t3.size() << " elements, t3.at(4) = " << t3.at(4)
+              << "\n";
+
+    return 0;
+}
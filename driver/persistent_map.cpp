@@ -0,0 +1,49 @@
+/**
+ * @file persistent_map.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::persistent_map works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "persistent_map.h"
+
+template <typename K, typename T>
+void test_get_persistent_map_info(const opendsa::persistent_map<K, T> &m,
+                                  const char *mname)
+{
+    std::cout << "==========" << mname << "==========\n\n";
+    std::cout << "Empty?: " << (m.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << m.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const auto &e : m)
+        std::cout << "(" << e.first << ", " << e.second << ") ";
+    std::cout << "}\n\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::persistent_map<std::string, int> stock = {
+        {"apple", 10}, {"banana", 4}, {"cherry", 25}};
+    test_get_persistent_map_info(stock, "Map 1");
+
+    // The snapshot shares every node with the map
+    opendsa::persistent_map<std::string, int> before = stock.snapshot();
+
+    stock.insert_or_assign("banana", 0);
+    stock.erase("cherry");
+    stock.insert({"durian", 1});
+    test_get_persistent_map_info(stock, "Map 1 after updates");
+    test_get_persistent_map_info(before, "Snapshot of Map 1");
+
+    std::cout << "before.at(\"cherry\"): " << before.at("cherry") << "\n";
+    std::cout << "stock.contains(\"cherry\"): "
+              << (stock.contains("cherry") ? "yes" : "no") << "\n";
+
+    return 0;
+}
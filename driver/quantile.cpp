@@ -0,0 +1,56 @@
+/**
+ * @file quantile.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::kll_sketch works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+
+#include "quantile.h"
+
+template <typename T>
+void test_get_kll_sketch_info(const opendsa::kll_sketch<T> &s,
+                              const char *sname)
+{
+    std::cout << "==========" << sname << "==========\n\n";
+    std::cout << "Empty?: " << (s.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Stream size: " << s.size() << "\n";
+    std::cout << "Retained values: " << s.retained() << "\n";
+
+    if (!s.empty())
+    {
+        opendsa::vector<T> q = s.quantiles({0.5, 0.9, 0.99});
+        std::cout << "Min: " << s.min() << ", p50: " << q[0]
+                  << ", p90: " << q[1] << ", p99: " << q[2]
+                  << ", max: " << s.max() << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, const char **argv)
+{
+    // Latencies in microseconds seen by two workers
+    opendsa::kll_sketch<int> worker1;
+    for (int i = 1; i <= 100000; i++)
+        worker1.insert(100 + i % 900);
+    test_get_kll_sketch_info(worker1, "Worker 1");
+
+    opendsa::kll_sketch<int> worker2;
+    opendsa::vector<int> batch;
+    for (int i = 1; i <= 1000; i++)
+        batch.push_back(i % 10 == 0 ? 5000 : 300);
+    for (int round = 0; round < 100; round++)
+        worker2.insert(batch);
+    test_get_kll_sketch_info(worker2, "Worker 2");
+
+    worker1.merge(worker2);
+    test_get_kll_sketch_info(worker1, "Both workers");
+
+    std::cout << "Estimated number of latencies under 500: "
+              << worker1.rank(500) << "\n";
+
+    return 0;
+}
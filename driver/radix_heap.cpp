@@ -0,0 +1,67 @@
+/**
+ * @file radix_heap.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::radix_heap works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "radix_heap.h"
+
+template <typename K, typename T>
+void test_get_radix_heap_info(const opendsa::radix_heap<K, T> &h,
+                              const char *hname)
+{
+    std::cout << "==========" << hname << "==========\n\n";
+    std::cout << "Empty?: " << (h.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << h.size() << "\n";
+    if (!h.empty())
+        std::cout << "Top: " << h.top().first << " -> " << h.top().second
+                  << "\n";
+    std::cout << "\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::radix_heap<unsigned, std::string> h;
+    h.push(7, "seven");
+    h.push(3, "three");
+    h.emplace(12, "twelve");
+    h.push({3, "three again"});
+    test_get_radix_heap_info(h, "Heap 1");
+
+    // Keys may be pushed while popping as long as they don't go below top()
+    std::cout << "Pop order: ";
+    while (!h.empty())
+    {
+        const unsigned key = h.top().first;
+        std::cout << key << " (" << h.top().second << ") ";
+        h.pop();
+
+        if (key == 7)
+            h.push(9, "nine");
+    }
+    std::cout << "\n\n";
+
+    // Signed keys keep their order
+    opendsa::radix_heap<int, int> h1;
+    for (int i : {5, -3, 0, -100, 42, -3})
+        h1.push(i, i * 2);
+    opendsa::radix_heap<int, int> h2(std::move(h1));
+    test_get_radix_heap_info(h1, "Heap 2 (moved from)");
+    test_get_radix_heap_info(h2, "Heap 3");
+
+    std::cout << "Pop order: ";
+    while (!h2.empty())
+    {
+        std::cout << h2.top().first << " ";
+        h2.pop();
+    }
+    std::cout << "\n";
+
+    return 0;
+}
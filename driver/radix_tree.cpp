@@ -0,0 +1,67 @@
+/**
+ * @file radix_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::radix_tree works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "radix_tree.h"
+
+template <typename T>
+void test_get_radix_tree_info(const opendsa::radix_tree<T> &t,
+                              const char *tname)
+{
+    std::cout << "==========" << tname << "==========\n\n";
+    std::cout << "Empty?: " << (t.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << t.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const auto &e : t)
+        std::cout << "(" << e.first << ", " << e.second << ") ";
+    std::cout << "}\n\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::radix_tree<int> t = {
+        {"romane", 1}, {"romanus", 2}, {"romulus", 3}, {"rubens", 4},
+        {"ruber", 5},  {"rubicon", 6}, {"rubicundus", 7}};
+    test_get_radix_tree_info(t, "Tree 1");
+
+    std::cout << "t.contains(\"rom\"): " << (t.contains("rom") ? "yes" : "no")
+              << "\n";
+    std::cout << "t.find(\"ruber\")->second: " << t.find("ruber")->second
+              << "\n";
+
+    std::cout << "Keys starting with \"rub\": { ";
+    auto range = t.prefix_range("rub");
+    for (auto it = range.first; it != range.second; ++it)
+        std::cout << it->first << " ";
+    std::cout << "}\n\n";
+
+    // Routing: the longest registered prefix of a path wins
+    opendsa::radix_tree<std::string> routes;
+    routes["/"]           = "index";
+    routes["/api/"]       = "api";
+    routes["/api/users/"] = "users";
+    routes["/static/"]    = "files";
+
+    const char *paths[] = {"/api/users/42", "/api/orders/7", "/static/a.css",
+                           "/about"};
+    for (const char *path : paths)
+        std::cout << path << " -> "
+                  << routes.longest_prefix_match(path)->second << "\n";
+    std::cout << "\n";
+
+    t.erase("romanus");
+    t.erase("rubicon");
+    t.insert_or_assign("ruber", 50);
+    test_get_radix_tree_info(t, "Tree 1 after erasing");
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file static_search_tree.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::static_search_tree works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "static_search_tree.h"
+#include "vector.h"
+
+template <typename K>
+void test_get_static_search_tree_info(const opendsa::static_search_tree<K> &t,
+                                      const char *tname)
+{
+    std::cout << "==========" << tname << "==========\n\n";
+    std::cout << "Empty?: " << (t.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << t.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const K &k : t)
+        std::cout << k << " ";
+    std::cout << "}\n\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::vector<int> sorted = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29};
+    opendsa::static_search_tree<int> t(sorted);
+    test_get_static_search_tree_info(t, "Tree 1");
+
+    std::cout << "t.lower_bound(8): " << *t.lower_bound(8) << "\n";
+    std::cout << "t.upper_bound(13): " << *t.upper_bound(13) << "\n";
+    std::cout << "t.contains(9): " << (t.contains(9) ? "yes" : "no") << "\n";
+    std::cout << "t.lower_bound(30) == t.end(): "
+              << (t.lower_bound(30) == t.end() ? "yes" : "no") << "\n\n";
+
+    // Rebuilding replaces the whole tree
+    opendsa::vector<int> next = {1, 4, 9, 16, 25};
+    t = opendsa::static_search_tree<int>(next);
+    test_get_static_search_tree_info(t, "Tree 2");
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file timer_wheel.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::timer_wheel works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+#include <string>
+
+#include "timer_wheel.h"
+
+int main(int argc, const char **argv)
+{
+    opendsa::timer_wheel<std::string> wheel;
+
+    wheel.schedule(5, "connection 1 idle");
+    opendsa::timer_handle h = wheel.schedule(10, "connection 2 idle");
+    wheel.schedule(300, "connection 3 idle");   // level 1
+    wheel.schedule(70000, "connection 4 idle"); // level 2
+
+    std::cout << "Pending timers: " << wheel.size() << "\n";
+    std::cout << "Cancel connection 2: " << (wheel.cancel(h) ? "yes" : "no")
+              << "\n";
+    std::cout << "Cancel connection 2 again: "
+              << (wheel.cancel(h) ? "yes" : "no") << "\n";
+
+    for (opendsa::timer_wheel<std::string>::tick_type now : {4, 5, 299, 300})
+    {
+        std::cout << "Advance to " << now << ": ";
+        wheel.advance(now, [](std::string &&s) { std::cout << s << "; "; });
+        std::cout << "\n";
+    }
+
+    // Expired timers can also be collected in batch
+    opendsa::vector<std::string> expired;
+    wheel.schedule(70001, "connection 5 idle");
+    wheel.advance(80000, expired);
+
+    std::cout << "Batch at " << wheel.now() << ": ";
+    for (const std::string &s : expired)
+        std::cout << s << "; ";
+    std::cout << "\n";
+    std::cout << "Pending timers: " << wheel.size() << "\n";
+
+    return 0;
+}
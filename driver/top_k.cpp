@@ -0,0 +1,62 @@
+/**
+ * @file top_k.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::top_k works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <functional>
+#include <iostream>
+#include <utility>
+
+#include "top_k.h"
+
+template <typename T, typename Compare>
+void test_get_top_k_info(const opendsa::top_k_accumulator<T, Compare> &acc,
+                         const char *aname)
+{
+    std::cout << "==========" << aname << "==========\n\n";
+    std::cout << "Empty?: " << (acc.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Kept: " << acc.size() << " of " << acc.k() << "\n";
+
+    if (!acc.empty())
+    {
+        std::cout << "Threshold: " << acc.threshold() << "\n";
+        opendsa::vector<T> res = acc.sorted();
+        std::cout << "Elements:";
+        for (std::size_t i = 0; i < res.size(); i++)
+            std::cout << " " << res[i];
+        std::cout << "\n";
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, const char **argv)
+{
+    // Scores of the candidates seen by two shards
+    opendsa::top_k_accumulator<int> shard1(5);
+    for (int i = 0; i < 1000; i++)
+        shard1.push((i * 7919) % 1009);
+    test_get_top_k_info(shard1, "Shard 1");
+
+    opendsa::top_k_accumulator<int> shard2(5);
+    opendsa::vector<int> scores = {1500, 3, 1200, 42, 999};
+    shard2.push(scores.begin(), scores.end());
+    test_get_top_k_info(shard2, "Shard 2");
+
+    shard1.merge(shard2);
+    test_get_top_k_info(shard1, "Both shards");
+
+    // The 3 smallest latencies
+    opendsa::vector<int> latencies = {120, 95, 300, 87, 150, 99};
+    opendsa::vector<int> fastest =
+        opendsa::top_k(latencies, 3, std::less<>());
+    std::cout << "Fastest:";
+    for (std::size_t i = 0; i < fastest.size(); i++)
+        std::cout << " " << fastest[i];
+    std::cout << "\n";
+
+    return 0;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file treap.cpp
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A brief driver to demonstrate how opendsa::treap_set works
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+#include <iostream>
+
+#include "treap.h"
+
+template <typename T>
+void test_get_treap_set_info(const opendsa::treap_set<T> &s, const char *sname)
+{
+    std::cout << "==========" << sname << "==========\n\n";
+    std::cout << "Empty?: " << (s.empty() ? "Yes" : "No") << "\n";
+    std::cout << "Size: " << s.size() << "\n";
+
+    std::cout << "Elements: { ";
+    for (const auto &e : s)
+        std::cout << e << " ";
+    std::cout << "}\n\n";
+}
+
+int main(int argc, const char **argv)
+{
+    opendsa::treap_set<int> even = {0, 2, 4, 6, 8, 10, 12};
+    opendsa::treap_set<int> odd  = {1, 3, 5, 7, 9, 11};
+    test_get_treap_set_info(even, "Set 1");
+    test_get_treap_set_info(odd, "Set 2");
+
+    // Set 2 is moved into Set 1
+    even.unite(std::move(odd));
+    test_get_treap_set_info(even, "Set 1 after unite(Set 2)");
+
+    opendsa::treap_set<int> squares = {0, 1, 4, 9, 16};
+    even.intersect(squares);
+    test_get_treap_set_info(even, "Set 1 after intersect(squares)");
+
+    opendsa::treap_set<int> high = squares.split(4);
+    test_get_treap_set_info(squares, "Squares less than 4");
+    test_get_treap_set_info(high, "Squares from 4");
+
+    squares.join(std::move(high));
+    squares.subtract(opendsa::treap_set<int>{1, 16});
+    test_get_treap_set_info(squares, "Squares after join and subtract");
+
+    return 0;
+}
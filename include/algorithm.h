@@ -11,8 +11,16 @@
 #ifndef __OPENDSA_ALGO_H
 #define __OPENDSA_ALGO_H 1
 
+#include <algorithm>
+#include <cmath>
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
 
 namespace opendsa
 {
@@ -54,51 +62,272 @@ namespace opendsa
     };
 
     /**
-     * @brief Median of two sorted array
+     * @brief Returns the k-th smallest element, counting from 0, of the union
+     * of two sorted arrays in O(log(min(m, n))).
+     *
+     * @param __nums1 First sorted sequential container, e.g. a std::span
+     * @param __nums2 Second sorted sequential container
+     * @param __k     Rank of the element, less than the total size
+     * @param __comp  Comparison object the containers are sorted by
+     *
+     * Taking the first i elements of the shorter array and the first k + 1 - i
+     * of the other one gives the k + 1 smallest elements iff no element taken
+     * is greater than an element left, so i is found by a binary search over
+     * the shorter array. Nothing is merged or copied. Equivalent elements are
+     * counted with their multiplicity.
+     */
+    template <typename Container1, typename Container2,
+              typename Compare = std::less<>>
+    requires RequireSequenceContainer<Container1> &&
+             RequireSequenceContainer<Container2> &&
+             std::same_as<typename Container1::value_type,
+                          typename Container2::value_type>
+    const typename Container1::value_type &
+    kth_of_two_sorted(const Container1 &__nums1, const Container2 &__nums2,
+                      std::size_t __k, Compare __comp = Compare())
+    {
+        M_Assert(__k < __nums1.size() + __nums2.size(),
+                 "The rank is out of range");
+
+        if (__nums2.size() < __nums1.size())
+            return kth_of_two_sorted(__nums2, __nums1, __k, __comp);
+
+        // Number of elements taken from the shorter array __nums1
+        const std::size_t __m = __nums1.size(), __n = __nums2.size();
+        std::size_t __lo = __k + 1 > __n ? __k + 1 - __n : 0;
+        std::size_t __hi = std::min(__k + 1, __m);
+
+        // Smallest count whose first element left in __nums1 is not less
+        // than the last element taken from __nums2
+        while (__lo < __hi)
+        {
+            const std::size_t __i = __lo + (__hi - __lo) / 2;
+            if (__comp(__nums1[__i], __nums2[__k - __i]))
+                __lo = __i + 1;
+            else
+                __hi = __i;
+        }
+
+        const std::size_t __i = __lo, __j = __k + 1 - __lo;
+        if (__i == 0)
+            return __nums2[__j - 1];
+        if (__j == 0)
+            return __nums1[__i - 1];
+        return __comp(__nums1[__i - 1], __nums2[__j - 1]) ? __nums2[__j - 1]
+                                                           : __nums1[__i - 1];
+    }
+
+    /**
+     * @brief Median of two sorted arrays in O(log(min(m, n)))
      *
-     * @param nums1 First sequential container of numbers
-     * @param nums2 Second sequential container of numbers
+     * @param __nums1 First sequential container of numbers
+     * @param __nums2 Second sequential container of numbers
      *
      * This function will compute the the median of two given sorted arrays of
-     * numeric values. If either of the arrays is not sorted, the output will be
-     * incorrect.
+     * numeric values, which must not both be empty. If either of the arrays is
+     * not sorted, the output will be incorrect. The arrays are taken by
+     * reference and searched with kth_of_two_sorted(), so a median of large
+     * arrays costs a few dozen comparisons.
      */
-    template <typename Container>
-    requires RequireSequenceContainer<Container>
-    double median(Container __nums1, Container __nums2)
+    template <typename Container1, typename Container2>
+    requires RequireSequenceContainer<Container1> &&
+             RequireSequenceContainer<Container2>
+    double median(const Container1 &__nums1, const Container2 &__nums2)
+    {
+        const std::size_t __total_size = __nums1.size() + __nums2.size();
+        M_Assert(__total_size > 0, "The median of no numbers is undefined");
+
+        const double __upper =
+            static_cast<double>(kth_of_two_sorted(__nums1, __nums2,
+                                                  __total_size / 2));
+        if (__total_size % 2 == 1)
+            return __upper;
+
+        const double __lower =
+            static_cast<double>(kth_of_two_sorted(__nums1, __nums2,
+                                                  __total_size / 2 - 1));
+        return (__lower + __upper) / 2;
+    }
+
+    /**
+     * Returns the first position in [@a __lo, @a __hi) of @a __run whose
+     * element does not satisfy @a __pred, the run being partitioned by it.
+     * The run is searched by index, as some containers have no const
+     * iterators.
+     */
+    template <typename Run, typename Pred>
+    std::size_t
+    __partition_point_of_run(const Run &__run, std::size_t __lo,
+                             std::size_t __hi, Pred __pred)
     {
-        std::size_t __total_size = __nums1.size() + __nums2.size();
-        std::size_t __i1 = 0, __i2 = 0;
-        std::size_t __prev = 0, __curr = 0, __result = 0;
-
-        // This constraint will make sure that the runtime compplexity will be
-        // O(log(m + n)), where m and n are the size of the container nums1 and
-        // nums2 respectively.
-        while (__result++ <= (__total_size / 2))
+        while (__lo < __hi)
         {
-            // In case the size of merged container is even.
-            __prev = __curr;
+            const std::size_t __mid = __lo + (__hi - __lo) / 2;
+            if (__pred(__run[__mid]))
+                __lo = __mid + 1;
+            else
+                __hi = __mid;
+        }
+        return __lo;
+    }
 
-            if (__i1 >= __nums1.size())
+    /**
+     * Selects the element of rank @a __k among the runs, knowing that the
+     * elements before @a __lo in each run rank below it. On return,
+     * @a __lo holds the position of the first element that is not less than
+     * the result in each run, which is a valid start for greater ranks.
+     */
+    template <typename Runs, typename Compare>
+    const typename Runs::value_type::value_type &
+    __kth_of_sorted_runs(const Runs &__runs, std::size_t __k,
+                         vector<std::size_t> &__lo, Compare &__comp)
+    {
+        using __value_type = typename Runs::value_type::value_type;
+
+        const std::size_t __n = __runs.size();
+        vector<std::size_t> __hi(__n);
+        std::size_t __total = 0;
+        for (std::size_t __r = 0; __r < __n; __r++)
+        {
+            __hi[__r] = __runs[__r].size();
+            __total += __hi[__r];
+        }
+        M_Assert(__k < __total, "The rank is out of range");
+
+        // The middle elements of the windows, with their weights
+        vector<std::pair<const __value_type *, std::size_t>> __mids;
+        __mids.reserve(__n);
+        vector<std::size_t> __less(__n), __not_greater(__n);
+
+        for (;;)
+        {
+            __mids.clear();
+            std::size_t __active = 0;
+            for (std::size_t __r = 0; __r < __n; __r++)
             {
-                __curr = __nums2[__i2++];
-                continue;
+                if (__lo[__r] == __hi[__r])
+                    continue;
+                const std::size_t __size = __hi[__r] - __lo[__r];
+                __mids.push_back(
+                    {&__runs[__r][__lo[__r] + __size / 2], __size});
+                __active += __size;
             }
+            M_Assert(__active > 0, "The runs are not sorted");
+
+            std::sort(__mids.begin(), __mids.end(),
+                      [&__comp](const auto &__a, const auto &__b)
+                      { return __comp(*__a.first, *__b.first); });
+            std::size_t __m = 0, __seen = __mids[0].second;
+            while (2 * __seen < __active)
+                __seen += __mids[++__m].second;
+            const __value_type &__pivot = *__mids[__m].first;
 
-            if (__i2 >= __nums2.size())
+            // Rank of the pivot. The elements before the windows are less
+            // than the pivot and those after them are greater.
+            std::size_t __rank_lo = 0, __rank_hi = 0;
+            for (std::size_t __r = 0; __r < __n; __r++)
             {
-                __curr = __nums1[__i1++];
-                continue;
+                __less[__r] = __partition_point_of_run(
+                    __runs[__r], __lo[__r], __hi[__r],
+                    [&](const __value_type &__x)
+                    { return __comp(__x, __pivot); });
+                __not_greater[__r] = __partition_point_of_run(
+                    __runs[__r], __less[__r], __hi[__r],
+                    [&](const __value_type &__x)
+                    { return !__comp(__pivot, __x); });
+                __rank_lo += __less[__r];
+                __rank_hi += __not_greater[__r];
             }
 
-            if (__nums1[__i1] < __nums2[__i2])
-                __curr = __nums1[__i1++];
+            if (__k < __rank_lo)
+                __hi.swap(__less);
+            else if (__k >= __rank_hi)
+                __lo.swap(__not_greater);
             else
-                __curr = __nums2[__i2++];
+            {
+                __lo.swap(__less);
+                return __pivot;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the k-th smallest element, counting from 0, of the union
+     * of several sorted runs, without merging them.
+     *
+     * @param __runs Sequential container of sorted sequential containers,
+     *               e.g. a vector of std::span
+     * @param __k    Rank of the element, less than the total size
+     * @param __comp Comparison object the runs are sorted by
+     *
+     * The search keeps a window of candidates in each run. Each round takes
+     * the middle element of every window, picks their median weighted by the
+     * sizes of the windows as a pivot, and ranks it with a binary search in
+     * each run. At least a quarter of the candidates lie on each side of the
+     * pivot, so the windows shrink to the element after O(log n) rounds, i.e.
+     * O(N log^2 n) comparisons for N runs of n elements in total.
+     */
+    template <typename Runs, typename Compare = std::less<>>
+    requires RequireSequenceContainer<Runs> &&
+             RequireSequenceContainer<typename Runs::value_type>
+    const typename Runs::value_type::value_type &
+    kth_of_sorted_runs(const Runs &__runs, std::size_t __k,
+                       Compare __comp = Compare())
+    {
+        vector<std::size_t> __lo(__runs.size(), 0);
+        return __kth_of_sorted_runs(__runs, __k, __lo, __comp);
+    }
+
+    /**
+     * @brief Returns several quantiles of the union of sorted runs.
+     *
+     * @param __runs      Sequential container of sorted sequential containers
+     * @param __fractions Fractions in [0, 1], e.g. 0.5, 0.99 and 0.999
+     * @param __comp      Comparison object the runs are sorted by
+     *
+     * The quantile of fraction q is the element of rank ceil(q * n) - 1 among
+     * the n elements, clamped to the range of ranks, as for a percentile of
+     * nearest rank. The quantiles are returned in the order of
+     * @a __fractions. They are searched in increasing order, each starting
+     * where the previous one was found. The runs must not all be empty.
+     */
+    template <typename Runs, typename Compare = std::less<>>
+    requires RequireSequenceContainer<Runs> &&
+             RequireSequenceContainer<typename Runs::value_type>
+    vector<typename Runs::value_type::value_type>
+    quantiles_of_sorted_runs(const Runs &__runs,
+                             const vector<double> &__fractions,
+                             Compare __comp = Compare())
+    {
+        using __value_type = typename Runs::value_type::value_type;
+
+        std::size_t __total = 0;
+        for (std::size_t __r = 0; __r < __runs.size(); __r++)
+            __total += __runs[__r].size();
+        M_Assert(__total > 0, "The quantiles of no elements are undefined");
+
+        // Ranks in increasing order, along with their position in the result
+        vector<std::pair<std::size_t, std::size_t>> __ranks;
+        __ranks.reserve(__fractions.size());
+        for (std::size_t __i = 0; __i < __fractions.size(); __i++)
+        {
+            const double __q = std::clamp(__fractions[__i], 0.0, 1.0);
+            const double __r = std::ceil(__q * static_cast<double>(__total));
+            const std::size_t __rank =
+                __r < 1 ? 0
+                        : std::min(static_cast<std::size_t>(__r) - 1,
+                                   __total - 1);
+            __ranks.push_back({__rank, __i});
         }
+        std::sort(__ranks.begin(), __ranks.end());
+
+        vector<__value_type> __res(__fractions.size());
+        vector<std::size_t> __lo(__runs.size(), 0);
+        for (std::size_t __i = 0; __i < __ranks.size(); __i++)
+            __res[__ranks[__i].second] =
+                __kth_of_sorted_runs(__runs, __ranks[__i].first, __lo, __comp);
 
-        return (__total_size % 2 == 1) ? (double)__curr
-                                       : ((double)(__prev + __curr) / 2);
+        return __res;
     }
 }; // namespace opendsa
 
@@ -0,0 +1,1529 @@
+/**
+ * @file btree.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A B+ tree whose nodes are sized to a few cache lines
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_BTREE_H
+#define __OPENDSA_BTREE_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace opendsa
+{
+
+/**
+ * @brief The part shared by the leaves and the inner nodes of a B+ tree.
+ *
+ * For a leaf, _count is the number of values. For an inner node, it is the
+ * number of separator keys, so the node has _count + 1 children.
+ */
+struct _Btree_node_base
+{
+    _Btree_node_base *_parent = nullptr;
+    unsigned short _count     = 0;
+    bool _leaf                = true;
+};
+
+/**
+ * @brief Returns how many values fit in a leaf of about @a node_size bytes.
+ */
+constexpr std::size_t
+_Btree_leaf_slots(std::size_t node_size, std::size_t value_size)
+{
+    const std::size_t header = sizeof(_Btree_node_base) + 2 * sizeof(void *);
+    return std::max<std::size_t>(
+        4, node_size > header ? (node_size - header) / value_size : 0);
+}
+
+/**
+ * @brief Returns how many keys fit in an inner node of about @a node_size
+ * bytes, given that each key comes with a child pointer.
+ */
+constexpr std::size_t
+_Btree_inner_slots(std::size_t node_size, std::size_t key_size)
+{
+    const std::size_t header = sizeof(_Btree_node_base) + sizeof(void *);
+    return std::max<std::size_t>(4, node_size > header
+                                        ? (node_size - header) /
+                                              (key_size + sizeof(void *))
+                                        : 0);
+}
+
+/**
+ * @brief A leaf of a B+ tree.
+ *
+ * The leaves hold every value of the tree in order and are linked together,
+ * so an in-order scan walks contiguous arrays and only follows one pointer
+ * per leaf. The values live in raw storage that is constructed and destroyed
+ * by the tree.
+ */
+template <typename _Val, std::size_t _Slots>
+struct _Btree_leaf : public _Btree_node_base
+{
+    using value_type = _Val;
+
+    _Btree_leaf *_prev = nullptr;
+    _Btree_leaf *_next = nullptr;
+    alignas(_Val) unsigned char _storage[_Slots * sizeof(_Val)];
+
+    _Val *
+    _slot(std::size_t i) noexcept
+    {
+        return std::launder(reinterpret_cast<_Val *>(_storage) + i);
+    }
+
+    const _Val *
+    _slot(std::size_t i) const noexcept
+    {
+        return std::launder(reinterpret_cast<const _Val *>(_storage) + i);
+    }
+};
+
+/**
+ * @brief An inner node of a B+ tree.
+ *
+ * Child i holds the keys k such that key(i - 1) <= k < key(i). The separator
+ * keys are copies of keys that are, or once were, in the leaves.
+ */
+template <typename _Key, std::size_t _Slots>
+struct _Btree_inner : public _Btree_node_base
+{
+    _Btree_node_base *_children[_Slots + 1];
+    alignas(_Key) unsigned char _storage[_Slots * sizeof(_Key)];
+
+    _Btree_inner() { _leaf = false; }
+
+    _Key *
+    _key(std::size_t i) noexcept
+    {
+        return std::launder(reinterpret_cast<_Key *>(_storage) + i);
+    }
+
+    const _Key *
+    _key(std::size_t i) const noexcept
+    {
+        return std::launder(reinterpret_cast<const _Key *>(_storage) + i);
+    }
+};
+
+/**
+ * @brief A bidirectional iterator over the leaves of a B+ tree.
+ *
+ * The past-the-end iterator points after the last value of the last leaf,
+ * so it can be decremented. Inserting into or erasing from the tree moves
+ * values between nodes, which invalidates every iterator.
+ */
+template <typename _Leaf>
+struct _Btree_iterator
+{
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename _Leaf::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type *;
+    using reference         = value_type &;
+
+    _Leaf *_node     = nullptr;
+    std::size_t _pos = 0;
+
+    _Btree_iterator() noexcept = default;
+
+    _Btree_iterator(_Leaf *node, std::size_t pos) noexcept
+    : _node(node), _pos(pos)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_slot(_pos);
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _node->_slot(_pos);
+    }
+
+    _Btree_iterator &
+    operator++() noexcept
+    {
+        if (++_pos == _node->_count && _node->_next != nullptr)
+        {
+            _node = _node->_next;
+            _pos  = 0;
+        }
+
+        return *this;
+    }
+
+    _Btree_iterator
+    operator++(int) noexcept
+    {
+        _Btree_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    _Btree_iterator &
+    operator--() noexcept
+    {
+        if (_pos == 0)
+        {
+            _node = _node->_prev;
+            _pos  = _node->_count;
+        }
+
+        --_pos;
+        return *this;
+    }
+
+    _Btree_iterator
+    operator--(int) noexcept
+    {
+        _Btree_iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Btree_iterator &lhs, const _Btree_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node && lhs._pos == rhs._pos;
+    }
+
+    friend bool
+    operator!=(const _Btree_iterator &lhs, const _Btree_iterator &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief A readonly bidirectional iterator over the leaves of a B+ tree.
+ */
+template <typename _Leaf>
+struct _Btree_const_iterator
+{
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename _Leaf::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const value_type *;
+    using reference         = const value_type &;
+
+    const _Leaf *_node = nullptr;
+    std::size_t _pos   = 0;
+
+    _Btree_const_iterator() noexcept = default;
+
+    _Btree_const_iterator(const _Leaf *node, std::size_t pos) noexcept
+    : _node(node), _pos(pos)
+    {
+    }
+
+    _Btree_const_iterator(const _Btree_iterator<_Leaf> &it) noexcept
+    : _node(it._node), _pos(it._pos)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_slot(_pos);
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _node->_slot(_pos);
+    }
+
+    _Btree_const_iterator &
+    operator++() noexcept
+    {
+        if (++_pos == _node->_count && _node->_next != nullptr)
+        {
+            _node = _node->_next;
+            _pos  = 0;
+        }
+
+        return *this;
+    }
+
+    _Btree_const_iterator
+    operator++(int) noexcept
+    {
+        _Btree_const_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    _Btree_const_iterator &
+    operator--() noexcept
+    {
+        if (_pos == 0)
+        {
+            _node = _node->_prev;
+            _pos  = _node->_count;
+        }
+
+        --_pos;
+        return *this;
+    }
+
+    _Btree_const_iterator
+    operator--(int) noexcept
+    {
+        _Btree_const_iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    /**
+     * @brief Returns a mutable iterator to the same element.
+     */
+    _Btree_iterator<_Leaf>
+    _const_cast() const noexcept
+    {
+        return _Btree_iterator<_Leaf>(const_cast<_Leaf *>(_node), _pos);
+    }
+
+    friend bool
+    operator==(const _Btree_const_iterator &lhs,
+               const _Btree_const_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node && lhs._pos == rhs._pos;
+    }
+
+    friend bool
+    operator!=(const _Btree_const_iterator &lhs,
+               const _Btree_const_iterator &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief A B+ tree of unique keys
+ *
+ * @tparam _Key        Type of the keys.
+ * @tparam _Val        Type of the stored values.
+ * @tparam _KeyOfValue Function object extracting the key from a value.
+ * @tparam _Compare    Strict weak ordering of the keys.
+ * @tparam _Alloc      User-defined allocator.
+ * @tparam _NodeSize   Approximate size of a node in bytes.
+ *
+ * This is the common implementation behind opendsa::btree_map and
+ * opendsa::btree_set. Every value lives in a leaf, the leaves are linked in
+ * order, and the inner nodes only hold separator keys and child pointers. With
+ * nodes of a few cache lines, a lookup touches one node per level and a tree
+ * of millions of keys is only 4 or 5 levels deep, against 20 to 25 for a
+ * binary tree.
+ *
+ * A full leaf is split in two halves, except for the last leaf when the value
+ * goes at its very end: the new value then starts a new leaf, so that sorted
+ * insertions leave the leaves full. An underfull node borrows from a sibling
+ * or is merged with it.
+ *
+ * Unlike the binary trees, values move between nodes, so every insertion and
+ * erasure invalidates all iterators, and the keys must be copyable to be used
+ * as separators. Values and keys are moved as if their move constructor
+ * could not throw: if it does, std::terminate() is called.
+ */
+template <typename _Key, typename _Val, typename _KeyOfValue, typename _Compare,
+          typename _Alloc = std::allocator<_Val>, std::size_t _NodeSize = 512>
+class _Btree
+{
+private:
+    constexpr static std::size_t _S_leaf_slots =
+        _Btree_leaf_slots(_NodeSize, sizeof(_Val));
+    constexpr static std::size_t _S_inner_slots =
+        _Btree_inner_slots(_NodeSize, sizeof(_Key));
+
+    static_assert(_S_leaf_slots < 65536 && _S_inner_slots < 65536,
+                  "_Btree node counts must fit in an unsigned short");
+
+    using _Base  = _Btree_node_base;
+    using _Leaf  = _Btree_leaf<_Val, _S_leaf_slots>;
+    using _Inner = _Btree_inner<_Key, _S_inner_slots>;
+
+    using _Leaf_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Leaf>;
+    using _Inner_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Inner>;
+    using _Leaf_alloc_traits  = std::allocator_traits<_Leaf_alloc_type>;
+    using _Inner_alloc_traits = std::allocator_traits<_Inner_alloc_type>;
+    using _Propagate_on_copy =
+        typename _Leaf_alloc_traits::propagate_on_container_copy_assignment;
+    using _Propagate_on_move =
+        typename _Leaf_alloc_traits::propagate_on_container_move_assignment;
+
+public:
+    using key_type               = _Key;
+    using value_type             = _Val;
+    using key_compare            = _Compare;
+    using allocator_type         = _Alloc;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = _Btree_iterator<_Leaf>;
+    using const_iterator         = _Btree_const_iterator<_Leaf>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Creates an empty tree.
+     */
+    _Btree()
+    : _comp(), _root(nullptr), _first(nullptr), _last(nullptr), _count(0),
+      _leaf_alloc(), _inner_alloc()
+    {
+    }
+
+    /**
+     * @brief Creates an empty tree with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit _Btree(const _Compare &comp, const _Alloc &alloc = _Alloc())
+    : _comp(comp), _root(nullptr), _first(nullptr), _last(nullptr),
+      _count(0), _leaf_alloc(alloc), _inner_alloc(alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a tree by copying the values of another one in order.
+     */
+    _Btree(const _Btree &other)
+    : _comp(other._comp), _root(nullptr), _first(nullptr), _last(nullptr),
+      _count(0),
+      _leaf_alloc(_Leaf_alloc_traits::select_on_container_copy_construction(
+          other._leaf_alloc)),
+      _inner_alloc(
+          _Inner_alloc_traits::select_on_container_copy_construction(
+              other._inner_alloc))
+    {
+        try
+        {
+            for (const_iterator it = other.begin(); it != other.end(); ++it)
+                _insert_hint_unique(end(), *it);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Creates a tree by stealing the nodes of another one.
+     */
+    _Btree(_Btree &&other) noexcept
+    : _comp(other._comp), _root(nullptr), _first(nullptr), _last(nullptr),
+      _count(0), _leaf_alloc(std::move(other._leaf_alloc)),
+      _inner_alloc(std::move(other._inner_alloc))
+    {
+        _steal(other);
+    }
+
+    ~_Btree() { clear(); }
+
+    /**
+     * @brief Copies the values of another tree into nodes from the
+     * allocator this tree ends up with, i.e. the one of @a other if it
+     * propagates on copy assignment.
+     */
+    _Btree &
+    operator=(const _Btree &other)
+    {
+        if (&other == this)
+            return *this;
+
+        _Btree tmp(other._comp, _Propagate_on_copy::value
+                                    ? allocator_type(other._leaf_alloc)
+                                    : allocator_type(_leaf_alloc));
+        tmp.insert_sorted(other.begin(), other.end());
+
+        clear();
+        if constexpr (_Propagate_on_copy::value)
+        {
+            _leaf_alloc  = other._leaf_alloc;
+            _inner_alloc = other._inner_alloc;
+        }
+        _comp = tmp._comp;
+        _steal(tmp);
+
+        return *this;
+    }
+
+    /**
+     * @brief Takes the values of another tree. Its nodes are stolen if the
+     * allocator propagates on move assignment or the allocators are equal,
+     * otherwise the values are moved one by one into nodes from the
+     * allocator of this tree.
+     */
+    _Btree &
+    operator=(_Btree &&other) noexcept(
+        _Propagate_on_move::value || _Leaf_alloc_traits::is_always_equal::value)
+    {
+        if (&other == this)
+            return *this;
+
+        clear();
+        _comp = other._comp;
+
+        if constexpr (_Propagate_on_move::value)
+        {
+            _leaf_alloc  = std::move(other._leaf_alloc);
+            _inner_alloc = std::move(other._inner_alloc);
+            _steal(other);
+        }
+        else if (_leaf_alloc == other._leaf_alloc)
+            _steal(other);
+        else
+        {
+            try
+            {
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    _insert_hint_unique(end(), std::move(*it));
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _comp;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_leaf_alloc);
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(_first, 0);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_first, 0);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(_last, _last != nullptr ? _last->_count : 0);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(_last, _last != nullptr ? _last->_count : 0);
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _count == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _count;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _Leaf_alloc_traits::max_size(_leaf_alloc) * _S_leaf_slots;
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts @a v unless an equivalent key already exists.
+     *
+     * Returns an iterator to the element with the key of @a v, and whether
+     * the insertion took place.
+     */
+    template <typename _Arg>
+    std::pair<iterator, bool>
+    _insert_unique(_Arg &&v)
+    {
+        const key_type &k = _KeyOfValue()(v);
+        iterator pos      = _find_insert_pos(k);
+
+        if (pos._pos < pos._node->_count && !_comp(k, _S_key(pos)))
+            return {pos, false};
+
+        return {_insert_at(pos, k, std::forward<_Arg>(v)), true};
+    }
+
+    /**
+     * @brief Inserts @a v using @a hint as a suggestion of where it goes.
+     *
+     * The search is skipped if @a v belongs right before @a hint, e.g. when
+     * inserting sorted data with end() as the hint.
+     */
+    template <typename _Arg>
+    iterator
+    _insert_hint_unique(const_iterator hint, _Arg &&v)
+    {
+        const key_type &k = _KeyOfValue()(v);
+
+        if (_fits_before(hint, k))
+            return _insert_at(hint._const_cast(), k, std::forward<_Arg>(v));
+
+        return _insert_unique(std::forward<_Arg>(v)).first;
+    }
+
+    /**
+     * @brief Constructs a new element unless an equivalent key already
+     * exists.
+     *
+     * The value is constructed first to know its key, then moved into the
+     * tree.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    _emplace_unique(Args &&...args)
+    {
+        value_type v(std::forward<Args>(args)...);
+        return _insert_unique(std::move(v));
+    }
+
+    template <typename... Args>
+    iterator
+    _emplace_hint_unique(const_iterator hint, Args &&...args)
+    {
+        value_type v(std::forward<Args>(args)...);
+        return _insert_hint_unique(hint, std::move(v));
+    }
+
+    /**
+     * @brief Removes the element at @a pos and returns an iterator to the
+     * element following it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        _Leaf *leaf   = const_cast<_Leaf *>(pos._node);
+        size_type idx = pos._pos;
+
+        std::destroy_at(leaf->_slot(idx));
+        _S_relocate(leaf->_slot(idx), leaf->_slot(idx + 1),
+                    leaf->_count - idx - 1);
+        leaf->_count--;
+        _count--;
+
+        if (leaf == _root)
+        {
+            if (leaf->_count == 0)
+            {
+                _drop_leaf(leaf);
+                _root  = nullptr;
+                _first = nullptr;
+                _last  = nullptr;
+                return end();
+            }
+        }
+        else if (leaf->_count < _S_min_leaf)
+            _rebalance_leaf(leaf, idx);
+
+        if (idx == leaf->_count && leaf->_next != nullptr)
+            return iterator(leaf->_next, 0);
+        return iterator(leaf, idx);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        if (first == begin() && last == end())
+        {
+            clear();
+            return end();
+        }
+
+        // Every erasure invalidates @a last, so count the elements instead.
+        difference_type n = std::distance(first, last);
+        iterator it       = first._const_cast();
+        for (; n > 0; n--)
+            it = erase(it);
+
+        return it;
+    }
+
+    /**
+     * @brief Removes the element with the key @a k, if present.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+
+        erase(it);
+        return 1;
+    }
+
+    /**
+     * @brief Removes every element.
+     */
+    void
+    clear() noexcept
+    {
+        if (_root != nullptr)
+            _drop_subtree(_root);
+
+        _root  = nullptr;
+        _first = nullptr;
+        _last  = nullptr;
+        _count = 0;
+    }
+
+    /**
+     * @brief Swaps the content of two trees in constant time.
+     */
+    void
+    swap(_Btree &other) noexcept
+    {
+        std::swap(_comp, other._comp);
+        std::swap(_root, other._root);
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_count, other._count);
+
+        if constexpr (_Leaf_alloc_traits::propagate_on_container_swap::value)
+        {
+            std::swap(_leaf_alloc, other._leaf_alloc);
+            std::swap(_inner_alloc, other._inner_alloc);
+        }
+    }
+
+    // Lookup
+
+    iterator
+    find(const key_type &k)
+    {
+        return const_cast<const _Btree *>(this)->find(k)._const_cast();
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        const_iterator j = lower_bound(k);
+        return (j == end() || _comp(k, _S_key(j))) ? end() : j;
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+
+    /**
+     * @brief Returns the first element whose key is not less than @a k.
+     */
+    iterator
+    lower_bound(const key_type &k)
+    {
+        return const_cast<const _Btree *>(this)->lower_bound(k)._const_cast();
+    }
+
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        if (_root == nullptr)
+            return end();
+
+        const _Leaf *leaf = _find_leaf(k);
+        return _S_normalize(const_iterator(leaf, _lower_index(leaf, k)));
+    }
+
+    /**
+     * @brief Returns the first element whose key is greater than @a k.
+     */
+    iterator
+    upper_bound(const key_type &k)
+    {
+        return const_cast<const _Btree *>(this)->upper_bound(k)._const_cast();
+    }
+
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        if (_root == nullptr)
+            return end();
+
+        const _Leaf *leaf = _find_leaf(k);
+        return _S_normalize(const_iterator(leaf, _upper_index(leaf, k)));
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k)
+    {
+        iterator first = lower_bound(k);
+        iterator last  = first;
+        if (last != end() && !_comp(k, _S_key(last)))
+            ++last;
+
+        return {first, last};
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &k) const
+    {
+        const_iterator first = lower_bound(k);
+        const_iterator last  = first;
+        if (last != end() && !_comp(k, _S_key(last)))
+            ++last;
+
+        return {first, last};
+    }
+
+    // Bulk loading
+
+    /**
+     * @brief Creates a tree from a sorted range.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The values are appended without any search and the leaves are filled
+     * up, so this is O(n) and the tree is as compact as it gets.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static _Btree
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        _Btree tree(comp, alloc);
+        tree.insert_sorted(first, last);
+        return tree;
+    }
+
+    /**
+     * @brief Inserts a sorted range of values.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     *
+     * Each value uses the position after the previous one as a hint, so the
+     * search is skipped as long as the batch falls into the same leaf or
+     * goes to the end of the tree.
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        const_iterator hint = end();
+        for (; first != last; ++first)
+            hint = std::next(_insert_hint_unique(hint, *first));
+    }
+
+private:
+    constexpr static size_type _S_min_leaf  = _S_leaf_slots / 2;
+    constexpr static size_type _S_min_inner = _S_inner_slots / 2;
+
+    _Compare _comp;
+    _Base *_root;
+    _Leaf *_first; // Leftmost leaf
+    _Leaf *_last;  // Rightmost leaf
+    size_type _count;
+    _Leaf_alloc_type _leaf_alloc;
+    _Inner_alloc_type _inner_alloc;
+
+    template <typename _Iter>
+    static const key_type &
+    _S_key(const _Iter &it)
+    {
+        return _KeyOfValue()(*it);
+    }
+
+    static const key_type &
+    _S_key(const _Leaf *leaf, size_type i)
+    {
+        return _KeyOfValue()(*leaf->_slot(i));
+    }
+
+    static _Leaf *
+    _S_as_leaf(_Base *x) noexcept
+    {
+        return static_cast<_Leaf *>(x);
+    }
+
+    static _Inner *
+    _S_as_inner(_Base *x) noexcept
+    {
+        return static_cast<_Inner *>(x);
+    }
+
+    /**
+     * Moves @a n objects from @a src to @a dst, which may overlap. The source
+     * objects are destroyed.
+     */
+    template <typename _Tp>
+    static void
+    _S_relocate(_Tp *dst, _Tp *src, size_type n) noexcept
+    {
+        if (n == 0 || dst == src)
+            return;
+
+        if constexpr (std::is_trivially_copy_constructible_v<_Tp> &&
+                      std::is_trivially_destructible_v<_Tp>)
+            std::memmove(static_cast<void *>(dst),
+                         static_cast<const void *>(src), n * sizeof(_Tp));
+        else if (dst < src)
+        {
+            for (size_type i = 0; i < n; i++)
+            {
+                std::construct_at(dst + i, std::move(src[i]));
+                std::destroy_at(src + i);
+            }
+        }
+        else
+        {
+            for (size_type i = n; i > 0; i--)
+            {
+                std::construct_at(dst + i - 1, std::move(src[i - 1]));
+                std::destroy_at(src + i - 1);
+            }
+        }
+    }
+
+    /**
+     * Turns a position past the last value of a leaf into the first value of
+     * the next leaf, unless it is the past-the-end position.
+     */
+    template <typename _Iter>
+    static _Iter
+    _S_normalize(_Iter it) noexcept
+    {
+        if (it._pos == it._node->_count && it._node->_next != nullptr)
+            return _Iter(it._node->_next, 0);
+        return it;
+    }
+
+    void
+    _steal(_Btree &other) noexcept
+    {
+        _root  = other._root;
+        _first = other._first;
+        _last  = other._last;
+        _count = other._count;
+
+        other._root  = nullptr;
+        other._first = nullptr;
+        other._last  = nullptr;
+        other._count = 0;
+    }
+
+    _Leaf *
+    _create_leaf()
+    {
+        _Leaf *leaf = _Leaf_alloc_traits::allocate(_leaf_alloc, 1);
+        ::new (static_cast<void *>(leaf)) _Leaf;
+        return leaf;
+    }
+
+    _Inner *
+    _create_inner()
+    {
+        _Inner *inner = _Inner_alloc_traits::allocate(_inner_alloc, 1);
+        ::new (static_cast<void *>(inner)) _Inner;
+        return inner;
+    }
+
+    void
+    _drop_leaf(_Leaf *leaf) noexcept
+    {
+        _Leaf_alloc_traits::deallocate(_leaf_alloc, leaf, 1);
+    }
+
+    void
+    _drop_inner(_Inner *inner) noexcept
+    {
+        _Inner_alloc_traits::deallocate(_inner_alloc, inner, 1);
+    }
+
+    /**
+     * Destroys every value and key of the subtree rooted at @a x and frees
+     * its nodes.
+     */
+    void
+    _drop_subtree(_Base *x) noexcept
+    {
+        if (x->_leaf)
+        {
+            _Leaf *leaf = _S_as_leaf(x);
+            std::destroy(leaf->_slot(0), leaf->_slot(leaf->_count));
+            _drop_leaf(leaf);
+            return;
+        }
+
+        _Inner *inner = _S_as_inner(x);
+        for (size_type i = 0; i <= inner->_count; i++)
+            _drop_subtree(inner->_children[i]);
+
+        std::destroy(inner->_key(0), inner->_key(inner->_count));
+        _drop_inner(inner);
+    }
+
+    /**
+     * Returns the number of keys of @a inner that are not greater than
+     * @a k, i.e. the index of the child whose range contains @a k.
+     */
+    size_type
+    _child_index_for(const _Inner *inner, const key_type &k) const
+    {
+        size_type lo = 0;
+        size_type hi = inner->_count;
+
+        while (lo < hi)
+        {
+            const size_type mid = (lo + hi) / 2;
+            if (_comp(k, *inner->_key(mid)))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+
+        return lo;
+    }
+
+    size_type
+    _lower_index(const _Leaf *leaf, const key_type &k) const
+    {
+        size_type lo = 0;
+        size_type hi = leaf->_count;
+
+        while (lo < hi)
+        {
+            const size_type mid = (lo + hi) / 2;
+            if (_comp(_S_key(leaf, mid), k))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        return lo;
+    }
+
+    size_type
+    _upper_index(const _Leaf *leaf, const key_type &k) const
+    {
+        size_type lo = 0;
+        size_type hi = leaf->_count;
+
+        while (lo < hi)
+        {
+            const size_type mid = (lo + hi) / 2;
+            if (_comp(k, _S_key(leaf, mid)))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+
+        return lo;
+    }
+
+    /**
+     * Returns the leaf whose range contains @a k. The tree must not be
+     * empty.
+     */
+    _Leaf *
+    _find_leaf(const key_type &k) const
+    {
+        _Base *x = _root;
+        while (!x->_leaf)
+        {
+            _Inner *inner = _S_as_inner(x);
+            x             = inner->_children[_child_index_for(inner, k)];
+        }
+
+        return _S_as_leaf(x);
+    }
+
+    /**
+     * Returns where @a k goes in the leaf whose range contains it, without
+     * moving to the next leaf, so that an insertion there keeps the
+     * separators valid. An empty tree gets an empty root leaf.
+     */
+    iterator
+    _find_insert_pos(const key_type &k)
+    {
+        if (_root == nullptr)
+        {
+            _Leaf *leaf = _create_leaf();
+            _root       = leaf;
+            _first      = leaf;
+            _last       = leaf;
+        }
+
+        _Leaf *leaf = _find_leaf(k);
+        return iterator(leaf, _lower_index(leaf, k));
+    }
+
+    /**
+     * Returns whether @a k can be inserted right before @a hint. The
+     * position must be inside a leaf, or at the very beginning or end of the
+     * tree, as the range of a leaf is otherwise unknown at its boundaries.
+     */
+    bool
+    _fits_before(const_iterator hint, const key_type &k) const
+    {
+        if (_root == nullptr)
+            return false;
+
+        const _Leaf *leaf = hint._node;
+        const size_type i = hint._pos;
+
+        if (i == 0 && leaf->_prev != nullptr)
+            return false;
+        if (i > 0 && !_comp(_S_key(leaf, i - 1), k))
+            return false;
+        if (i < leaf->_count && !_comp(k, _S_key(leaf, i)))
+            return false;
+
+        return i < leaf->_count || leaf->_next == nullptr;
+    }
+
+    /**
+     * Constructs a value with the key @a k from @a args at @a pos, splitting
+     * the leaf first if it is full. Returns an iterator to the new element.
+     */
+    template <typename... Args>
+    iterator
+    _insert_at(iterator pos, const key_type &k, Args &&...args)
+    {
+        _Leaf *leaf   = pos._node;
+        size_type idx = pos._pos;
+
+        if (leaf->_count == _S_leaf_slots)
+        {
+            // Appending to the last leaf starts a new one, so that sorted
+            // insertions fill up the leaves instead of leaving them half
+            // full.
+            const size_type mid =
+                (idx == _S_leaf_slots && leaf->_next == nullptr)
+                    ? _S_leaf_slots
+                    : _S_leaf_slots / 2;
+
+            // A value going right at @a mid stays in the left leaf, as the
+            // separator is the first value of the right one, unless the
+            // right leaf starts empty.
+            _Leaf *right = _split_leaf(leaf, mid, k);
+            if (idx > mid || mid == _S_leaf_slots)
+            {
+                leaf = right;
+                idx -= mid;
+            }
+        }
+
+        _S_relocate(leaf->_slot(idx + 1), leaf->_slot(idx),
+                    leaf->_count - idx);
+
+        try
+        {
+            std::construct_at(leaf->_slot(idx), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            _S_relocate(leaf->_slot(idx), leaf->_slot(idx + 1),
+                        leaf->_count - idx);
+            throw;
+        }
+
+        leaf->_count++;
+        _count++;
+
+        return iterator(leaf, idx);
+    }
+
+    /**
+     * Moves the values of @a leaf from @a mid onward to a new leaf linked
+     * after it, and adds the new leaf to the parent. @a k is the separator
+     * when the new leaf starts empty.
+     */
+    _Leaf *
+    _split_leaf(_Leaf *leaf, size_type mid, const key_type &k)
+    {
+        _Leaf *right = _create_leaf();
+
+        try
+        {
+            const key_type &sep = (mid < leaf->_count) ? _S_key(leaf, mid) : k;
+            _insert_child(leaf, sep, right);
+        }
+        catch (...)
+        {
+            _drop_leaf(right);
+            throw;
+        }
+
+        _S_relocate(right->_slot(0), leaf->_slot(mid), leaf->_count - mid);
+        right->_count = static_cast<unsigned short>(leaf->_count - mid);
+        leaf->_count  = static_cast<unsigned short>(mid);
+
+        right->_prev = leaf;
+        right->_next = leaf->_next;
+        if (leaf->_next != nullptr)
+            leaf->_next->_prev = right;
+        else
+            _last = right;
+        leaf->_next = right;
+
+        return right;
+    }
+
+    /**
+     * Adds @a right as the child right after @a left in the parent of
+     * @a left, with @a sep as the separator key between them. The parent is
+     * split if it is full, and a new root is created if @a left is the root.
+     */
+    void
+    _insert_child(_Base *left, const key_type &sep, _Base *right)
+    {
+        if (left->_parent == nullptr)
+        {
+            _Inner *root = _create_inner();
+
+            try
+            {
+                std::construct_at(root->_key(0), sep);
+            }
+            catch (...)
+            {
+                _drop_inner(root);
+                throw;
+            }
+
+            root->_count       = 1;
+            root->_children[0] = left;
+            root->_children[1] = right;
+            left->_parent      = root;
+            right->_parent     = root;
+            _root              = root;
+            return;
+        }
+
+        _Inner *parent = _S_as_inner(left->_parent);
+        size_type idx  = _child_index(parent, left);
+
+        if (parent->_count == _S_inner_slots)
+        {
+            const size_type mid = _S_inner_slots / 2;
+            _Inner *sibling     = _split_inner(parent, mid);
+
+            if (idx > mid)
+            {
+                parent = sibling;
+                idx -= mid + 1;
+            }
+        }
+
+        std::construct_at(parent->_key(parent->_count), sep);
+        std::rotate(parent->_key(idx), parent->_key(parent->_count),
+                    parent->_key(parent->_count + 1));
+
+        std::copy_backward(parent->_children + idx + 1,
+                           parent->_children + parent->_count + 1,
+                           parent->_children + parent->_count + 2);
+        parent->_children[idx + 1] = right;
+        right->_parent             = parent;
+        parent->_count++;
+    }
+
+    /**
+     * Moves the keys after @a mid and the children after @a mid + 1 of
+     * @a inner to a new inner node, and pushes the key at @a mid up to the
+     * parent.
+     */
+    _Inner *
+    _split_inner(_Inner *inner, size_type mid)
+    {
+        _Inner *right = _create_inner();
+
+        try
+        {
+            _insert_child(inner, *inner->_key(mid), right);
+        }
+        catch (...)
+        {
+            _drop_inner(right);
+            throw;
+        }
+
+        const size_type n = inner->_count - mid - 1;
+        _S_relocate(right->_key(0), inner->_key(mid + 1), n);
+        std::destroy_at(inner->_key(mid));
+
+        for (size_type i = 0; i <= n; i++)
+        {
+            right->_children[i]          = inner->_children[mid + 1 + i];
+            right->_children[i]->_parent = right;
+        }
+
+        right->_count = static_cast<unsigned short>(n);
+        inner->_count = static_cast<unsigned short>(mid);
+
+        return right;
+    }
+
+    static size_type
+    _child_index(const _Inner *parent, const _Base *child) noexcept
+    {
+        size_type i = 0;
+        while (parent->_children[i] != child)
+            i++;
+        return i;
+    }
+
+    /**
+     * Replaces the separator key at @a i of @a inner.
+     */
+    static void
+    _set_key(_Inner *inner, size_type i, const key_type &k)
+    {
+        *inner->_key(i) = k;
+    }
+
+    /**
+     * Removes the key at @a i and the child at @a i + 1 of @a inner.
+     */
+    static void
+    _remove_child(_Inner *inner, size_type i) noexcept
+    {
+        std::destroy_at(inner->_key(i));
+        _S_relocate(inner->_key(i), inner->_key(i + 1),
+                    inner->_count - i - 1);
+        std::copy(inner->_children + i + 2,
+                  inner->_children + inner->_count + 1,
+                  inner->_children + i + 1);
+        inner->_count--;
+    }
+
+    /**
+     * Restores the minimum occupancy of @a leaf by borrowing a value from a
+     * sibling or merging with it. @a leaf and @a idx are updated to keep
+     * pointing at the same position.
+     */
+    void
+    _rebalance_leaf(_Leaf *&leaf, size_type &idx)
+    {
+        _Inner *parent    = _S_as_inner(leaf->_parent);
+        const size_type i = _child_index(parent, leaf);
+        _Leaf *left       = i > 0 ? _S_as_leaf(parent->_children[i - 1])
+                                  : nullptr;
+        _Leaf *right      = i < parent->_count
+                                ? _S_as_leaf(parent->_children[i + 1])
+                                : nullptr;
+
+        if (left != nullptr && left->_count > _S_min_leaf)
+        {
+            _S_relocate(leaf->_slot(1), leaf->_slot(0), leaf->_count);
+            _S_relocate(leaf->_slot(0), left->_slot(left->_count - 1), 1);
+            left->_count--;
+            leaf->_count++;
+            _set_key(parent, i - 1, _S_key(leaf, 0));
+            idx++;
+        }
+        else if (right != nullptr && right->_count > _S_min_leaf)
+        {
+            _S_relocate(leaf->_slot(leaf->_count), right->_slot(0), 1);
+            _S_relocate(right->_slot(0), right->_slot(1), right->_count - 1);
+            right->_count--;
+            leaf->_count++;
+            _set_key(parent, i, _S_key(right, 0));
+        }
+        else if (left != nullptr)
+        {
+            idx += left->_count;
+            _merge_leaves(left, leaf, parent, i - 1);
+            leaf = left;
+        }
+        else
+            _merge_leaves(leaf, right, parent, i);
+    }
+
+    /**
+     * Moves every value of @a right into @a left, which are the children at
+     * @a i and @a i + 1 of @a parent, and frees @a right.
+     */
+    void
+    _merge_leaves(_Leaf *left, _Leaf *right, _Inner *parent, size_type i)
+    {
+        _S_relocate(left->_slot(left->_count), right->_slot(0), right->_count);
+        left->_count += right->_count;
+
+        left->_next = right->_next;
+        if (right->_next != nullptr)
+            right->_next->_prev = left;
+        else
+            _last = left;
+
+        _drop_leaf(right);
+        _remove_child(parent, i);
+        _rebalance_inner(parent);
+    }
+
+    /**
+     * Restores the minimum occupancy of @a inner, and shrinks the tree when
+     * the root is left with a single child.
+     */
+    void
+    _rebalance_inner(_Inner *inner)
+    {
+        if (inner == _root)
+        {
+            if (inner->_count == 0)
+            {
+                _root          = inner->_children[0];
+                _root->_parent = nullptr;
+                _drop_inner(inner);
+            }
+            return;
+        }
+
+        if (inner->_count >= _S_min_inner)
+            return;
+
+        _Inner *parent    = _S_as_inner(inner->_parent);
+        const size_type i = _child_index(parent, inner);
+        _Inner *left      = i > 0 ? _S_as_inner(parent->_children[i - 1])
+                                  : nullptr;
+        _Inner *right     = i < parent->_count
+                                ? _S_as_inner(parent->_children[i + 1])
+                                : nullptr;
+
+        if (left != nullptr && left->_count > _S_min_inner)
+        {
+            // Rotate the last child of the left sibling through the parent.
+            _S_relocate(inner->_key(1), inner->_key(0), inner->_count);
+            std::copy_backward(inner->_children,
+                               inner->_children + inner->_count + 1,
+                               inner->_children + inner->_count + 2);
+
+            _S_relocate(inner->_key(0), parent->_key(i - 1), 1);
+            _S_relocate(parent->_key(i - 1), left->_key(left->_count - 1), 1);
+            inner->_children[0]          = left->_children[left->_count];
+            inner->_children[0]->_parent = inner;
+
+            left->_count--;
+            inner->_count++;
+        }
+        else if (right != nullptr && right->_count > _S_min_inner)
+        {
+            // Rotate the first child of the right sibling through the
+            // parent.
+            _S_relocate(inner->_key(inner->_count), parent->_key(i), 1);
+            _S_relocate(parent->_key(i), right->_key(0), 1);
+            inner->_children[inner->_count + 1] = right->_children[0];
+            right->_children[0]->_parent        = inner;
+
+            _S_relocate(right->_key(0), right->_key(1), right->_count - 1);
+            std::copy(right->_children + 1,
+                      right->_children + right->_count + 1, right->_children);
+
+            right->_count--;
+            inner->_count++;
+        }
+        else if (left != nullptr)
+            _merge_inners(left, inner, parent, i - 1);
+        else
+            _merge_inners(inner, right, parent, i);
+    }
+
+    /**
+     * Moves the separator at @a i of @a parent, then every key and child of
+     * @a right into @a left, and frees @a right.
+     */
+    void
+    _merge_inners(_Inner *left, _Inner *right, _Inner *parent, size_type i)
+    {
+        const size_type n = left->_count;
+
+        std::construct_at(left->_key(n), std::move(*parent->_key(i)));
+        _S_relocate(left->_key(n + 1), right->_key(0), right->_count);
+
+        for (size_type j = 0; j <= right->_count; j++)
+        {
+            left->_children[n + 1 + j]          = right->_children[j];
+            left->_children[n + 1 + j]->_parent = left;
+        }
+
+        left->_count = static_cast<unsigned short>(n + 1 + right->_count);
+        _drop_inner(right);
+
+        _remove_child(parent, i);
+        _rebalance_inner(parent);
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_BTREE_H */
@@ -0,0 +1,465 @@
+/**
+ * @file btree_set.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered associative container of unique keys in a B+ tree
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_BTREE_SET_H
+#define __OPENDSA_BTREE_SET_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "helper.h"
+#include "btree.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief An ordered set of unique keys backed by a B+ tree
+ *
+ * @tparam _Key      Type of the keys.
+ * @tparam _Compare  Strict weak ordering of the keys.
+ * @tparam _Alloc    User-defined allocator.
+ * @tparam _NodeSize Approximate size of a node in bytes.
+ *
+ * A btree_set is an adapter over a _Btree whose values are their own keys. It
+ * has the interface of opendsa::set, but the keys are packed in nodes of about
+ * _NodeSize bytes.
+ *
+ * Keys move between nodes when the tree changes, so unlike opendsa::set,
+ * every insertion or removal invalidates all iterators and references.
+ */
+template <typename _Key, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<_Key>, std::size_t _NodeSize = 512>
+class btree_set
+{
+private:
+    using _Tree_type =
+        _Btree<_Key, _Key, _Identity, _Compare, _Alloc, _NodeSize>;
+
+public:
+    using key_type               = _Key;
+    using value_type             = _Key;
+    using key_compare            = _Compare;
+    using value_compare          = _Compare;
+    using allocator_type         = _Alloc;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using size_type              = typename _Tree_type::size_type;
+    using difference_type        = typename _Tree_type::difference_type;
+    using iterator               = typename _Tree_type::const_iterator;
+    using const_iterator         = typename _Tree_type::const_iterator;
+    using reverse_iterator       = typename _Tree_type::const_reverse_iterator;
+    using const_reverse_iterator = typename _Tree_type::const_reverse_iterator;
+
+    /**
+     * @brief Creates an empty %btree_set.
+     */
+    btree_set() : _tree() { }
+
+    /**
+     * @brief Creates an empty %btree_set with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit btree_set(const _Compare &comp, const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %btree_set based on a range of elements.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     *
+     * Duplicated keys are only inserted once.
+     */
+    template <typename _InputIter>
+    btree_set(_InputIter first, _InputIter last,
+              const _Compare &comp = _Compare(),
+              const _Alloc &alloc  = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %btree_set based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    btree_set(std::initializer_list<value_type> list,
+              const _Compare &comp = _Compare(),
+              const _Alloc &alloc  = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Creates a %btree_set from a sorted range in linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The range must be sorted by @a comp. The keys are appended without any
+     * search and the leaves are filled up, e.g. to reload a snapshot.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static btree_set
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        btree_set res(comp, alloc);
+        res.insert_sorted(first, last);
+        return res;
+    }
+
+    btree_set(const btree_set &other) = default;
+
+    btree_set(btree_set &&other) noexcept = default;
+
+    btree_set &
+    operator=(const btree_set &other) = default;
+
+    btree_set &
+    operator=(btree_set &&other) = default;
+
+    btree_set &
+    operator=(std::initializer_list<value_type> list)
+    {
+        _tree.clear();
+        insert(list.begin(), list.end());
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _tree.get_allocator();
+    }
+
+    // Iterators
+
+    iterator
+    begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    iterator
+    end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return _tree.end();
+    }
+
+    reverse_iterator
+    rbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    reverse_iterator
+    rend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %btree_set is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the %btree_set.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _tree.max_size();
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Removes every element of the %btree_set.
+     */
+    void
+    clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief Inserts a key unless it already exists.
+     *
+     * @param x Key to be inserted.
+     *
+     * Returns an iterator to the element equivalent to @a x, and whether the
+     * insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._insert_unique(x);
+        return {res.first, res.second};
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._insert_unique(std::move(x));
+        return {res.first, res.second};
+    }
+
+    /**
+     * @brief Inserts a key using @a hint as a suggestion of where it goes.
+     *
+     * @param hint Iterator to the element that would follow the new one.
+     * @param x    Key to be inserted.
+     *
+     * The search is skipped if the new element goes right before @a hint
+     * inside the same leaf, or at the end of the tree.
+     */
+    iterator
+    insert(const_iterator hint, const value_type &x)
+    {
+        return _tree._insert_hint_unique(hint, x);
+    }
+
+    iterator
+    insert(const_iterator hint, value_type &&x)
+    {
+        return _tree._insert_hint_unique(hint, std::move(x));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last).
+     */
+    template <typename _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            _tree._insert_hint_unique(end(), *first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Inserts a sorted range of keys.
+     *
+     * Each key is inserted using the previous one as a hint. See
+     * _Btree::insert_sorted().
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        _tree.insert_sorted(first, last);
+    }
+
+    /**
+     * @brief Constructs a new key in place unless it already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._emplace_unique(std::forward<Args>(args)...);
+        return {res.first, res.second};
+    }
+
+    /**
+     * @brief Constructs a new key in place using @a hint as a suggestion of
+     * where it goes.
+     */
+    template <typename... Args>
+    iterator
+    emplace_hint(const_iterator hint, Args &&...args)
+    {
+        return _tree._emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the key @a k, if present.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+
+        _tree.erase(it);
+        return 1;
+    }
+
+    /**
+     * @brief Swaps the content between two btree_sets in constant time.
+     */
+    void
+    swap(btree_set &other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // Lookup
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _tree.find(k) == _tree.end() ? 0 : 1;
+    }
+
+    iterator
+    find(const key_type &k) const
+    {
+        return _tree.find(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _tree.find(k) != _tree.end();
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k) const
+    {
+        return _tree.equal_range(k);
+    }
+
+    /**
+     * @brief Returns the first key that is not less than @a k.
+     */
+    iterator
+    lower_bound(const key_type &k) const
+    {
+        return _tree.lower_bound(k);
+    }
+
+    /**
+     * @brief Returns the first key that is greater than @a k.
+     */
+    iterator
+    upper_bound(const key_type &k) const
+    {
+        return _tree.upper_bound(k);
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _tree.key_comp();
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return _tree.key_comp();
+    }
+
+    friend bool
+    operator==(const btree_set &lhs, const btree_set &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool
+    operator!=(const btree_set &lhs, const btree_set &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    _Tree_type _tree;
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_BTREE_SET_H */
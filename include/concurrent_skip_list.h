@@ -0,0 +1,844 @@
+/**
+ * @file concurrent_skip_list.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered map that can be used by several threads at once
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_CONCURRENT_SKIP_LIST_H
+#define __OPENDSA_CONCURRENT_SKIP_LIST_H 1
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include "helper.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A test-and-test-and-set spin lock, for critical sections of a few
+ * instructions.
+ */
+class _Spin_lock
+{
+public:
+    _Spin_lock() noexcept : _locked(false) { }
+
+    void
+    lock() noexcept
+    {
+        while (_locked.exchange(true, std::memory_order_acquire))
+        {
+            for (unsigned spins = 0;
+                 _locked.load(std::memory_order_relaxed); spins++)
+            {
+                if (spins >= _S_max_spins)
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+    void
+    unlock() noexcept
+    {
+        _locked.store(false, std::memory_order_release);
+    }
+
+private:
+    constexpr static unsigned _S_max_spins = 64;
+
+    std::atomic<bool> _locked;
+};
+
+/**
+ * @brief A node of a concurrent skip list, followed in memory by its array of
+ * @a _height forward pointers.
+ *
+ * @a _marked is set under the lock of the node when it is logically removed,
+ * and @a _linked once it is reachable at every level. @a _link chains the node
+ * into the lists of retired and free nodes, and is never used by searches.
+ */
+template <typename _Val>
+struct _Skip_list_node
+{
+    using _Next = std::atomic<_Skip_list_node *>;
+
+    std::atomic<_Skip_list_node *> _link;
+    _Spin_lock _lock;
+    std::atomic<bool> _marked;
+    std::atomic<bool> _linked;
+    unsigned char _height;
+    alignas(_Val) unsigned char _storage[sizeof(_Val)];
+
+    constexpr static std::size_t _S_next_offset =
+        (sizeof(_Skip_list_node) + alignof(_Next) - 1) / alignof(_Next) *
+        alignof(_Next);
+
+    explicit _Skip_list_node(unsigned char height) noexcept
+    : _link(nullptr), _lock(), _marked(false), _linked(false), _height(height)
+    {
+        for (unsigned char i = 0; i < height; i++)
+            ::new (static_cast<void *>(_next() + i)) _Next(nullptr);
+    }
+
+    /**
+     * @brief Returns the number of bytes of a node of a given height.
+     */
+    static constexpr std::size_t
+    _S_size(unsigned char height) noexcept
+    {
+        return _S_next_offset + height * sizeof(_Next);
+    }
+
+    _Next *
+    _next() noexcept
+    {
+        return std::launder(reinterpret_cast<_Next *>(
+            reinterpret_cast<unsigned char *>(this) + _S_next_offset));
+    }
+
+    const _Next *
+    _next() const noexcept
+    {
+        return const_cast<_Skip_list_node *>(this)->_next();
+    }
+
+    _Skip_list_node *
+    _load_next(unsigned char level) const noexcept
+    {
+        return _next()[level].load(std::memory_order_acquire);
+    }
+
+    _Val *
+    _valptr() noexcept
+    {
+        return std::launder(reinterpret_cast<_Val *>(_storage));
+    }
+
+    const _Val *
+    _valptr() const noexcept
+    {
+        return std::launder(reinterpret_cast<const _Val *>(_storage));
+    }
+};
+
+/**
+ * @brief Forward iterator over the present nodes of a concurrent skip list.
+ *
+ * The iterator follows the bottom level and skips the nodes that are being
+ * inserted or were removed. It stays valid while other threads insert and
+ * remove elements, and sees the elements that are present when it reaches
+ * their position.
+ */
+template <typename _Val>
+struct _Skip_list_iterator
+{
+    using value_type        = _Val;
+    using reference         = const _Val &;
+    using pointer           = const _Val *;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Skip_list_node<_Val>;
+
+    const node_type *_node;
+
+    _Skip_list_iterator() noexcept : _node(nullptr) { }
+
+    explicit _Skip_list_iterator(const node_type *x) noexcept : _node(x) { }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_valptr();
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _node->_valptr();
+    }
+
+    _Skip_list_iterator &
+    operator++() noexcept
+    {
+        _node = _S_skip(_node->_load_next(0));
+        return *this;
+    }
+
+    _Skip_list_iterator
+    operator++(int) noexcept
+    {
+        _Skip_list_iterator tmp = *this;
+        _node                   = _S_skip(_node->_load_next(0));
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Skip_list_iterator &lhs,
+               const _Skip_list_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+
+    /**
+     * @brief Returns the first node from @a x on that is fully linked and not
+     * removed, or null.
+     */
+    static const node_type *
+    _S_skip(const node_type *x) noexcept
+    {
+        while (x != nullptr && (!x->_linked.load(std::memory_order_acquire) ||
+                                x->_marked.load(std::memory_order_acquire)))
+            x = x->_load_next(0);
+        return x;
+    }
+};
+
+/**
+ * @brief An ordered map of unique keys that supports concurrent insertions,
+ * removals, lookups and iterations without a global lock.
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Tp      Type of the mapped values.
+ * @tparam _Compare Strict weak ordering of the keys.
+ * @tparam _Alloc   User-defined allocator for the blocks of nodes.
+ *
+ * This is a lazy skip list: each node has a random height, with 1 / 4 of the
+ * nodes of a level also present on the level above, and a search goes down
+ * the levels in O(log n) expected steps. Searches and iterations take no lock
+ * at all. An insertion or a removal locks the few predecessors of the node at
+ * each of its levels, checks that they are still linked as observed, and
+ * retries otherwise, so threads working on different parts of the map do not
+ * contend. A removal first marks the node under its lock, which is the point
+ * where the element disappears for every reader.
+ *
+ * The mapped values are never modified by the map: use an atomic type or a
+ * removal followed by an insertion to update them.
+ *
+ * Nodes are carved out of large blocks with an atomic bump pointer. Removed
+ * nodes might still be visited by concurrent readers, so they are retired
+ * rather than freed. collect() destroys the retired elements and recycles
+ * their nodes for later insertions; it must be called while no other thread
+ * uses the map, e.g. between two phases of a batch job. Without it the memory
+ * of removed elements is only given back when the map is destroyed.
+ */
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<std::pair<const _Key, _Tp>>>
+class concurrent_skip_list
+{
+public:
+    using key_type        = _Key;
+    using mapped_type     = _Tp;
+    using value_type      = std::pair<const _Key, _Tp>;
+    using key_compare     = _Compare;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_iterator  = _Skip_list_iterator<value_type>;
+    using iterator        = const_iterator;
+
+private:
+    using _Node      = _Skip_list_node<value_type>;
+    using _Node_ptr  = _Node *;
+    using _Const_ptr = const _Node *;
+
+    // Blocks are allocated in units aligned for any node
+    struct alignas(alignof(_Node)) _Unit
+    {
+        unsigned char _bytes[alignof(_Node)];
+    };
+
+    struct _Block
+    {
+        _Block *_next;
+        std::size_t _units;
+        std::atomic<std::size_t> _used;
+    };
+
+    using _Unit_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Unit>;
+    using _Unit_alloc_traits = std::allocator_traits<_Unit_alloc_type>;
+
+    constexpr static unsigned char _S_max_height = 24;
+
+    constexpr static std::size_t _S_block_units =
+        (std::size_t(1) << 16) / sizeof(_Unit);
+
+    constexpr static std::size_t _S_header_units =
+        (sizeof(_Block) + sizeof(_Unit) - 1) / sizeof(_Unit);
+
+public:
+    /**
+     * @brief Creates an empty %concurrent_skip_list.
+     */
+    concurrent_skip_list() : concurrent_skip_list(_Compare()) { }
+
+    /**
+     * @brief Creates an empty %concurrent_skip_list with a given comparison
+     * object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit concurrent_skip_list(const _Compare &comp,
+                                  const _Alloc &alloc = _Alloc())
+    : _comp(comp), _alloc(alloc), _blocks(nullptr), _current(nullptr),
+      _head(nullptr), _retired(nullptr), _spoiled(nullptr), _count(0)
+    {
+        for (std::atomic<_Node_ptr> &list : _free)
+            list.store(nullptr, std::memory_order_relaxed);
+
+        _head = ::new (_allocate_bytes(_Node::_S_size(_S_max_height)))
+            _Node(_S_max_height);
+    }
+
+    concurrent_skip_list(const concurrent_skip_list &other) = delete;
+
+    concurrent_skip_list &
+    operator=(const concurrent_skip_list &other) = delete;
+
+    ~concurrent_skip_list()
+    {
+        for (_Node_ptr x = _head->_load_next(0); x != nullptr;
+             x           = x->_load_next(0))
+            std::destroy_at(x->_valptr());
+        _destroy_retired();
+
+        while (_blocks != nullptr)
+        {
+            _Block *next = _blocks->_next;
+            _Unit_alloc_traits::deallocate(_alloc,
+                                           reinterpret_cast<_Unit *>(_blocks),
+                                           _blocks->_units);
+            _blocks = next;
+        }
+    }
+
+    // Iterators
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(const_iterator::_S_skip(_head->_load_next(0)));
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns the number of elements, which might be outdated by the
+     * time it is used if other threads modify the map.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts @a x unless an equivalent key is present, and returns
+     * whether the insertion took place.
+     */
+    bool
+    insert(const value_type &x)
+    {
+        return try_emplace(x.first, x.second);
+    }
+
+    bool
+    insert(value_type &&x)
+    {
+        return try_emplace(x.first, std::move(x.second));
+    }
+
+    /**
+     * @brief Inserts an element with key @a k and a value constructed from
+     * @a args, unless the key is present, and returns whether the insertion
+     * took place.
+     */
+    template <typename... Args>
+    bool
+    try_emplace(const key_type &k, Args &&...args)
+    {
+        _Node_ptr preds[_S_max_height];
+        _Node_ptr succs[_S_max_height];
+
+        if (_find_present(k) != nullptr)
+            return false;
+
+        const unsigned char height = _random_height();
+        _Node_ptr z                = _create_node(height, k,
+                                                  std::forward<Args>(args)...);
+
+        while (true)
+        {
+            const int found = _find(k, preds, succs);
+            if (found >= 0)
+            {
+                _Node_ptr x = succs[found];
+                if (!x->_marked.load(std::memory_order_acquire))
+                {
+                    // Another thread is inserting the same key
+                    while (!x->_linked.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    _retire(z);
+                    return false;
+                }
+                continue;
+            }
+
+            // Lock the predecessors, then check that they are still present
+            // and followed by the observed successors
+            int locked     = -1;
+            bool valid     = true;
+            _Node_ptr prev = nullptr;
+            for (int level = 0; valid && level < height; level++)
+            {
+                _Node_ptr pred = preds[level];
+                _Node_ptr succ = succs[level];
+                if (pred != prev)
+                {
+                    pred->_lock.lock();
+                    locked = level;
+                    prev   = pred;
+                }
+                valid = !pred->_marked.load(std::memory_order_acquire) &&
+                        (succ == nullptr ||
+                         !succ->_marked.load(std::memory_order_acquire)) &&
+                        pred->_load_next(level) == succ;
+            }
+
+            if (valid)
+            {
+                for (int level = 0; level < height; level++)
+                    z->_next()[level].store(succs[level],
+                                            std::memory_order_relaxed);
+                for (int level = 0; level < height; level++)
+                    preds[level]->_next()[level].store(
+                        z, std::memory_order_release);
+                z->_linked.store(true, std::memory_order_release);
+                _count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            _unlock(preds, locked);
+            if (valid)
+                return true;
+        }
+    }
+
+    /**
+     * @brief Removes the element with key @a k, if present, and returns the
+     * number of removed elements.
+     *
+     * The element is retired rather than destroyed, see collect().
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        _Node_ptr preds[_S_max_height];
+        _Node_ptr succs[_S_max_height];
+        _Node_ptr victim = nullptr;
+
+        while (true)
+        {
+            const int found = _find(k, preds, succs);
+
+            if (victim == nullptr)
+            {
+                // Only a node fully linked at the level where it was found is
+                // ready to be removed
+                if (found < 0)
+                    return 0;
+                _Node_ptr x = succs[found];
+                if (!x->_linked.load(std::memory_order_acquire) ||
+                    x->_height != found + 1 ||
+                    x->_marked.load(std::memory_order_acquire))
+                    return 0;
+
+                x->_lock.lock();
+                if (x->_marked.load(std::memory_order_relaxed))
+                {
+                    x->_lock.unlock();
+                    return 0;
+                }
+                x->_marked.store(true, std::memory_order_release);
+                victim = x;
+            }
+
+            int locked     = -1;
+            bool valid     = true;
+            _Node_ptr prev = nullptr;
+            for (int level = 0; valid && level < victim->_height; level++)
+            {
+                _Node_ptr pred = preds[level];
+                if (pred != prev)
+                {
+                    pred->_lock.lock();
+                    locked = level;
+                    prev   = pred;
+                }
+                valid = !pred->_marked.load(std::memory_order_acquire) &&
+                        pred->_load_next(level) == victim;
+            }
+
+            if (valid)
+            {
+                for (int level = victim->_height - 1; level >= 0; level--)
+                    preds[level]->_next()[level].store(
+                        victim->_load_next(level), std::memory_order_release);
+                victim->_lock.unlock();
+                _count.fetch_sub(1, std::memory_order_relaxed);
+                _retire(victim);
+            }
+
+            _unlock(preds, locked);
+            if (valid)
+                return 1;
+        }
+    }
+
+    /**
+     * @brief Destroys the removed elements and recycles their nodes.
+     *
+     * No other thread may use the map during the call, nor hold an iterator
+     * to a removed element.
+     */
+    void
+    collect() noexcept
+    {
+        _Node_ptr x = _retired.exchange(nullptr, std::memory_order_acquire);
+        while (x != nullptr)
+        {
+            _Node_ptr next = x->_link.load(std::memory_order_relaxed);
+            std::destroy_at(x->_valptr());
+            _recycle(x);
+            x = next;
+        }
+
+        x = _spoiled.exchange(nullptr, std::memory_order_acquire);
+        while (x != nullptr)
+        {
+            _Node_ptr next = x->_link.load(std::memory_order_relaxed);
+            _recycle(x);
+            x = next;
+        }
+    }
+
+    // Lookup
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        return const_iterator(_find_present(k));
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _find_present(k) != nullptr;
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the first element whose key is not less than @a k.
+     */
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        _Const_ptr pred = _head;
+        for (int level = _S_max_height - 1; level >= 0; level--)
+        {
+            _Const_ptr x = pred->_load_next(level);
+            while (x != nullptr && _comp(_S_key(x), k))
+            {
+                pred = x;
+                x    = x->_load_next(level);
+            }
+        }
+        return const_iterator(const_iterator::_S_skip(pred->_load_next(0)));
+    }
+
+private:
+    _Compare _comp;
+    _Unit_alloc_type _alloc;
+    _Block *_blocks; // Every block, linked under _grow_mutex
+    std::atomic<_Block *> _current;
+    std::mutex _grow_mutex;
+    _Node_ptr _head;
+    std::atomic<_Node_ptr> _retired;
+    std::atomic<_Node_ptr> _spoiled; // Nodes whose value failed to construct
+    std::atomic<_Node_ptr> _free[_S_max_height]; // Recycled nodes per height
+    std::atomic<size_type> _count;
+
+    static const key_type &
+    _S_key(_Const_ptr x) noexcept
+    {
+        return x->_valptr()->first;
+    }
+
+    /**
+     * Draws the height of a new node: h with probability 3 / 4^h.
+     */
+    static unsigned char
+    _random_height() noexcept
+    {
+        thread_local std::uint64_t state =
+            std::hash<std::thread::id>()(std::this_thread::get_id()) |
+            std::uint64_t(1);
+
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        const int zeros = std::countr_zero(state | (std::uint64_t(1) << 62));
+        return static_cast<unsigned char>(
+            std::min<int>(1 + zeros / 2, _S_max_height));
+    }
+
+    /**
+     * Fills @a preds and @a succs with the last node before @a k and the
+     * first node from @a k on at every level, and returns the highest level
+     * where a node with key @a k was found, or -1.
+     */
+    int
+    _find(const key_type &k, _Node_ptr *preds, _Node_ptr *succs) const
+    {
+        int found      = -1;
+        _Node_ptr pred = _head;
+
+        for (int level = _S_max_height - 1; level >= 0; level--)
+        {
+            _Node_ptr x = pred->_load_next(level);
+            while (x != nullptr && _comp(_S_key(x), k))
+            {
+                pred = x;
+                x    = x->_load_next(level);
+            }
+
+            if (found < 0 && x != nullptr && !_comp(k, _S_key(x)))
+                found = level;
+            preds[level] = pred;
+            succs[level] = x;
+        }
+
+        return found;
+    }
+
+    /**
+     * Returns the node with key @a k if it is present, or null.
+     */
+    _Const_ptr
+    _find_present(const key_type &k) const
+    {
+        _Const_ptr pred = _head;
+        for (int level = _S_max_height - 1; level >= 0; level--)
+        {
+            _Const_ptr x = pred->_load_next(level);
+            while (x != nullptr && _comp(_S_key(x), k))
+            {
+                pred = x;
+                x    = x->_load_next(level);
+            }
+
+            if (x != nullptr && !_comp(k, _S_key(x)))
+            {
+                if (x->_linked.load(std::memory_order_acquire) &&
+                    !x->_marked.load(std::memory_order_acquire))
+                    return x;
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Unlocks the distinct predecessors locked on levels 0 to @a locked.
+     */
+    static void
+    _unlock(_Node_ptr *preds, int locked) noexcept
+    {
+        _Node_ptr prev = nullptr;
+        for (int level = 0; level <= locked; level++)
+        {
+            if (preds[level] != prev)
+            {
+                preds[level]->_lock.unlock();
+                prev = preds[level];
+            }
+        }
+    }
+
+    /**
+     * Pushes a node, whose value is still alive, to the retired list.
+     */
+    void
+    _retire(_Node_ptr x) noexcept
+    {
+        _S_push(_retired, x);
+    }
+
+    static void
+    _S_push(std::atomic<_Node_ptr> &list, _Node_ptr x) noexcept
+    {
+        _Node_ptr head = list.load(std::memory_order_relaxed);
+        do
+            x->_link.store(head, std::memory_order_relaxed);
+        while (!list.compare_exchange_weak(head, x, std::memory_order_release,
+                                           std::memory_order_relaxed));
+    }
+
+    /**
+     * Pushes a node without a value to the free list of its height. Only
+     * called by collect().
+     */
+    void
+    _recycle(_Node_ptr x) noexcept
+    {
+        std::atomic<_Node_ptr> &list = _free[x->_height - 1];
+        x->_link.store(list.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+        list.store(x, std::memory_order_relaxed);
+    }
+
+    void
+    _destroy_retired() noexcept
+    {
+        _Node_ptr x = _retired.load(std::memory_order_acquire);
+        for (; x != nullptr; x = x->_link.load(std::memory_order_relaxed))
+            std::destroy_at(x->_valptr());
+    }
+
+    template <typename... Args>
+    _Node_ptr
+    _create_node(unsigned char height, const key_type &k, Args &&...args)
+    {
+        _Node_ptr z = _allocate_node(height);
+
+        try
+        {
+            std::construct_at(z->_valptr(), std::piecewise_construct,
+                              std::forward_as_tuple(k),
+                              std::forward_as_tuple(
+                                  std::forward<Args>(args)...));
+        }
+        catch (...)
+        {
+            // Only collect() may push to the free lists, which takes the
+            // node back from the spoiled list
+            _S_push(_spoiled, z);
+            throw;
+        }
+
+        return z;
+    }
+
+    /**
+     * Returns an empty node of height @a height, either recycled by collect()
+     * or carved from the current block.
+     *
+     * The free lists are only pushed to by collect(), while no other thread
+     * runs, so concurrent pops cannot suffer from the ABA problem. A thread
+     * that lost the race for a node might still read its @a _link, so a
+     * recycled node is reset with atomic stores rather than constructed
+     * again.
+     */
+    _Node_ptr
+    _allocate_node(unsigned char height)
+    {
+        std::atomic<_Node_ptr> &list = _free[height - 1];
+        _Node_ptr x                  = list.load(std::memory_order_acquire);
+        while (x != nullptr &&
+               !list.compare_exchange_weak(
+                   x, x->_link.load(std::memory_order_relaxed),
+                   std::memory_order_acquire, std::memory_order_acquire))
+        {
+        }
+
+        if (x == nullptr)
+            return ::new (_allocate_bytes(_Node::_S_size(height)))
+                _Node(height);
+
+        x->_link.store(nullptr, std::memory_order_relaxed);
+        x->_marked.store(false, std::memory_order_relaxed);
+        x->_linked.store(false, std::memory_order_relaxed);
+        for (unsigned char i = 0; i < height; i++)
+            x->_next()[i].store(nullptr, std::memory_order_relaxed);
+        return x;
+    }
+
+    /**
+     * Bumps the offset of the current block with an atomic increment, and
+     * only locks to install a new block once the current one is full.
+     */
+    void *
+    _allocate_bytes(std::size_t bytes)
+    {
+        const std::size_t units = (bytes + sizeof(_Unit) - 1) / sizeof(_Unit);
+
+        while (true)
+        {
+            _Block *block = _current.load(std::memory_order_acquire);
+            if (block != nullptr)
+            {
+                const std::size_t used =
+                    block->_used.fetch_add(units, std::memory_order_relaxed);
+                if (used + units <= block->_units)
+                    return reinterpret_cast<_Unit *>(block) + used;
+            }
+
+            std::lock_guard<std::mutex> guard(_grow_mutex);
+            if (_current.load(std::memory_order_relaxed) == block)
+            {
+                const std::size_t n =
+                    std::max(_S_block_units, _S_header_units + units);
+                _Block *next = reinterpret_cast<_Block *>(
+                    _Unit_alloc_traits::allocate(_alloc, n));
+                ::new (static_cast<void *>(next)) _Block{_blocks, n, {}};
+                next->_used.store(_S_header_units, std::memory_order_relaxed);
+                _blocks = next;
+                _current.store(next, std::memory_order_release);
+            }
+        }
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_CONCURRENT_SKIP_LIST_H */
@@ -0,0 +1,533 @@
+/**
+ * @file flat_hash_map.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An unordered associative container of key/value pairs stored inline
+ * in an open-addressing hash table
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_FLAT_HASH_MAP_H
+#define __OPENDSA_FLAT_HASH_MAP_H 1
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "flat_hash_table.h"
+#include "helper.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A hash map of unique keys whose elements live in the table itself
+ *
+ * @tparam _Key   Type of the keys.
+ * @tparam _Tp    Type of the mapped values.
+ * @tparam _Hash  Hash function of the keys.
+ * @tparam _Equal Equality of the keys.
+ * @tparam _Alloc User-defined allocator.
+ *
+ * A flat_hash_map is an adapter over a _Flat_hash_table whose values are
+ * std::pair<const _Key, _Tp>. It has most of the interface of
+ * std::unordered_map, but the pairs are stored in the slots of the table
+ * rather than in a node each, so a lookup reads a group of control bytes
+ * and, almost always, a single slot, with no pointer to follow.
+ *
+ * Growing the table moves the pairs, so an insertion may invalidate all
+ * iterators and references, unless reserve() made room for it beforehand.
+ * An erasure only invalidates the ones to the erased element.
+ */
+template <typename _Key, typename _Tp, typename _Hash = std::hash<_Key>,
+          typename _Equal = std::equal_to<_Key>,
+          typename _Alloc = std::allocator<std::pair<const _Key, _Tp>>>
+class flat_hash_map
+{
+public:
+    using key_type    = _Key;
+    using mapped_type = _Tp;
+    using value_type  = std::pair<const _Key, _Tp>;
+
+private:
+    using _Table_type =
+        _Flat_hash_table<_Key, value_type, _Select_first, _Hash, _Equal,
+                         _Alloc>;
+
+public:
+    using hasher          = _Hash;
+    using key_equal       = _Equal;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = typename _Table_type::size_type;
+    using difference_type = typename _Table_type::difference_type;
+    using iterator        = typename _Table_type::iterator;
+    using const_iterator  = typename _Table_type::const_iterator;
+
+    /**
+     * @brief Creates an empty %flat_hash_map, which allocates nothing.
+     */
+    flat_hash_map() : _table() { }
+
+    /**
+     * @brief Creates an empty %flat_hash_map with room for @a n elements.
+     *
+     * @param n     Number of elements to reserve room for.
+     * @param hash  Hash function.
+     * @param eq    Equality of the keys.
+     * @param alloc Allocator object.
+     */
+    explicit flat_hash_map(size_type n, const _Hash &hash = _Hash(),
+                           const _Equal &eq    = _Equal(),
+                           const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates an empty %flat_hash_map with a given allocator.
+     */
+    explicit flat_hash_map(const _Alloc &alloc)
+    : _table(0, _Hash(), _Equal(), alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %flat_hash_map based on a range of elements.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     *
+     * If several elements have equal keys, only the first one is kept.
+     */
+    template <std::input_iterator _InputIter>
+    flat_hash_map(_InputIter first, _InputIter last, size_type n = 0,
+                  const _Hash &hash   = _Hash(),
+                  const _Equal &eq    = _Equal(),
+                  const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %flat_hash_map based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    flat_hash_map(std::initializer_list<value_type> list, size_type n = 0,
+                  const _Hash &hash   = _Hash(),
+                  const _Equal &eq    = _Equal(),
+                  const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    flat_hash_map(const flat_hash_map &other) = default;
+
+    flat_hash_map(flat_hash_map &&other) noexcept = default;
+
+    flat_hash_map &
+    operator=(const flat_hash_map &other) = default;
+
+    flat_hash_map &
+    operator=(flat_hash_map &&other) = default;
+
+    flat_hash_map &
+    operator=(std::initializer_list<value_type> list)
+    {
+        _table.clear();
+        insert(list.begin(), list.end());
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _table.get_allocator();
+    }
+
+    // Element access
+
+    /**
+     * @brief Returns a reference to the value mapped to @a k.
+     *
+     * Throws std::out_of_range if no element has the key @a k.
+     */
+    mapped_type &
+    at(const key_type &k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("flat_hash_map::at: key not found");
+
+        return it->second;
+    }
+
+    const mapped_type &
+    at(const key_type &k) const
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("flat_hash_map::at: key not found");
+
+        return it->second;
+    }
+
+    /**
+     * @brief Returns a reference to the value mapped to @a k, inserting a
+     * default constructed value if no element has the key @a k.
+     */
+    mapped_type &
+    operator[](const key_type &k)
+    {
+        return try_emplace(k).first->second;
+    }
+
+    mapped_type &
+    operator[](key_type &&k)
+    {
+        return try_emplace(std::move(k)).first->second;
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return _table.begin();
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    iterator
+    end() noexcept
+    {
+        return _table.end();
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return _table.end();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return _table.end();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %flat_hash_map is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the %flat_hash_map.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _table.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Removes every element of the %flat_hash_map, and keeps its
+     * slots for the next ones.
+     */
+    void
+    clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief Inserts a key/value pair unless the key already exists.
+     *
+     * @param x Pair to be inserted.
+     *
+     * Returns an iterator to the element with the key of @a x, and whether
+     * the insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        return _table._insert_unique(x);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        return _table._insert_unique(std::move(x));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last).
+     */
+    template <typename _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            _table._insert_unique(*first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Inserts a new element or assigns to the existing one.
+     */
+    template <typename _Obj>
+    std::pair<iterator, bool>
+    insert_or_assign(const key_type &k, _Obj &&obj)
+    {
+        std::pair<iterator, bool> res = try_emplace(k, std::forward<_Obj>(obj));
+        if (!res.second)
+            res.first->second = std::forward<_Obj>(obj);
+
+        return res;
+    }
+
+    /**
+     * @brief Constructs a new element in place unless the key already
+     * exists.
+     *
+     * @param args Argument list to construct a value_type.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        return _table._emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs the mapped value in place if @a k doesn't exist yet.
+     *
+     * Unlike emplace(), nothing is constructed when the key already exists,
+     * and the pair is constructed right in its slot.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(const key_type &k, Args &&...args)
+    {
+        return _table._emplace_key(
+            k, std::piecewise_construct, std::forward_as_tuple(k),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(key_type &&k, Args &&...args)
+    {
+        return _table._emplace_key(
+            k, std::piecewise_construct, std::forward_as_tuple(std::move(k)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    iterator
+    erase(iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the element with the key @a k, if any.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        return _table.erase(k);
+    }
+
+    /**
+     * @brief Swaps the content between two flat_hash_maps in constant time.
+     */
+    void
+    swap(flat_hash_map &other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // Lookup
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _table.count(k);
+    }
+
+    iterator
+    find(const key_type &k)
+    {
+        return _table.find(k);
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        return _table.find(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _table.contains(k);
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k)
+    {
+        iterator it = find(k);
+        return {it, it == end() ? it : std::next(it)};
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &k) const
+    {
+        const_iterator it = find(k);
+        return {it, it == end() ? it : std::next(it)};
+    }
+
+    // Hash policy
+
+    /**
+     * @brief Returns the number of slots of the table.
+     */
+    size_type
+    bucket_count() const noexcept
+    {
+        return _table.bucket_count();
+    }
+
+    float
+    load_factor() const noexcept
+    {
+        return _table.load_factor();
+    }
+
+    /**
+     * @brief Returns the load factor the table grows at, which is fixed.
+     */
+    float
+    max_load_factor() const noexcept
+    {
+        return _table.max_load_factor();
+    }
+
+    /**
+     * @brief Rebuilds the table with at least @a n slots, and enough for its
+     * elements.
+     *
+     * Rehashing also drops the slots left by erased elements. With
+     * @a n = 0, an empty %flat_hash_map frees its memory.
+     */
+    void
+    rehash(size_type n)
+    {
+        _table.rehash(n);
+    }
+
+    /**
+     * @brief Makes room for @a n elements, so that the table does not grow,
+     * and no iterator is invalidated, until it holds more.
+     */
+    void
+    reserve(size_type n)
+    {
+        _table.reserve(n);
+    }
+
+    // Observers
+
+    hasher
+    hash_function() const
+    {
+        return _table.hash_function();
+    }
+
+    key_equal
+    key_eq() const
+    {
+        return _table.key_eq();
+    }
+
+    friend bool
+    operator==(const flat_hash_map &lhs, const flat_hash_map &rhs)
+    {
+        return lhs._table == rhs._table;
+    }
+
+    friend bool
+    operator!=(const flat_hash_map &lhs, const flat_hash_map &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    _Table_type _table;
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_FLAT_HASH_MAP_H */
@@ -0,0 +1,402 @@
+/**
+ * @file flat_hash_set.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An unordered associative container of unique keys stored inline in
+ * an open-addressing hash table
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_FLAT_HASH_SET_H
+#define __OPENDSA_FLAT_HASH_SET_H 1
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "flat_hash_table.h"
+#include "helper.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A hash set of unique keys whose elements live in the table itself
+ *
+ * @tparam _Key   Type of the keys.
+ * @tparam _Hash  Hash function of the keys.
+ * @tparam _Equal Equality of the keys.
+ * @tparam _Alloc User-defined allocator.
+ *
+ * A flat_hash_set is an adapter over a _Flat_hash_table whose values are
+ * their own keys. It has most of the interface of std::unordered_set, with
+ * the keys stored in the slots of the table, see opendsa::flat_hash_map.
+ *
+ * Growing the table moves the keys, so an insertion may invalidate all
+ * iterators and references, unless reserve() made room for it beforehand.
+ */
+template <typename _Key, typename _Hash = std::hash<_Key>,
+          typename _Equal = std::equal_to<_Key>,
+          typename _Alloc = std::allocator<_Key>>
+class flat_hash_set
+{
+private:
+    using _Table_type =
+        _Flat_hash_table<_Key, _Key, _Identity, _Hash, _Equal, _Alloc>;
+
+public:
+    using key_type        = _Key;
+    using value_type      = _Key;
+    using hasher          = _Hash;
+    using key_equal       = _Equal;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = typename _Table_type::size_type;
+    using difference_type = typename _Table_type::difference_type;
+    using iterator        = typename _Table_type::const_iterator;
+    using const_iterator  = typename _Table_type::const_iterator;
+
+    /**
+     * @brief Creates an empty %flat_hash_set, which allocates nothing.
+     */
+    flat_hash_set() : _table() { }
+
+    /**
+     * @brief Creates an empty %flat_hash_set with room for @a n elements.
+     *
+     * @param n     Number of elements to reserve room for.
+     * @param hash  Hash function.
+     * @param eq    Equality of the keys.
+     * @param alloc Allocator object.
+     */
+    explicit flat_hash_set(size_type n, const _Hash &hash = _Hash(),
+                           const _Equal &eq    = _Equal(),
+                           const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates an empty %flat_hash_set with a given allocator.
+     */
+    explicit flat_hash_set(const _Alloc &alloc)
+    : _table(0, _Hash(), _Equal(), alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %flat_hash_set based on a range of elements.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     *
+     * Duplicated keys are only inserted once.
+     */
+    template <std::input_iterator _InputIter>
+    flat_hash_set(_InputIter first, _InputIter last, size_type n = 0,
+                  const _Hash &hash   = _Hash(),
+                  const _Equal &eq    = _Equal(),
+                  const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %flat_hash_set based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    flat_hash_set(std::initializer_list<value_type> list, size_type n = 0,
+                  const _Hash &hash   = _Hash(),
+                  const _Equal &eq    = _Equal(),
+                  const _Alloc &alloc = _Alloc())
+    : _table(n, hash, eq, alloc)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    flat_hash_set(const flat_hash_set &other) = default;
+
+    flat_hash_set(flat_hash_set &&other) noexcept = default;
+
+    flat_hash_set &
+    operator=(const flat_hash_set &other) = default;
+
+    flat_hash_set &
+    operator=(flat_hash_set &&other) = default;
+
+    flat_hash_set &
+    operator=(std::initializer_list<value_type> list)
+    {
+        _table.clear();
+        insert(list.begin(), list.end());
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _table.get_allocator();
+    }
+
+    // Iterators
+
+    iterator
+    begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    iterator
+    end() const noexcept
+    {
+        return _table.end();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return _table.end();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %flat_hash_set is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the %flat_hash_set.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _table.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Removes every element of the %flat_hash_set, and keeps its
+     * slots for the next ones.
+     */
+    void
+    clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief Inserts a key unless it already exists.
+     *
+     * @param x Key to be inserted.
+     *
+     * Returns an iterator to the element equal to @a x, and whether the
+     * insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        return _table._insert_unique(x);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        return _table._insert_unique(std::move(x));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last).
+     */
+    template <typename _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            _table._insert_unique(*first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Constructs a new key in place unless it already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        return _table._emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the key @a k, if present.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        return _table.erase(k);
+    }
+
+    /**
+     * @brief Swaps the content between two flat_hash_sets in constant time.
+     */
+    void
+    swap(flat_hash_set &other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // Lookup
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _table.count(k);
+    }
+
+    iterator
+    find(const key_type &k) const
+    {
+        return _table.find(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _table.contains(k);
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k) const
+    {
+        iterator it = find(k);
+        return {it, it == end() ? it : std::next(it)};
+    }
+
+    // Hash policy
+
+    /**
+     * @brief Returns the number of slots of the table.
+     */
+    size_type
+    bucket_count() const noexcept
+    {
+        return _table.bucket_count();
+    }
+
+    float
+    load_factor() const noexcept
+    {
+        return _table.load_factor();
+    }
+
+    float
+    max_load_factor() const noexcept
+    {
+        return _table.max_load_factor();
+    }
+
+    /**
+     * @brief Rebuilds the table with at least @a n slots, and enough for its
+     * elements. See flat_hash_map::rehash().
+     */
+    void
+    rehash(size_type n)
+    {
+        _table.rehash(n);
+    }
+
+    /**
+     * @brief Makes room for @a n elements, so that the table does not grow
+     * until it holds more.
+     */
+    void
+    reserve(size_type n)
+    {
+        _table.reserve(n);
+    }
+
+    // Observers
+
+    hasher
+    hash_function() const
+    {
+        return _table.hash_function();
+    }
+
+    key_equal
+    key_eq() const
+    {
+        return _table.key_eq();
+    }
+
+    friend bool
+    operator==(const flat_hash_set &lhs, const flat_hash_set &rhs)
+    {
+        return lhs._table == rhs._table;
+    }
+
+    friend bool
+    operator!=(const flat_hash_set &lhs, const flat_hash_set &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    _Table_type _table;
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_FLAT_HASH_SET_H */
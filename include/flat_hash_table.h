@@ -0,0 +1,1174 @@
+/**
+ * @file flat_hash_table.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An open-addressing hash table probed a group of slots at a time
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_FLAT_HASH_TABLE_H
+#define __OPENDSA_FLAT_HASH_TABLE_H 1
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#define __OPENDSA_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace opendsa
+{
+
+/**
+ * @brief The control byte of a slot of a _Flat_hash_table.
+ *
+ * A full slot has the 7 low bits of the hash of its key, a value in
+ * [0, 127], and the other states are negative, so that a slot is full iff
+ * the sign bit of its control byte is clear.
+ */
+using _Flat_hash_ctrl = signed char;
+
+constexpr _Flat_hash_ctrl _Flat_hash_empty    = -128; // 0b10000000
+constexpr _Flat_hash_ctrl _Flat_hash_deleted  = -2;   // 0b11111110
+constexpr _Flat_hash_ctrl _Flat_hash_sentinel = -1;   // 0b11111111
+
+/**
+ * @brief The positions of the slots of a group that match a query, lowest
+ * first.
+ *
+ * @tparam _Word  Unsigned integer with a bit per slot, or a byte per slot
+ * @tparam _Shift log2 of the number of bits per slot
+ */
+template <typename _Word, int _Shift>
+struct _Flat_hash_mask
+{
+    _Word _bits;
+
+    explicit operator bool() const noexcept { return _bits != 0; }
+
+    std::size_t
+    lowest() const noexcept
+    {
+        return std::countr_zero(_bits) >> _Shift;
+    }
+
+    void
+    pop() noexcept
+    {
+        _bits &= _bits - 1;
+    }
+
+    /**
+     * @brief Returns the number of slots before the first match.
+     */
+    std::size_t
+    trailing_zeros() const noexcept
+    {
+        return std::countr_zero(_bits) >> _Shift;
+    }
+
+    /**
+     * @brief Returns the number of slots after the last match.
+     */
+    std::size_t
+    leading_zeros() const noexcept
+    {
+        return std::countl_zero(_bits) >> _Shift;
+    }
+};
+
+#if defined(__OPENDSA_FLAT_HASH_SSE2)
+
+/**
+ * @brief The control bytes of 16 consecutive slots, compared to a query in
+ * a couple of SSE2 instructions.
+ */
+struct _Flat_hash_group
+{
+    using mask_type = _Flat_hash_mask<std::uint16_t, 0>;
+
+    constexpr static std::size_t width = 16;
+
+    __m128i _ctrl;
+
+    explicit _Flat_hash_group(const _Flat_hash_ctrl *p) noexcept
+    : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))
+    {
+    }
+
+    /**
+     * @brief Returns the full slots whose control byte is @a h2.
+     */
+    mask_type
+    match(_Flat_hash_ctrl h2) const noexcept
+    {
+        return _S_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl));
+    }
+
+    mask_type
+    match_empty() const noexcept
+    {
+        return _S_mask(_mm_cmpeq_epi8(_mm_set1_epi8(_Flat_hash_empty), _ctrl));
+    }
+
+    mask_type
+    match_empty_or_deleted() const noexcept
+    {
+        return _S_mask(
+            _mm_cmpgt_epi8(_mm_set1_epi8(_Flat_hash_sentinel), _ctrl));
+    }
+
+    /**
+     * @brief Returns the number of empty or deleted slots the group starts
+     * with, i.e. how far an iterator skips.
+     */
+    std::size_t
+    count_leading_empty_or_deleted() const noexcept
+    {
+        return _S_mask(_mm_cmpgt_epi8(_ctrl,
+                                      _mm_set1_epi8(_Flat_hash_deleted)))
+            .trailing_zeros();
+    }
+
+private:
+    static mask_type
+    _S_mask(__m128i bytes) noexcept
+    {
+        return {static_cast<std::uint16_t>(_mm_movemask_epi8(bytes))};
+    }
+};
+
+#else
+
+/**
+ * @brief The control bytes of 8 consecutive slots, compared to a query
+ * with arithmetic on a 64-bit word, where the result for a slot is the high
+ * bit of its byte.
+ *
+ * match() may report a false positive for a slot that follows a real match,
+ * which only costs a comparison of keys.
+ */
+struct _Flat_hash_group
+{
+    using mask_type = _Flat_hash_mask<std::uint64_t, 3>;
+
+    constexpr static std::size_t width = 8;
+
+    constexpr static std::uint64_t _S_lsbs = 0x0101010101010101;
+    constexpr static std::uint64_t _S_msbs = 0x8080808080808080;
+
+    std::uint64_t _ctrl;
+
+    explicit _Flat_hash_group(const _Flat_hash_ctrl *p) noexcept : _ctrl(0)
+    {
+        for (std::size_t i = 0; i < width; i++)
+            _ctrl |= std::uint64_t(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+
+    mask_type
+    match(_Flat_hash_ctrl h2) const noexcept
+    {
+        const std::uint64_t x =
+            _ctrl ^ (_S_lsbs * static_cast<unsigned char>(h2));
+        return {(x - _S_lsbs) & ~x & _S_msbs};
+    }
+
+    // Only the empty byte has its high bit set and bit 1 clear
+    mask_type
+    match_empty() const noexcept
+    {
+        return {_ctrl & ~(_ctrl << 6) & _S_msbs};
+    }
+
+    // The sentinel is the only byte with its high bit set and bit 0 set
+    mask_type
+    match_empty_or_deleted() const noexcept
+    {
+        return {_ctrl & ~(_ctrl << 7) & _S_msbs};
+    }
+
+    std::size_t
+    count_leading_empty_or_deleted() const noexcept
+    {
+        return mask_type{~(_ctrl & ~(_ctrl << 7)) & _S_msbs}.trailing_zeros();
+    }
+};
+
+#endif
+
+/**
+ * @brief The control bytes of a table without slots: a sentinel, followed
+ * by empty bytes for the group read at it. It is never written to.
+ */
+alignas(16) inline const _Flat_hash_ctrl _Flat_hash_empty_group[16] = {
+    _Flat_hash_sentinel, _Flat_hash_empty, _Flat_hash_empty, _Flat_hash_empty,
+    _Flat_hash_empty,    _Flat_hash_empty, _Flat_hash_empty, _Flat_hash_empty,
+    _Flat_hash_empty,    _Flat_hash_empty, _Flat_hash_empty, _Flat_hash_empty,
+    _Flat_hash_empty,    _Flat_hash_empty, _Flat_hash_empty, _Flat_hash_empty};
+
+/**
+ * @brief Spreads the entropy of a hash over all of its bits.
+ *
+ * The table takes the position of a key from the high bits of its hash and
+ * the control byte from the 7 low ones, which std::hash leaves poor for
+ * integers, as it returns them unchanged.
+ */
+constexpr std::size_t
+_Flat_hash_mix(std::size_t h) noexcept
+{
+    std::uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccd;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+}
+
+/**
+ * @brief A forward iterator over the full slots of a _Flat_hash_table.
+ *
+ * It walks the control bytes along with the slots, and skips a group of
+ * empty or deleted slots at a time. The sentinel after the last slot stops
+ * it at the past-the-end position.
+ */
+template <typename _Val, bool _Const>
+struct _Flat_hash_iterator
+{
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = _Val;
+    using difference_type   = std::ptrdiff_t;
+    using pointer   = std::conditional_t<_Const, const _Val *, _Val *>;
+    using reference = std::conditional_t<_Const, const _Val &, _Val &>;
+
+    const _Flat_hash_ctrl *_ctrl = nullptr;
+    _Val *_slot                  = nullptr;
+
+    _Flat_hash_iterator() noexcept = default;
+
+    _Flat_hash_iterator(const _Flat_hash_ctrl *ctrl, _Val *slot) noexcept
+    : _ctrl(ctrl), _slot(slot)
+    {
+    }
+
+    /**
+     * @brief Converts a mutable iterator to a readonly one.
+     */
+    template <bool _OtherConst, typename = std::enable_if_t<
+                                    _Const && !_OtherConst>>
+    _Flat_hash_iterator(
+        const _Flat_hash_iterator<_Val, _OtherConst> &other) noexcept
+    : _ctrl(other._ctrl), _slot(other._slot)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_slot;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _slot;
+    }
+
+    _Flat_hash_iterator &
+    operator++() noexcept
+    {
+        ++_ctrl;
+        ++_slot;
+        _skip();
+        return *this;
+    }
+
+    _Flat_hash_iterator
+    operator++(int) noexcept
+    {
+        _Flat_hash_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    /**
+     * @brief Moves to the first full slot from the current one on, or to the
+     * sentinel.
+     */
+    void
+    _skip() noexcept
+    {
+        while (*_ctrl < _Flat_hash_sentinel)
+        {
+            const std::size_t n =
+                _Flat_hash_group(_ctrl).count_leading_empty_or_deleted();
+            _ctrl += n;
+            _slot += n;
+        }
+    }
+
+    friend bool
+    operator==(const _Flat_hash_iterator &lhs,
+               const _Flat_hash_iterator &rhs) noexcept
+    {
+        return lhs._ctrl == rhs._ctrl;
+    }
+
+    friend bool
+    operator!=(const _Flat_hash_iterator &lhs,
+               const _Flat_hash_iterator &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief A hash table of unique keys with open addressing
+ *
+ * @tparam _Key        Type of the keys.
+ * @tparam _Val        Type of the stored values.
+ * @tparam _KeyOfValue Function object extracting the key from a value.
+ * @tparam _Hash       Hash function of the keys.
+ * @tparam _Equal      Equality of the keys.
+ * @tparam _Alloc      User-defined allocator.
+ *
+ * This is the common implementation behind opendsa::flat_hash_map and
+ * opendsa::flat_hash_set, in the manner of a Swiss table. The values live
+ * in a single array of capacity 2^k - 1 slots, next to an array of control
+ * bytes, one per slot, that tells whether the slot is empty, deleted, or
+ * full, and then holds 7 bits of the hash of its key. A lookup starts at a
+ * position given by the other bits of the hash and compares the control
+ * bytes of a whole group of slots to these 7 bits at once, e.g. 16 with
+ * SSE2, so it only compares the keys of the slots that match, which are
+ * almost always the one it looks for. It stops at the first group with an
+ * empty slot, and otherwise moves to the next group by quadratic probing.
+ *
+ * The first group - 1 control bytes are cloned after the last one, so that
+ * a group read near the end of the array wraps around. The table grows to
+ * twice its capacity when it is 7/8 full, counting the deleted slots.
+ *
+ * Growing the table or rehashing it moves the values, which invalidates all
+ * iterators and references, while an erasure only invalidates the ones to
+ * the erased element. Values are moved as if their move constructor could
+ * not throw: if it does, std::terminate() is called.
+ */
+template <typename _Key, typename _Val, typename _KeyOfValue, typename _Hash,
+          typename _Equal, typename _Alloc = std::allocator<_Val>>
+class _Flat_hash_table
+{
+private:
+    using _Group = _Flat_hash_group;
+
+    using _Slot_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Val>;
+    using _Ctrl_alloc_type = typename std::allocator_traits<
+        _Alloc>::template rebind_alloc<_Flat_hash_ctrl>;
+    using _Slot_alloc_traits = std::allocator_traits<_Slot_alloc_type>;
+    using _Ctrl_alloc_traits = std::allocator_traits<_Ctrl_alloc_type>;
+    using _Propagate_on_copy =
+        typename _Slot_alloc_traits::propagate_on_container_copy_assignment;
+    using _Propagate_on_move =
+        typename _Slot_alloc_traits::propagate_on_container_move_assignment;
+
+public:
+    using key_type        = _Key;
+    using value_type      = _Val;
+    using hasher          = _Hash;
+    using key_equal       = _Equal;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator        = _Flat_hash_iterator<_Val, false>;
+    using const_iterator  = _Flat_hash_iterator<_Val, true>;
+
+    /**
+     * @brief Creates an empty table, which allocates nothing.
+     */
+    _Flat_hash_table()
+    : _ctrl(_S_empty_ctrl()), _slots(nullptr), _capacity(0), _size(0),
+      _growth_left(0), _hash(), _eq(), _slot_alloc(), _ctrl_alloc()
+    {
+    }
+
+    /**
+     * @brief Creates an empty table with room for @a n elements.
+     *
+     * @param n     Number of elements to reserve room for.
+     * @param hash  Hash function.
+     * @param eq    Equality of the keys.
+     * @param alloc Allocator object.
+     */
+    explicit _Flat_hash_table(size_type n, const _Hash &hash = _Hash(),
+                              const _Equal &eq    = _Equal(),
+                              const _Alloc &alloc = _Alloc())
+    : _ctrl(_S_empty_ctrl()), _slots(nullptr), _capacity(0), _size(0),
+      _growth_left(0), _hash(hash), _eq(eq), _slot_alloc(alloc),
+      _ctrl_alloc(alloc)
+    {
+        reserve(n);
+    }
+
+    /**
+     * @brief Creates a table by copying the values of another one, into a
+     * table just large enough for them.
+     */
+    _Flat_hash_table(const _Flat_hash_table &other)
+    : _ctrl(_S_empty_ctrl()), _slots(nullptr), _capacity(0), _size(0),
+      _growth_left(0), _hash(other._hash), _eq(other._eq),
+      _slot_alloc(_Slot_alloc_traits::select_on_container_copy_construction(
+          other._slot_alloc)),
+      _ctrl_alloc(_Ctrl_alloc_traits::select_on_container_copy_construction(
+          other._ctrl_alloc))
+    {
+        try
+        {
+            _copy_from(other);
+        }
+        catch (...)
+        {
+            _destroy_and_free();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Creates a table by stealing the arrays of another one.
+     */
+    _Flat_hash_table(_Flat_hash_table &&other) noexcept
+    : _ctrl(_S_empty_ctrl()), _slots(nullptr), _capacity(0), _size(0),
+      _growth_left(0), _hash(other._hash), _eq(other._eq),
+      _slot_alloc(std::move(other._slot_alloc)),
+      _ctrl_alloc(std::move(other._ctrl_alloc))
+    {
+        _steal(other);
+    }
+
+    ~_Flat_hash_table() { _destroy_and_free(); }
+
+    /**
+     * @brief Copies the values of another table, into slots from its
+     * allocator if the allocator propagates on copy assignment, and from the
+     * allocator of this table otherwise.
+     */
+    _Flat_hash_table &
+    operator=(const _Flat_hash_table &other)
+    {
+        if (&other == this)
+            return *this;
+
+        if constexpr (_Propagate_on_copy::value)
+        {
+            if (_slot_alloc != other._slot_alloc)
+                _release();
+            _slot_alloc = other._slot_alloc;
+            _ctrl_alloc = other._ctrl_alloc;
+        }
+
+        _hash = other._hash;
+        _eq   = other._eq;
+        clear();
+        try
+        {
+            _copy_from(other);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Takes the values of another table. Its arrays are stolen if the
+     * allocator propagates on move assignment or the allocators are equal,
+     * otherwise the values are moved one by one into slots from the
+     * allocator of this table.
+     */
+    _Flat_hash_table &
+    operator=(_Flat_hash_table &&other) noexcept(
+        _Propagate_on_move::value || _Slot_alloc_traits::is_always_equal::value)
+    {
+        if (&other == this)
+            return *this;
+
+        _hash = other._hash;
+        _eq   = other._eq;
+
+        if constexpr (_Propagate_on_move::value)
+        {
+            _destroy_and_free();
+            _slot_alloc = std::move(other._slot_alloc);
+            _ctrl_alloc = std::move(other._ctrl_alloc);
+            _steal(other);
+        }
+        else if (_slot_alloc == other._slot_alloc)
+        {
+            _destroy_and_free();
+            _steal(other);
+        }
+        else
+        {
+            clear();
+            reserve(other._size);
+            try
+            {
+                for (iterator it = other.begin(); it != other.end(); ++it)
+                    _insert_distinct(std::move(*it));
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    // Observers
+
+    hasher
+    hash_function() const
+    {
+        return _hash;
+    }
+
+    key_equal
+    key_eq() const
+    {
+        return _eq;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_slot_alloc);
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        iterator it(_ctrl, _slots);
+        it._skip();
+        return it;
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        const_iterator it(_ctrl, _slots);
+        it._skip();
+        return it;
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(_ctrl + _capacity, _slots + _capacity);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(_ctrl + _capacity, _slots + _capacity);
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _Slot_alloc_traits::max_size(_slot_alloc);
+    }
+
+    /**
+     * @brief Returns the number of slots.
+     */
+    size_type
+    bucket_count() const noexcept
+    {
+        return _capacity;
+    }
+
+    float
+    load_factor() const noexcept
+    {
+        return _capacity == 0 ? 0.0f : float(_size) / float(_capacity);
+    }
+
+    /**
+     * @brief Returns the load factor the table grows at, which is fixed.
+     */
+    float
+    max_load_factor() const noexcept
+    {
+        return 0.875f;
+    }
+
+    /**
+     * @brief Rebuilds the table with at least @a n slots, and enough for
+     * its elements, which drops the deleted slots. With @a n = 0, an empty
+     * table frees its arrays.
+     */
+    void
+    rehash(size_type n)
+    {
+        if (n == 0 && _size == 0)
+        {
+            _release();
+            return;
+        }
+
+        _resize(std::max(_S_normalize(n), _S_capacity_for(_size)));
+    }
+
+    /**
+     * @brief Makes room for @a n elements, so that inserting up to @a n
+     * elements in total does not grow the table.
+     */
+    void
+    reserve(size_type n)
+    {
+        if (n > _size + _growth_left)
+            _resize(_S_capacity_for(n));
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts @a v unless an equal key already exists.
+     *
+     * Returns an iterator to the element with the key of @a v, and whether
+     * the insertion took place.
+     */
+    template <typename _Arg>
+    std::pair<iterator, bool>
+    _insert_unique(_Arg &&v)
+    {
+        return _emplace_key(_KeyOfValue()(v), std::forward<_Arg>(v));
+    }
+
+    /**
+     * @brief Constructs a new element unless an equal key already exists.
+     *
+     * The value is constructed first to know its key, then moved into the
+     * table.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    _emplace_unique(Args &&...args)
+    {
+        value_type v(std::forward<Args>(args)...);
+        return _insert_unique(std::move(v));
+    }
+
+    /**
+     * @brief Constructs a new element from @a args in the slot of @a k,
+     * unless an element already has the key @a k.
+     *
+     * Nothing is constructed when the key exists. Otherwise @a args must
+     * construct a value whose key is equal to @a k.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    _emplace_key(const key_type &k, Args &&...args)
+    {
+        const size_type h = _S_hash_of(_hash, k);
+        size_type i       = _find(k, h);
+        if (i != _capacity)
+            return {_iterator_at(i), false};
+
+        i = _prepare_insert(h);
+        _Slot_alloc_traits::construct(_slot_alloc, _slots + i,
+                                      std::forward<Args>(args)...);
+        _growth_left -= _ctrl[i] == _Flat_hash_empty;
+        _set_ctrl(i, _S_h2(h));
+        _size++;
+        return {_iterator_at(i), true};
+    }
+
+    /**
+     * @brief Removes the element at @a pos and returns an iterator to the
+     * element following it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        iterator next(pos._ctrl, pos._slot);
+        ++next;
+        _erase_at(pos._slot - _slots);
+        return next;
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        if (first == begin() && last == end())
+        {
+            clear();
+            return end();
+        }
+
+        // An erasure leaves the other slots in place, so @a last stays valid
+        while (first != last)
+            first = erase(first);
+
+        return iterator(last._ctrl, last._slot);
+    }
+
+    /**
+     * @brief Removes the element with the key @a k, if present.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const size_type i = _find(k, _S_hash_of(_hash, k));
+        if (i == _capacity)
+            return 0;
+
+        _erase_at(i);
+        return 1;
+    }
+
+    /**
+     * @brief Removes every element, and keeps the slots.
+     */
+    void
+    clear() noexcept
+    {
+        if (_capacity == 0)
+            return;
+
+        _destroy_values();
+        _reset_ctrl();
+        _size        = 0;
+        _growth_left = _S_growth(_capacity);
+    }
+
+    /**
+     * @brief Swaps the content of two tables in constant time.
+     */
+    void
+    swap(_Flat_hash_table &other) noexcept
+    {
+        std::swap(_ctrl, other._ctrl);
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_size, other._size);
+        std::swap(_growth_left, other._growth_left);
+        std::swap(_hash, other._hash);
+        std::swap(_eq, other._eq);
+
+        if constexpr (_Slot_alloc_traits::propagate_on_container_swap::value)
+        {
+            std::swap(_slot_alloc, other._slot_alloc);
+            std::swap(_ctrl_alloc, other._ctrl_alloc);
+        }
+    }
+
+    // Lookup
+
+    iterator
+    find(const key_type &k)
+    {
+        return _iterator_at(_find(k, _S_hash_of(_hash, k)));
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        const size_type i = _find(k, _S_hash_of(_hash, k));
+        return const_iterator(_ctrl + i, _slots + i);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _find(k, _S_hash_of(_hash, k)) != _capacity;
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns whether two tables hold equal elements.
+     */
+    friend bool
+    operator==(const _Flat_hash_table &lhs, const _Flat_hash_table &rhs)
+    {
+        if (lhs._size != rhs._size)
+            return false;
+
+        for (const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+        {
+            const_iterator j = rhs.find(_S_key(*it));
+            if (j == rhs.end() || !(*j == *it))
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    _Flat_hash_ctrl *_ctrl; // _capacity + _Group::width control bytes
+    _Val *_slots;
+    size_type _capacity; // 0 or 2^k - 1
+    size_type _size;
+    size_type _growth_left; // Empty slots left to fill before growing
+    _Hash _hash;
+    _Equal _eq;
+    _Slot_alloc_type _slot_alloc;
+    _Ctrl_alloc_type _ctrl_alloc;
+
+    static _Flat_hash_ctrl *
+    _S_empty_ctrl() noexcept
+    {
+        return const_cast<_Flat_hash_ctrl *>(_Flat_hash_empty_group);
+    }
+
+    static const key_type &
+    _S_key(const value_type &v)
+    {
+        return _KeyOfValue()(v);
+    }
+
+    static size_type
+    _S_hash_of(const _Hash &hash, const key_type &k)
+    {
+        return _Flat_hash_mix(hash(k));
+    }
+
+    // The hash without its 7 low bits gives the first group to probe
+    static size_type
+    _S_h1(size_type h) noexcept
+    {
+        return h >> 7;
+    }
+
+    static _Flat_hash_ctrl
+    _S_h2(size_type h) noexcept
+    {
+        return static_cast<_Flat_hash_ctrl>(h & 0x7f);
+    }
+
+    /**
+     * Returns the number of elements a table of @a capacity slots holds
+     * before it grows, which leaves at least one slot empty so that every
+     * probe ends.
+     */
+    static size_type
+    _S_growth(size_type capacity) noexcept
+    {
+        return capacity - (capacity + 1) / 8;
+    }
+
+    /**
+     * Returns the smallest capacity of the form 2^k - 1 of at least @a n,
+     * and of at least a group.
+     */
+    static size_type
+    _S_normalize(size_type n) noexcept
+    {
+        return std::bit_ceil(std::max(n, _Group::width - 1) + 1) - 1;
+    }
+
+    static size_type
+    _S_capacity_for(size_type n) noexcept
+    {
+        size_type capacity = _S_normalize(n);
+        while (_S_growth(capacity) < n)
+            capacity = 2 * capacity + 1;
+        return capacity;
+    }
+
+    iterator
+    _iterator_at(size_type i) noexcept
+    {
+        return iterator(_ctrl + i, _slots + i);
+    }
+
+    /**
+     * Sets the control byte of slot @a i, and its clone if it is one of the
+     * first group - 1 slots, without a branch: for the other slots, the
+     * clone index is @a i itself.
+     */
+    void
+    _set_ctrl(size_type i, _Flat_hash_ctrl c) noexcept
+    {
+        _ctrl[i] = c;
+        _ctrl[((i - (_Group::width - 1)) & _capacity) +
+              (_Group::width - 1)] = c;
+    }
+
+    /**
+     * Returns the slot of the element with the key @a k, of hash @a h, or
+     * _capacity if there is none.
+     */
+    size_type
+    _find(const key_type &k, size_type h) const
+    {
+        const _Flat_hash_ctrl h2 = _S_h2(h);
+        size_type offset         = _S_h1(h) & _capacity;
+        for (size_type step = _Group::width;; step += _Group::width)
+        {
+            const _Group g(_ctrl + offset);
+            for (auto m = g.match(h2); m; m.pop())
+            {
+                const size_type i = (offset + m.lowest()) & _capacity;
+                if (_eq(k, _S_key(_slots[i]))) [[likely]]
+                    return i;
+            }
+            if (g.match_empty()) [[likely]]
+                return _capacity;
+            offset = (offset + step) & _capacity;
+        }
+    }
+
+    /**
+     * Returns the first empty or deleted slot on the probe sequence of a
+     * hash @a h.
+     */
+    size_type
+    _find_first_non_full(size_type h) const noexcept
+    {
+        size_type offset = _S_h1(h) & _capacity;
+        for (size_type step = _Group::width;; step += _Group::width)
+        {
+            const auto m = _Group(_ctrl + offset).match_empty_or_deleted();
+            if (m)
+                return (offset + m.lowest()) & _capacity;
+            offset = (offset + step) & _capacity;
+        }
+    }
+
+    /**
+     * Returns the slot a new element of hash @a h goes to. Filling an empty
+     * slot when none is left to fill first grows the table, or only
+     * rehashes it if half of the elements it could hold were erased, since
+     * dropping the deleted slots then makes enough room.
+     */
+    size_type
+    _prepare_insert(size_type h)
+    {
+        size_type i = _find_first_non_full(h);
+        if (_growth_left == 0 && _ctrl[i] != _Flat_hash_deleted)
+        {
+            if (_capacity == 0)
+                _resize(_Group::width - 1);
+            else if (_size <= _S_growth(_capacity) / 2)
+                _resize(_capacity);
+            else
+                _resize(2 * _capacity + 1);
+            i = _find_first_non_full(h);
+        }
+        return i;
+    }
+
+    /**
+     * Destroys the element of slot @a i. The slot becomes empty again if
+     * no probe ever went past it, i.e. if every window of a group that
+     * holds it also holds an empty slot, and deleted otherwise, so that the
+     * probes that went past it still find their key.
+     */
+    void
+    _erase_at(size_type i) noexcept
+    {
+        _Slot_alloc_traits::destroy(_slot_alloc, _slots + i);
+        _size--;
+
+        const size_type before  = (i - _Group::width) & _capacity;
+        const auto empty_after  = _Group(_ctrl + i).match_empty();
+        const auto empty_before = _Group(_ctrl + before).match_empty();
+        const bool was_never_full =
+            empty_before && empty_after &&
+            empty_after.trailing_zeros() + empty_before.leading_zeros() <
+                _Group::width;
+
+        _set_ctrl(i, was_never_full ? _Flat_hash_empty : _Flat_hash_deleted);
+        _growth_left += was_never_full;
+    }
+
+    void
+    _reset_ctrl() noexcept
+    {
+        std::memset(_ctrl, static_cast<unsigned char>(_Flat_hash_empty),
+                    _capacity + _Group::width);
+        _ctrl[_capacity] = _Flat_hash_sentinel;
+    }
+
+    void
+    _destroy_values() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<_Val>)
+            for (iterator it = begin(); it != end(); ++it)
+                _Slot_alloc_traits::destroy(_slot_alloc, it._slot);
+    }
+
+    void
+    _destroy_and_free() noexcept
+    {
+        if (_capacity == 0)
+            return;
+
+        _destroy_values();
+        _Slot_alloc_traits::deallocate(_slot_alloc, _slots, _capacity);
+        _Ctrl_alloc_traits::deallocate(_ctrl_alloc, _ctrl,
+                                       _capacity + _Group::width);
+    }
+
+    /**
+     * Moves every element to new arrays of @a capacity slots, which must
+     * hold them. Nothing changes if the allocation fails.
+     */
+    void
+    _resize(size_type capacity)
+    {
+        _Val *slots = _Slot_alloc_traits::allocate(_slot_alloc, capacity);
+        _Flat_hash_ctrl *ctrl;
+        try
+        {
+            ctrl = _Ctrl_alloc_traits::allocate(_ctrl_alloc,
+                                                capacity + _Group::width);
+        }
+        catch (...)
+        {
+            _Slot_alloc_traits::deallocate(_slot_alloc, slots, capacity);
+            throw;
+        }
+
+        _Flat_hash_ctrl *old_ctrl    = _ctrl;
+        _Val *old_slots              = _slots;
+        const size_type old_capacity = _capacity;
+
+        _ctrl        = ctrl;
+        _slots       = slots;
+        _capacity    = capacity;
+        _growth_left = _S_growth(capacity) - _size;
+        _reset_ctrl();
+
+        if (old_capacity != 0)
+        {
+            _transfer(old_ctrl, old_slots, old_capacity);
+            _Slot_alloc_traits::deallocate(_slot_alloc, old_slots,
+                                           old_capacity);
+            _Ctrl_alloc_traits::deallocate(_ctrl_alloc, old_ctrl,
+                                           old_capacity + _Group::width);
+        }
+    }
+
+    /**
+     * Moves the elements of the old arrays of a table, whose keys are known
+     * to be distinct, to its new ones, which have room for them.
+     */
+    void
+    _transfer(const _Flat_hash_ctrl *ctrl, _Val *slots,
+              size_type capacity) noexcept
+    {
+        iterator it(ctrl, slots);
+        for (it._skip(); it._ctrl != ctrl + capacity; ++it)
+        {
+            const size_type h = _S_hash_of(_hash, _S_key(*it));
+            const size_type i = _find_first_non_full(h);
+            _Slot_alloc_traits::construct(_slot_alloc, _slots + i,
+                                          std::move(*it));
+            _Slot_alloc_traits::destroy(_slot_alloc, it._slot);
+            _set_ctrl(i, _S_h2(h));
+        }
+    }
+
+    /**
+     * Constructs a value whose key is known not to be in the table, which
+     * has room for it.
+     */
+    template <typename _Arg>
+    void
+    _insert_distinct(_Arg &&v)
+    {
+        const size_type h = _S_hash_of(_hash, _S_key(v));
+        const size_type i = _find_first_non_full(h);
+        _Slot_alloc_traits::construct(_slot_alloc, _slots + i,
+                                      std::forward<_Arg>(v));
+        _set_ctrl(i, _S_h2(h));
+        _size++;
+        _growth_left--;
+    }
+
+    /**
+     * Copies the values of @a other into this table, which is empty.
+     */
+    void
+    _copy_from(const _Flat_hash_table &other)
+    {
+        reserve(other._size);
+        for (const_iterator it = other.begin(); it != other.end(); ++it)
+            _insert_distinct(*it);
+    }
+
+    /**
+     * Destroys the values and frees the arrays, leaving a table without
+     * slots.
+     */
+    void
+    _release() noexcept
+    {
+        _destroy_and_free();
+        _ctrl        = _S_empty_ctrl();
+        _slots       = nullptr;
+        _capacity    = 0;
+        _size        = 0;
+        _growth_left = 0;
+    }
+
+    void
+    _steal(_Flat_hash_table &other) noexcept
+    {
+        _ctrl        = other._ctrl;
+        _slots       = other._slots;
+        _capacity    = other._capacity;
+        _size        = other._size;
+        _growth_left = other._growth_left;
+
+        other._ctrl        = _S_empty_ctrl();
+        other._slots       = nullptr;
+        other._capacity    = 0;
+        other._size        = 0;
+        other._growth_left = 0;
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_FLAT_HASH_TABLE_H */
@@ -95,6 +95,32 @@ namespace opendsa
                                             std::make_move_iterator(__last),
                                             __start_result, __alloc);
     }
+
+    /**
+     * @brief Extracts the key of a key/value pair.
+     */
+    struct _Select_first
+    {
+        template <typename _Pair>
+        const typename _Pair::first_type &
+        operator()(const _Pair &x) const noexcept
+        {
+            return x.first;
+        }
+    };
+
+    /**
+     * @brief Uses a value as its own key.
+     */
+    struct _Identity
+    {
+        template <typename _Tp>
+        const _Tp &
+        operator()(const _Tp &x) const noexcept
+        {
+            return x;
+        }
+    };
 } // namespace opendsa
 
 #ifndef NDEBUG
@@ -0,0 +1,599 @@
+/**
+ * @file interval_tree.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered container of intervals with fast overlap queries
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_INTERVAL_TREE_H
+#define __OPENDSA_INTERVAL_TREE_H 1
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "helper.h"
+#include "tree.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A half-open interval [low, high), which must not be empty.
+ *
+ * Intervals are ordered by their low endpoint, then by their high endpoint.
+ */
+template <typename _Tp>
+struct interval
+{
+    _Tp low;
+    _Tp high;
+
+    friend auto
+    operator<=>(const interval &, const interval &) = default;
+
+    /**
+     * @brief Returns whether this interval and the non-empty interval
+     * [lo, hi) share a point.
+     */
+    bool
+    overlaps(const _Tp &lo, const _Tp &hi) const
+    {
+        return low < hi && lo < high;
+    }
+};
+
+/**
+ * @brief Augmentation of an interval tree: the highest endpoint of every
+ * subtree, see subtree_size.
+ */
+template <typename _Tp>
+struct _Interval_max_high
+{
+    using value_type = _Tp;
+
+    static constexpr value_type
+    identity() noexcept
+    {
+        return std::numeric_limits<_Tp>::lowest();
+    }
+
+    template <typename _Val>
+    constexpr value_type
+    operator()(const _Val &v) const noexcept
+    {
+        return v.first.high;
+    }
+
+    constexpr value_type
+    operator()(const value_type &lhs, const value_type &rhs) const noexcept
+    {
+        return lhs < rhs ? rhs : lhs;
+    }
+};
+
+/**
+ * @brief Forward iterator over the elements of an interval tree that overlap
+ * a query interval [low, high), in ascending order.
+ *
+ * The subtrees whose highest endpoint is not above @a _low hold no overlapping
+ * interval and are skipped, and the walk stops at the first interval that
+ * starts at or after @a _high. The past-the-end position is the header of the
+ * tree.
+ */
+template <typename _Tp, typename _Val>
+struct _Interval_overlap_iterator
+{
+    using value_type        = _Val;
+    using reference         = _Val &;
+    using pointer           = _Val *;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Bi_tree_node_base<_Val>;
+    using base_ptr  = typename node_type::base_ptr;
+    using aug_node  = _Bi_tree_aug_node<_Val, _Tp>;
+
+    base_ptr _node;
+    base_ptr _header;
+    _Tp _low;
+    _Tp _high;
+
+    _Interval_overlap_iterator() noexcept
+    : _node(), _header(), _low(), _high()
+    {
+    }
+
+    _Interval_overlap_iterator(base_ptr x, base_ptr header, const _Tp &low,
+                               const _Tp &high)
+    : _node(x), _header(header), _low(low), _high(high)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_valptr();
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _node->_valptr();
+    }
+
+    _Interval_overlap_iterator &
+    operator++()
+    {
+        _node = _S_next(_node, _header, _low, _high);
+        return *this;
+    }
+
+    _Interval_overlap_iterator
+    operator++(int)
+    {
+        _Interval_overlap_iterator tmp = *this;
+        _node                          = _S_next(_node, _header, _low, _high);
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Interval_overlap_iterator &lhs,
+               const _Interval_overlap_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+
+    static const _Tp &
+    _S_max_high(base_ptr x) noexcept
+    {
+        return static_cast<aug_node *>(x)->_aug;
+    }
+
+    /**
+     * @brief Returns the first node of the subtree rooted at @a x whose
+     * interval ends after @a low. Such a node must exist.
+     *
+     * There is no backtracking: the walk only enters a subtree whose highest
+     * endpoint is above @a low, which therefore holds a matching node.
+     */
+    static base_ptr
+    _S_first_ending_after(base_ptr x, const _Tp &low)
+    {
+        while (true)
+        {
+            if (x->_left != nullptr && low < _S_max_high(x->_left))
+                x = x->_left;
+            else if (low < x->_valptr()->first.high)
+                return x;
+            else
+                x = x->_right;
+        }
+    }
+
+    /**
+     * @brief Returns @a x if its interval starts before @a high, or the
+     * header otherwise, in which case no later interval can overlap either.
+     */
+    static base_ptr
+    _S_check_low(base_ptr x, base_ptr header, const _Tp &high)
+    {
+        if (x != header && x->_valptr()->first.low < high)
+            return x;
+        return header;
+    }
+
+    /**
+     * @brief Returns the first overlapping node of the tree, or the header.
+     */
+    static base_ptr
+    _S_first(base_ptr header, const _Tp &low, const _Tp &high)
+    {
+        base_ptr root = header->_parent;
+        if (root == nullptr || !(low < high) || !(low < _S_max_high(root)))
+            return header;
+
+        return _S_check_low(_S_first_ending_after(root, low), header, high);
+    }
+
+    /**
+     * @brief Returns the overlapping node that follows @a x in order, or the
+     * header.
+     */
+    static base_ptr
+    _S_next(base_ptr x, base_ptr header, const _Tp &low, const _Tp &high)
+    {
+        if (x->_right != nullptr && low < _S_max_high(x->_right))
+            return _S_check_low(_S_first_ending_after(x->_right, low), header,
+                                high);
+
+        // Climb to the next ancestor that comes after x, and look at it then
+        // at its right subtree
+        while (x->_parent != header)
+        {
+            base_ptr p = x->_parent;
+            if (x == p->_left)
+            {
+                if (!(p->_valptr()->first.low < high))
+                    return header;
+                if (low < p->_valptr()->first.high)
+                    return p;
+                if (p->_right != nullptr && low < _S_max_high(p->_right))
+                    return _S_check_low(_S_first_ending_after(p->_right, low),
+                                        header, high);
+            }
+            x = p;
+        }
+
+        return header;
+    }
+};
+
+/**
+ * @brief Readonly version of _Interval_overlap_iterator.
+ */
+template <typename _Tp, typename _Val>
+struct _Interval_const_overlap_iterator
+{
+    using value_type        = _Val;
+    using reference         = const _Val &;
+    using pointer           = const _Val *;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using iterator = _Interval_overlap_iterator<_Tp, _Val>;
+    using base_ptr = typename iterator::base_ptr;
+
+    iterator _it;
+
+    _Interval_const_overlap_iterator() noexcept : _it() { }
+
+    _Interval_const_overlap_iterator(const iterator &it) : _it(it) { }
+
+    /**
+     * @brief Converts back to a mutable iterator.
+     */
+    iterator
+    _const_cast() const
+    {
+        return _it;
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_it;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _it.operator->();
+    }
+
+    _Interval_const_overlap_iterator &
+    operator++()
+    {
+        ++_it;
+        return *this;
+    }
+
+    _Interval_const_overlap_iterator
+    operator++(int)
+    {
+        _Interval_const_overlap_iterator tmp = *this;
+        ++_it;
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Interval_const_overlap_iterator &lhs,
+               const _Interval_const_overlap_iterator &rhs) noexcept
+    {
+        return lhs._it == rhs._it;
+    }
+};
+
+/**
+ * @brief An ordered multimap from intervals to values, with overlap queries.
+ *
+ * @tparam _Tp     Type of the endpoints, e.g. timestamps. It must be ordered
+ *                 by operator< and have a std::numeric_limits<_Tp>::lowest().
+ * @tparam _Mapped Type of the mapped values.
+ * @tparam _Alloc  User-defined allocator.
+ *
+ * The elements are kept in a red-black _Bi_search_tree ordered by interval,
+ * i.e. by low endpoint first, and each node also keeps the highest endpoint of
+ * its subtree. overlapping() walks the tree in order but skips every subtree
+ * that ends before the query starts and stops at the first interval that
+ * starts after the query ends, so reporting the k overlapping intervals takes
+ * O(log n + k log n) at worst instead of a scan of all of them.
+ *
+ * Several elements may have the same interval; they are kept in insertion
+ * order.
+ */
+template <typename _Tp, typename _Mapped,
+          typename _Alloc =
+              std::allocator<std::pair<const interval<_Tp>, _Mapped>>>
+class interval_tree
+{
+public:
+    using endpoint_type  = _Tp;
+    using key_type       = interval<_Tp>;
+    using mapped_type    = _Mapped;
+    using value_type     = std::pair<const key_type, _Mapped>;
+    using allocator_type = _Alloc;
+
+private:
+    using _Tree_type =
+        _Bi_search_tree<key_type, value_type, _Select_first,
+                        std::less<key_type>, _Alloc, _Rb_tree_balance,
+                        _Interval_max_high<_Tp>>;
+
+public:
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = typename _Tree_type::size_type;
+    using difference_type = typename _Tree_type::difference_type;
+    using iterator        = typename _Tree_type::iterator;
+    using const_iterator  = typename _Tree_type::const_iterator;
+    using overlap_iterator = _Interval_overlap_iterator<_Tp, value_type>;
+    using const_overlap_iterator =
+        _Interval_const_overlap_iterator<_Tp, value_type>;
+
+    /**
+     * @brief Creates an empty %interval_tree.
+     */
+    interval_tree() : _tree() { }
+
+    /**
+     * @brief Creates an empty %interval_tree with a given allocator.
+     */
+    explicit interval_tree(const _Alloc &alloc)
+    : _tree(std::less<key_type>(), alloc)
+    {
+    }
+
+    /**
+     * @brief Creates an %interval_tree based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    interval_tree(std::initializer_list<value_type> list,
+                  const _Alloc &alloc = _Alloc())
+    : _tree(std::less<key_type>(), alloc)
+    {
+        for (const value_type &v : list)
+            insert(v);
+    }
+
+    /**
+     * @brief Creates an %interval_tree from a range sorted by interval in
+     * linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param alloc Allocator object.
+     *
+     * The tree is built perfectly balanced without any search nor
+     * rebalancing, and the highest endpoints are computed on the way.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static interval_tree
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Alloc &alloc = _Alloc())
+    {
+        interval_tree res(alloc);
+        res.insert_sorted(first, last);
+        return res;
+    }
+
+    interval_tree(const interval_tree &other) = default;
+
+    interval_tree(interval_tree &&other) noexcept = default;
+
+    interval_tree &
+    operator=(const interval_tree &other) = default;
+
+    interval_tree &
+    operator=(interval_tree &&other) = default;
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _tree.get_allocator();
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return _tree.begin();
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    iterator
+    end() noexcept
+    {
+        return _tree.end();
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    // Modifiers
+
+    iterator
+    insert(const value_type &x)
+    {
+        M_Assert(x.first.low < x.first.high, "Interval must not be empty");
+        return _tree._insert_equal(x);
+    }
+
+    iterator
+    insert(value_type &&x)
+    {
+        M_Assert(x.first.low < x.first.high, "Interval must not be empty");
+        return _tree._insert_equal(std::move(x));
+    }
+
+    template <typename... Args>
+    iterator
+    emplace(Args &&...args)
+    {
+        iterator it = _tree._emplace_equal(std::forward<Args>(args)...);
+        M_Assert(it->first.low < it->first.high, "Interval must not be empty");
+        return it;
+    }
+
+    /**
+     * @brief Inserts a range of elements sorted by interval.
+     *
+     * Large batches are merged with the tree in O(n + k), small ones are
+     * inserted one by one. See _Bi_search_tree::insert_sorted_equal().
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        _tree.insert_sorted_equal(first, last);
+    }
+
+    iterator
+    erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the elements of interval @a k and returns their number.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        return _tree.erase(k);
+    }
+
+    void
+    clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    void
+    swap(interval_tree &other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // Lookup
+
+    /**
+     * @brief Returns the first element of interval @a k, or end().
+     */
+    iterator
+    find(const key_type &k)
+    {
+        return _tree.find(k);
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        return _tree.find(k);
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _tree.count(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return find(k) != end();
+    }
+
+    /**
+     * @brief Returns the range of the elements whose interval overlaps
+     * [low, high), in ascending order.
+     *
+     * The range is computed lazily: each increment looks for the next
+     * overlapping interval. The range is empty if @a low is not less than
+     * @a high. The tree must not be modified while the range is in use.
+     */
+    std::pair<overlap_iterator, overlap_iterator>
+    overlapping(const _Tp &low, const _Tp &high)
+    {
+        std::pair<const_overlap_iterator, const_overlap_iterator> res =
+            std::as_const(*this).overlapping(low, high);
+        return {res.first._const_cast(), res.second._const_cast()};
+    }
+
+    std::pair<const_overlap_iterator, const_overlap_iterator>
+    overlapping(const _Tp &low, const _Tp &high) const
+    {
+        using _Base_ptr = typename overlap_iterator::base_ptr;
+
+        _Base_ptr header = _tree.end()._const_cast()._node;
+        _Base_ptr first  = overlap_iterator::_S_first(header, low, high);
+        return {overlap_iterator(first, header, low, high),
+                overlap_iterator(header, header, low, high)};
+    }
+
+    /**
+     * @brief Returns whether some element overlaps [low, high).
+     */
+    bool
+    overlaps(const _Tp &low, const _Tp &high) const
+    {
+        std::pair<const_overlap_iterator, const_overlap_iterator> res =
+            overlapping(low, high);
+        return res.first != res.second;
+    }
+
+private:
+    _Tree_type _tree;
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_INTERVAL_TREE_H */
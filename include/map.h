@@ -0,0 +1,724 @@
+/**
+ * @file map.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered associative container of key/value pairs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_MAP_H
+#define __OPENDSA_MAP_H 1
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "helper.h"
+#include "tree.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief An ordered map of unique keys
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Tp      Type of the mapped values.
+ * @tparam _Compare Strict weak ordering of the keys.
+ * @tparam _Alloc   User-defined allocator.
+ * @tparam _Balance Balancing scheme of the tree, see avl_map.
+ * @tparam _Augment Data folded over every subtree, see order_statistic_map.
+ *
+ * A map is an adapter over a red-black _Bi_search_tree whose values are
+ * std::pair<const _Key, _Tp>. Lookup, insertion and removal are O(log n), and
+ * iterating goes through the elements in ascending order of the keys.
+ */
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+          typename _Alloc   = std::allocator<std::pair<const _Key, _Tp>>,
+          typename _Balance = _Rb_tree_balance, typename _Augment = void>
+class map
+{
+public:
+    using key_type    = _Key;
+    using mapped_type = _Tp;
+    using value_type  = std::pair<const _Key, _Tp>;
+    using key_compare = _Compare;
+
+private:
+    using _Tree_type =
+        _Bi_search_tree<_Key, value_type, _Select_first, _Compare, _Alloc,
+                        _Balance, _Augment>;
+
+public:
+    using allocator_type         = _Alloc;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using size_type              = typename _Tree_type::size_type;
+    using difference_type        = typename _Tree_type::difference_type;
+    using iterator               = typename _Tree_type::iterator;
+    using const_iterator         = typename _Tree_type::const_iterator;
+    using reverse_iterator       = typename _Tree_type::reverse_iterator;
+    using const_reverse_iterator = typename _Tree_type::const_reverse_iterator;
+
+    /**
+     * @brief Compares two elements of the %map by their keys.
+     */
+    class value_compare
+    {
+    public:
+        bool
+        operator()(const value_type &lhs, const value_type &rhs) const
+        {
+            return comp(lhs.first, rhs.first);
+        }
+
+    protected:
+        _Compare comp;
+
+        value_compare(_Compare c) : comp(c) { }
+
+        friend class map;
+    };
+
+    /**
+     * @brief Creates an empty %map.
+     */
+    map() : _tree() { }
+
+    /**
+     * @brief Creates an empty %map with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit map(const _Compare &comp, const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %map based on a range of elements.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     *
+     * If several elements have equivalent keys, only the first one is kept.
+     */
+    template <typename _InputIter>
+    map(_InputIter first, _InputIter last, const _Compare &comp = _Compare(),
+        const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %map based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    map(std::initializer_list<value_type> list,
+        const _Compare &comp = _Compare(), const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Creates a %map from a sorted range in linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The range must be sorted by @a comp. The tree is built perfectly
+     * balanced without any search nor rebalancing, e.g. to reload a snapshot.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static map
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        map res(comp, alloc);
+        res.insert_sorted(first, last);
+        return res;
+    }
+
+    map(const map &other) = default;
+
+    map(map &&other) noexcept = default;
+
+    map &
+    operator=(const map &other) = default;
+
+    map &
+    operator=(map &&other) = default;
+
+    map &
+    operator=(std::initializer_list<value_type> list)
+    {
+        _tree.clear();
+        insert(list.begin(), list.end());
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _tree.get_allocator();
+    }
+
+    // Element access
+
+    /**
+     * @brief Returns a reference to the value mapped to @a k.
+     *
+     * Throws std::out_of_range if no element has the key @a k.
+     */
+    mapped_type &
+    at(const key_type &k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("map::at: key not found");
+
+        return it->second;
+    }
+
+    const mapped_type &
+    at(const key_type &k) const
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("map::at: key not found");
+
+        return it->second;
+    }
+
+    /**
+     * @brief Returns a reference to the value mapped to @a k, inserting a
+     * default constructed value if no element has the key @a k.
+     */
+    mapped_type &
+    operator[](const key_type &k)
+    {
+        return try_emplace(k).first->second;
+    }
+
+    mapped_type &
+    operator[](key_type &&k)
+    {
+        return try_emplace(std::move(k)).first->second;
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return _tree.begin();
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    iterator
+    end() noexcept
+    {
+        return _tree.end();
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return _tree.end();
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return _tree.rend();
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %map is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the %map.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _tree.max_size();
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Removes every element of the %map.
+     */
+    void
+    clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief Inserts a key/value pair unless the key already exists.
+     *
+     * @param x Pair to be inserted.
+     *
+     * Returns an iterator to the element with the key of @a x, and whether
+     * the insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        return _tree._insert_unique(x);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        return _tree._insert_unique(std::move(x));
+    }
+
+    /**
+     * @brief Inserts a key/value pair using @a hint as a suggestion of where
+     * it goes.
+     *
+     * @param hint Iterator to the element that would follow the new one.
+     * @param x    Pair to be inserted.
+     *
+     * The insertion is amortized O(1) if the new element goes right before
+     * @a hint, e.g. when inserting sorted data with end() as the hint.
+     */
+    iterator
+    insert(const_iterator hint, const value_type &x)
+    {
+        return _tree._insert_hint_unique(hint, x);
+    }
+
+    iterator
+    insert(const_iterator hint, value_type &&x)
+    {
+        return _tree._insert_hint_unique(hint, std::move(x));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last).
+     */
+    template <typename _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            _tree._emplace_hint_unique(end(), *first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Inserts a sorted range of elements.
+     *
+     * Large batches are merged with the %map in O(n + k), small ones are
+     * inserted with hints. See _Bi_search_tree::insert_sorted().
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        _tree.insert_sorted(first, last);
+    }
+
+    /**
+     * @brief Inserts a new element or assigns to the existing one.
+     */
+    template <typename _Obj>
+    std::pair<iterator, bool>
+    insert_or_assign(const key_type &k, _Obj &&obj)
+    {
+        std::pair<iterator, bool> res = try_emplace(k, std::forward<_Obj>(obj));
+        if (!res.second)
+            res.first->second = std::forward<_Obj>(obj);
+
+        return res;
+    }
+
+    /**
+     * @brief Constructs a new element in place unless the key already
+     * exists.
+     *
+     * @param args Argument list to construct a value_type.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        return _tree._emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs a new element in place using @a hint as a suggestion
+     * of where it goes.
+     */
+    template <typename... Args>
+    iterator
+    emplace_hint(const_iterator hint, Args &&...args)
+    {
+        return _tree._emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs the mapped value in place if @a k doesn't exist yet.
+     *
+     * Unlike emplace(), nothing is constructed when the key already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(const key_type &k, Args &&...args)
+    {
+        iterator it = lower_bound(k);
+        if (it != end() && !key_comp()(k, it->first))
+            return {it, false};
+
+        it = _tree._emplace_hint_unique(
+            it, std::piecewise_construct, std::forward_as_tuple(k),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        return {it, true};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(key_type &&k, Args &&...args)
+    {
+        iterator it = lower_bound(k);
+        if (it != end() && !key_comp()(k, it->first))
+            return {it, false};
+
+        it = _tree._emplace_hint_unique(
+            it, std::piecewise_construct, std::forward_as_tuple(std::move(k)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        return {it, true};
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    iterator
+    erase(iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the element with the key @a k, if any.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+
+        _tree.erase(it);
+        return 1;
+    }
+
+    /**
+     * @brief Swaps the content between two maps in constant time.
+     */
+    void
+    swap(map &other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // Lookup
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _tree.find(k) == _tree.end() ? 0 : 1;
+    }
+
+    iterator
+    find(const key_type &k)
+    {
+        return _tree.find(k);
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        return _tree.find(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _tree.find(k) != _tree.end();
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k)
+    {
+        return _tree.equal_range(k);
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &k) const
+    {
+        return _tree.equal_range(k);
+    }
+
+    /**
+     * @brief Returns the first element whose key is not less than @a k.
+     */
+    iterator
+    lower_bound(const key_type &k)
+    {
+        return _tree.lower_bound(k);
+    }
+
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        return _tree.lower_bound(k);
+    }
+
+    /**
+     * @brief Returns the first element whose key is greater than @a k.
+     */
+    iterator
+    upper_bound(const key_type &k)
+    {
+        return _tree.upper_bound(k);
+    }
+
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        return _tree.upper_bound(k);
+    }
+
+    // Traversal
+
+    /**
+     * @brief Calls @a fn on every element in ascending order of the keys.
+     *
+     * Faster than iterating for a full scan, see
+     * _Bi_search_tree::for_each_inorder(). @a fn must not insert nor remove
+     * elements.
+     */
+    template <typename _Fn>
+    void
+    for_each_inorder(_Fn fn)
+    {
+        _tree.for_each_inorder(fn);
+    }
+
+    template <typename _Fn>
+    void
+    for_each_inorder(_Fn fn) const
+    {
+        _tree.for_each_inorder(fn);
+    }
+
+    // Order statistics
+
+    /**
+     * @brief Returns the element at position @a k in ascending order, or end()
+     * if there are not that many.
+     */
+    iterator
+    select(size_type k)
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.select(k);
+    }
+
+    const_iterator
+    select(size_type k) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.select(k);
+    }
+
+    /**
+     * @brief Returns the number of elements whose key is less than @a k.
+     */
+    size_type
+    rank(const key_type &k) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.rank(k);
+    }
+
+    /**
+     * @brief Returns the number of elements whose key is in [lo, hi).
+     */
+    size_type
+    count_range(const key_type &lo, const key_type &hi) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.count_range(lo, hi);
+    }
+
+    /**
+     * @brief Returns the augmented data folded over the elements whose key is
+     * in [lo, hi).
+     */
+    auto
+    fold(const key_type &lo, const key_type &hi) const
+        requires(!std::is_void_v<_Augment>)
+    {
+        return _tree.fold(lo, hi);
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _tree.key_comp();
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return value_compare(_tree.key_comp());
+    }
+
+    friend bool
+    operator==(const map &lhs, const map &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool
+    operator!=(const map &lhs, const map &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    _Tree_type _tree;
+};
+
+/**
+ * @brief A %map backed by an AVL tree.
+ *
+ * The tree is kept more strictly balanced, hence shallower, than the default
+ * red-black tree. Lookups get faster while insertions and removals do more
+ * rotations, which suits maps that are read far more often than written.
+ */
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<std::pair<const _Key, _Tp>>>
+using avl_map = map<_Key, _Tp, _Compare, _Alloc, _Avl_tree_balance>;
+
+/**
+ * @brief A %map that also finds the element at a given position and the
+ * position of a key in O(log n), see select() and rank().
+ */
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<std::pair<const _Key, _Tp>>>
+using order_statistic_map =
+    map<_Key, _Tp, _Compare, _Alloc, _Rb_tree_balance, subtree_size>;
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_MAP_H */
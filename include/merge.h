@@ -0,0 +1,367 @@
+/**
+ * @file merge.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief K-way merge of sorted runs with a loser tree
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_MERGE_H
+#define __OPENDSA_MERGE_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "algorithm.h"
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A tournament tree that repeatedly yields the smallest head of k
+ * sorted runs.
+ *
+ * @tparam _Iter    Input iterator over the runs.
+ * @tparam _Compare Strict weak ordering the runs are sorted by.
+ *
+ * The runs are the leaves of a complete binary tree, and each internal node
+ * keeps the run that lost the match played there, i.e. the one with the
+ * greater head, while the winner goes up. Node 0 keeps the overall winner.
+ * After the winner is popped, only the matches on the path from its leaf to
+ * the root are replayed, against the losers stored there, which takes
+ * ceil(log2 k) comparisons rather than the 2 log2 k of a binary heap.
+ *
+ * Ties go to the run of lower index, so a merge is stable across the runs.
+ * The runs are read through input iterators, e.g. buffered readers of the
+ * files of an external sort, and each head is dereferenced when it is
+ * compared.
+ */
+template <std::input_iterator _Iter, typename _Compare = std::less<>>
+class loser_tree
+{
+public:
+    using value_type = typename std::iterator_traits<_Iter>::value_type;
+    using reference  = typename std::iterator_traits<_Iter>::reference;
+    using size_type  = std::size_t;
+
+    /**
+     * @brief Creates a %loser_tree over the runs [first, last) of @a runs.
+     *
+     * @param runs Pairs of iterators to mark the sorted runs.
+     * @param comp Comparison object.
+     */
+    explicit loser_tree(const vector<std::pair<_Iter, _Iter>> &runs,
+                        const _Compare &comp = _Compare())
+    : _comp(comp), _k(runs.size()), _cur(runs.size()), _end(runs.size()),
+      _losers(std::max(runs.size(), size_type(1)))
+    {
+        for (size_type r = 0; r < _k; r++)
+        {
+            _cur[r] = runs[r].first;
+            _end[r] = runs[r].second;
+        }
+        _build();
+    }
+
+    /**
+     * @brief Returns whether every run is exhausted.
+     */
+    bool
+    empty() const
+    {
+        return _k == 0 || _done(_losers[0]);
+    }
+
+    /**
+     * @brief Returns the smallest head.
+     */
+    reference
+    top() const
+    {
+        M_Assert(!empty(), "The loser tree is empty");
+        return *_cur[_losers[0]];
+    }
+
+    /**
+     * @brief Returns the index of the run of the smallest head.
+     */
+    size_type
+    top_run() const noexcept
+    {
+        return _losers[0];
+    }
+
+    /**
+     * @brief Advances the run of the smallest head.
+     */
+    void
+    pop()
+    {
+        M_Assert(!empty(), "The loser tree is empty");
+        const size_type r = _losers[0];
+        ++_cur[r];
+        _replay(r);
+    }
+
+private:
+    _Compare _comp;
+    size_type _k;
+    vector<_Iter> _cur;
+    vector<_Iter> _end;
+    vector<size_type> _losers;
+
+    bool
+    _done(size_type r) const
+    {
+        return _cur[r] == _end[r];
+    }
+
+    /**
+     * Returns whether the head of run @a a comes before the head of run
+     * @a b. An exhausted run comes last.
+     */
+    bool
+    _before(size_type a, size_type b) const
+    {
+        if (_done(a))
+            return false;
+        if (_done(b))
+            return true;
+        if (_comp(*_cur[a], *_cur[b]))
+            return true;
+        return a < b && !_comp(*_cur[b], *_cur[a]);
+    }
+
+    /**
+     * Plays every match bottom-up. The leaf of run r is node k + r.
+     */
+    void
+    _build()
+    {
+        if (_k <= 1)
+        {
+            _losers[0] = 0;
+            return;
+        }
+
+        vector<size_type> winners(2 * _k);
+        for (size_type r = 0; r < _k; r++)
+            winners[_k + r] = r;
+
+        for (size_type node = _k - 1; node > 0; node--)
+        {
+            const size_type left  = winners[2 * node];
+            const size_type right = winners[2 * node + 1];
+            const bool right_wins = _before(right, left);
+            winners[node]         = right_wins ? right : left;
+            _losers[node]         = right_wins ? left : right;
+        }
+        _losers[0] = winners[1];
+    }
+
+    void
+    _replay(size_type r)
+    {
+        size_type winner = r;
+        for (size_type node = (_k + r) / 2; node > 0; node /= 2)
+            if (_before(_losers[node], winner))
+                std::swap(_losers[node], winner);
+        _losers[0] = winner;
+    }
+};
+
+/**
+ * Returns the bounds of a run as iterators over its elements. A container
+ * with no const iterators, such as opendsa::vector, is read through the
+ * pointer to its storage.
+ */
+template <typename Run>
+auto
+__run_begin(const Run &run)
+{
+    if constexpr (std::ranges::common_range<const Run>)
+        return std::ranges::begin(run);
+    else
+        return std::ranges::data(run);
+}
+
+template <typename Run>
+auto
+__run_end(const Run &run)
+{
+    if constexpr (std::ranges::common_range<const Run>)
+        return std::ranges::end(run);
+    else
+        return std::ranges::data(run) + run.size();
+}
+
+/**
+ * Merges arithmetic keys with a loser tree that keeps a copy of the head of
+ * each loser in its node, so a replay reads no run and dereferences no
+ * iterator but the one of the popped run. An exhausted run plays with the
+ * largest key and its index offset by k, so that it loses every tie, even
+ * to a real key as large as the sentinel. Exactly as many keys as the runs
+ * hold are written, so a sentinel never wins. The keys must not be NaN.
+ */
+template <typename Runs, typename OutputIter>
+OutputIter
+__multiway_merge_arithmetic(const Runs &runs, OutputIter out)
+{
+    using value_type = typename Runs::value_type::value_type;
+    using iter_type  = decltype(__run_begin(runs[0]));
+    using size_type  = std::size_t;
+
+    constexpr value_type sentinel =
+        std::numeric_limits<value_type>::has_infinity
+            ? std::numeric_limits<value_type>::infinity()
+            : std::numeric_limits<value_type>::max();
+
+    const size_type k = runs.size();
+    if (k == 0)
+        return out;
+
+    vector<iter_type> cur(k), end(k);
+    size_type total = 0;
+    for (size_type r = 0; r < k; r++)
+    {
+        cur[r] = __run_begin(runs[r]);
+        end[r] = __run_end(runs[r]);
+        total += runs[r].size();
+    }
+
+    auto head = [&](size_type r, value_type &key, size_type &tag)
+    {
+        const bool done = cur[r] == end[r];
+        key             = done ? sentinel : *cur[r];
+        tag             = done ? r + k : r;
+    };
+
+    // Initial tournament, over the leaves k to 2k - 1
+    vector<value_type> keys(2 * k);
+    vector<size_type> tags(2 * k);
+    for (size_type r = 0; r < k; r++)
+        head(r, keys[k + r], tags[k + r]);
+
+    vector<value_type> win_keys(keys);
+    vector<size_type> win_tags(tags);
+    for (size_type node = k - 1; node > 0; node--)
+    {
+        const size_type l = 2 * node, r = 2 * node + 1;
+        const bool right  = (win_keys[r] < win_keys[l]) |
+                           ((win_keys[r] == win_keys[l]) &
+                            (win_tags[r] < win_tags[l]));
+        win_keys[node] = right ? win_keys[r] : win_keys[l];
+        win_tags[node] = right ? win_tags[r] : win_tags[l];
+        keys[node]     = right ? win_keys[l] : win_keys[r];
+        tags[node]     = right ? win_tags[l] : win_tags[r];
+    }
+
+    value_type key = k > 1 ? win_keys[1] : keys[k];
+    size_type tag  = k > 1 ? win_tags[1] : tags[k];
+
+    for (size_type n = 0; n < total; n++)
+    {
+        *out = key;
+        ++out;
+
+        const size_type r = tag;
+        ++cur[r];
+        head(r, key, tag);
+
+        for (size_type node = (k + r) / 2; node > 0; node /= 2)
+        {
+            const value_type node_key = keys[node];
+            const size_type node_tag  = tags[node];
+            const bool swap =
+                (node_key < key) | ((node_key == key) & (node_tag < tag));
+            keys[node] = swap ? key : node_key;
+            tags[node] = swap ? tag : node_tag;
+            key        = swap ? node_key : key;
+            tag        = swap ? node_tag : tag;
+        }
+    }
+
+    return out;
+}
+
+/**
+ * @brief Merges sorted runs into an output iterator.
+ *
+ * @param runs Sequential container of sorted sequential containers, e.g. a
+ *             vector of std::span
+ * @param out  Output iterator
+ * @param comp Comparison object the runs are sorted by
+ *
+ * The merge is stable: equivalent elements keep the order of their runs.
+ * Arithmetic keys compared with std::less use a loser tree specialized for
+ * them, which caches the heads in the tree; any other type uses loser_tree.
+ * Returns the end of the output.
+ */
+template <typename Runs, typename OutputIter, typename Compare = std::less<>>
+requires RequireSequenceContainer<Runs> &&
+         RequireSequenceContainer<typename Runs::value_type> &&
+         std::output_iterator<OutputIter,
+                              typename Runs::value_type::value_type>
+OutputIter
+multiway_merge(const Runs &runs, OutputIter out, Compare comp = Compare())
+{
+    using value_type = typename Runs::value_type::value_type;
+    using iter_type  = decltype(__run_begin(runs[0]));
+
+    if constexpr (std::is_arithmetic_v<value_type> &&
+                  (std::is_same_v<Compare, std::less<>> ||
+                   std::is_same_v<Compare, std::less<value_type>>))
+        return __multiway_merge_arithmetic(runs, out);
+    else
+    {
+        vector<std::pair<iter_type, iter_type>> ranges;
+        ranges.reserve(runs.size());
+        for (std::size_t r = 0; r < runs.size(); r++)
+            ranges.push_back({__run_begin(runs[r]), __run_end(runs[r])});
+
+        loser_tree<iter_type, Compare> tree(ranges, comp);
+        for (; !tree.empty(); tree.pop())
+        {
+            *out = tree.top();
+            ++out;
+        }
+        return out;
+    }
+}
+
+/**
+ * @brief Merges sorted runs at the end of a %vector.
+ *
+ * @param runs Sequential container of sorted sequential containers
+ * @param res  Vector the merged elements are appended to
+ * @param comp Comparison object the runs are sorted by
+ */
+template <typename Runs, typename Compare = std::less<>>
+requires RequireSequenceContainer<Runs> &&
+         RequireSequenceContainer<typename Runs::value_type>
+void
+multiway_merge(const Runs &runs,
+               vector<typename Runs::value_type::value_type> &res,
+               Compare comp = Compare())
+{
+    std::size_t total = res.size();
+    for (std::size_t r = 0; r < runs.size(); r++)
+        total += runs[r].size();
+
+    res.reserve(total);
+    multiway_merge(runs, std::back_inserter(res), comp);
+}
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_MERGE_H */
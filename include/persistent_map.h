@@ -0,0 +1,821 @@
+/**
+ * @file persistent_map.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered map whose copies share their nodes, for cheap snapshots
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_PERSISTENT_MAP_H
+#define __OPENDSA_PERSISTENT_MAP_H 1
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "helper.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A node of a persistent tree, which might be shared by several trees.
+ *
+ * A node is immutable as long as it is shared. @a _refs counts the parents
+ * and the trees whose root it is.
+ */
+template <typename _Val>
+struct _Persistent_node
+{
+    std::atomic<std::size_t> _refs;
+    _Persistent_node *_left;
+    _Persistent_node *_right;
+    int _height;
+    _Val _value;
+
+    template <typename... Args>
+    _Persistent_node(Args &&...args)
+    : _refs(1), _left(nullptr), _right(nullptr), _height(1),
+      _value(std::forward<Args>(args)...)
+    {
+    }
+};
+
+/**
+ * @brief In-order iterator over a persistent tree.
+ *
+ * The nodes have no parent pointer, since a shared node has a parent in each
+ * tree, so the iterator keeps the stack of the nodes still to visit: the
+ * current node on top, and below it the ancestors whose left subtree holds
+ * the current node. The past-the-end position is the empty stack.
+ */
+template <typename _Val>
+struct _Persistent_tree_iterator
+{
+    using value_type        = _Val;
+    using reference         = const _Val &;
+    using pointer           = const _Val *;
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Persistent_node<_Val>;
+
+    // An AVL tree of n nodes is less than 1.45 log2(n + 2) high
+    constexpr static std::size_t _S_max_height =
+        3 * std::numeric_limits<std::size_t>::digits / 2;
+
+    const node_type *_stack[_S_max_height];
+    std::size_t _depth;
+
+    _Persistent_tree_iterator() noexcept : _depth(0) { }
+
+    reference
+    operator*() const noexcept
+    {
+        return _stack[_depth - 1]->_value;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return &_stack[_depth - 1]->_value;
+    }
+
+    _Persistent_tree_iterator &
+    operator++() noexcept
+    {
+        const node_type *x = _stack[--_depth]->_right;
+        _push_left(x);
+        return *this;
+    }
+
+    _Persistent_tree_iterator
+    operator++(int) noexcept
+    {
+        _Persistent_tree_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Persistent_tree_iterator &lhs,
+               const _Persistent_tree_iterator &rhs) noexcept
+    {
+        if (lhs._depth != rhs._depth)
+            return false;
+        return lhs._depth == 0 ||
+               lhs._stack[lhs._depth - 1] == rhs._stack[rhs._depth - 1];
+    }
+
+    void
+    _push(const node_type *x) noexcept
+    {
+        M_Assert(_depth < _S_max_height, "Tree is too high");
+        _stack[_depth++] = x;
+    }
+
+    /**
+     * @brief Pushes @a x and its chain of left descendants.
+     */
+    void
+    _push_left(const node_type *x) noexcept
+    {
+        for (; x != nullptr; x = x->_left)
+            _push(x);
+    }
+};
+
+/**
+ * @brief An ordered map of unique keys with O(1) snapshots.
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Tp      Type of the mapped values.
+ * @tparam _Compare Strict weak ordering of the keys.
+ * @tparam _Alloc   User-defined allocator.
+ *
+ * The map is an AVL tree whose nodes are reference counted and shared between
+ * the copies of a map: copying a map, or taking a snapshot(), only shares its
+ * root. A modification never writes to a shared node; it copies the nodes on
+ * the path from the root to the modified position instead, i.e. O(log n) new
+ * nodes, and the other copies keep seeing the old ones. A node that is owned
+ * by this map alone, which is the common case for a writer between two
+ * snapshots, is modified in place.
+ *
+ * Different copies can be used by different threads without any lock, e.g. a
+ * writer keeps updating its map while readers search older snapshots of it,
+ * since the reference counts are atomic and shared nodes are never modified.
+ * As for any container, a single map object must not be modified while
+ * another thread reads or copies it; the writer hands out snapshots itself.
+ *
+ * A modification first copies every shared node that it is going to modify,
+ * which is the only step that allocates, then relinks the nodes. If a copy
+ * throws, the map is left unchanged, provided that the comparison object does
+ * not throw.
+ *
+ * Since the nodes are immutable once shared, the iterators are readonly. The
+ * nodes are allocated one by one from @a _Alloc, as they outlive the map that
+ * allocated them when a snapshot still refers to them.
+ */
+template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<std::pair<const _Key, _Tp>>>
+class persistent_map
+{
+public:
+    using key_type        = _Key;
+    using mapped_type     = _Tp;
+    using value_type      = std::pair<const _Key, _Tp>;
+    using key_compare     = _Compare;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_iterator  = _Persistent_tree_iterator<value_type>;
+    using iterator        = const_iterator;
+
+private:
+    using _Node      = _Persistent_node<value_type>;
+    using _Node_ptr  = _Node *;
+    using _Const_ptr = const _Node *;
+
+    using _Node_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Node>;
+    using _Node_alloc_traits = std::allocator_traits<_Node_alloc_type>;
+
+public:
+    /**
+     * @brief Creates an empty %persistent_map.
+     */
+    persistent_map() : _comp(), _alloc(), _root(nullptr), _count(0) { }
+
+    /**
+     * @brief Creates an empty %persistent_map with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit persistent_map(const _Compare &comp,
+                            const _Alloc &alloc = _Alloc())
+    : _comp(comp), _alloc(alloc), _root(nullptr), _count(0)
+    {
+    }
+
+    /**
+     * @brief Creates a %persistent_map based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    persistent_map(std::initializer_list<value_type> list,
+                   const _Compare &comp = _Compare(),
+                   const _Alloc &alloc  = _Alloc())
+    : persistent_map(comp, alloc)
+    {
+        for (const value_type &v : list)
+            insert(v);
+    }
+
+    /**
+     * @brief Creates a %persistent_map sharing the nodes of @a other in O(1).
+     */
+    persistent_map(const persistent_map &other) noexcept
+    : _comp(other._comp), _alloc(other._alloc), _root(other._root),
+      _count(other._count)
+    {
+        _retain(_root);
+    }
+
+    persistent_map(persistent_map &&other) noexcept
+    : _comp(other._comp), _alloc(other._alloc), _root(other._root),
+      _count(other._count)
+    {
+        other._root  = nullptr;
+        other._count = 0;
+    }
+
+    ~persistent_map() { _release(_root); }
+
+    persistent_map &
+    operator=(const persistent_map &other) noexcept
+    {
+        persistent_map tmp(other);
+        swap(tmp);
+        return *this;
+    }
+
+    persistent_map &
+    operator=(persistent_map &&other) noexcept
+    {
+        persistent_map tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    /**
+     * @brief Returns a copy of the %persistent_map in O(1).
+     *
+     * The snapshot is not affected by later modifications of this map, and
+     * vice versa.
+     */
+    persistent_map
+    snapshot() const noexcept
+    {
+        return *this;
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _comp;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_alloc);
+    }
+
+    // Iterators
+
+    const_iterator
+    begin() const noexcept
+    {
+        const_iterator it;
+        it._push_left(_root);
+        return it;
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return end();
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _count == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _count;
+    }
+
+    // Element access
+
+    /**
+     * @brief Returns the value mapped to @a k, or throws std::out_of_range.
+     */
+    const mapped_type &
+    at(const key_type &k) const
+    {
+        _Const_ptr x = _find(k);
+        if (x == nullptr)
+            throw std::out_of_range("persistent_map::at");
+        return x->_value.second;
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts @a x unless an equivalent key already exists.
+     *
+     * Returns whether the insertion took place.
+     */
+    bool
+    insert(const value_type &x)
+    {
+        return try_emplace(x.first, x.second);
+    }
+
+    bool
+    insert(value_type &&x)
+    {
+        return try_emplace(x.first, std::move(x.second));
+    }
+
+    /**
+     * @brief Inserts an element with key @a k and a value constructed from
+     * @a args, unless the key already exists.
+     *
+     * Returns whether the insertion took place. Nothing is copied if the key
+     * exists.
+     */
+    template <typename... Args>
+    bool
+    try_emplace(const key_type &k, Args &&...args)
+    {
+        if (_find(k) != nullptr)
+            return false;
+
+        _Node_ptr z = _create_node(std::piecewise_construct,
+                                   std::forward_as_tuple(k),
+                                   std::forward_as_tuple(
+                                       std::forward<Args>(args)...));
+
+        try
+        {
+            _prepare_path(k, false);
+        }
+        catch (...)
+        {
+            _release(z);
+            throw;
+        }
+
+        _root = _insert(_root, z);
+        ++_count;
+        return true;
+    }
+
+    /**
+     * @brief Inserts a new element or assigns to the existing one.
+     *
+     * Returns true if a new element was inserted.
+     */
+    template <typename _Obj>
+    bool
+    insert_or_assign(const key_type &k, _Obj &&obj)
+    {
+        _Node_ptr x = _prepare_path(k, false);
+        if (x != nullptr)
+        {
+            x->_value.second = std::forward<_Obj>(obj);
+            return false;
+        }
+
+        // The path is already modifiable
+        _Node_ptr z = _create_node(k, std::forward<_Obj>(obj));
+        _root       = _insert(_root, z);
+        ++_count;
+        return true;
+    }
+
+    /**
+     * @brief Removes the element with key @a k, if any, and returns the
+     * number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        if (_find(k) == nullptr)
+            return 0;
+
+        _prepare_path(k, true);
+        _root = _erase(_root, k);
+        --_count;
+        return 1;
+    }
+
+    /**
+     * @brief Removes every element. The nodes still shared with other copies
+     * are left to them.
+     */
+    void
+    clear() noexcept
+    {
+        _release(_root);
+        _root  = nullptr;
+        _count = 0;
+    }
+
+    void
+    swap(persistent_map &other) noexcept
+    {
+        std::swap(_comp, other._comp);
+        std::swap(_alloc, other._alloc);
+        std::swap(_root, other._root);
+        std::swap(_count, other._count);
+    }
+
+    // Lookup
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        const_iterator it = lower_bound(k);
+        if (it == end() || _comp(k, it->first))
+            return end();
+        return it;
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _find(k) != nullptr;
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the first element whose key is not less than @a k.
+     */
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        const_iterator it;
+        for (_Const_ptr x = _root; x != nullptr;)
+        {
+            if (!_comp(x->_value.first, k))
+            {
+                it._push(x);
+                x = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+        return it;
+    }
+
+    /**
+     * @brief Returns the first element whose key is greater than @a k.
+     */
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        const_iterator it;
+        for (_Const_ptr x = _root; x != nullptr;)
+        {
+            if (_comp(k, x->_value.first))
+            {
+                it._push(x);
+                x = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+        return it;
+    }
+
+private:
+    _Compare _comp;
+    _Node_alloc_type _alloc;
+    _Node_ptr _root;
+    size_type _count;
+
+    static void
+    _retain(_Node_ptr x) noexcept
+    {
+        if (x != nullptr)
+            x->_refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Drops a reference to @a x, and frees it along with the references it
+     * holds to its children if that was the last one.
+     */
+    void
+    _release(_Node_ptr x) noexcept
+    {
+        while (x != nullptr &&
+               x->_refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            _release(x->_left);
+            _Node_ptr right = x->_right;
+            _Node_alloc_traits::destroy(_alloc, x);
+            _Node_alloc_traits::deallocate(_alloc, x, 1);
+            x = right;
+        }
+    }
+
+    template <typename... Args>
+    _Node_ptr
+    _create_node(Args &&...args)
+    {
+        _Node_ptr z = _Node_alloc_traits::allocate(_alloc, 1);
+
+        try
+        {
+            _Node_alloc_traits::construct(_alloc, z,
+                                          std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            _Node_alloc_traits::deallocate(_alloc, z, 1);
+            throw;
+        }
+
+        return z;
+    }
+
+    /**
+     * Makes the node in @a slot, to which this map holds a reference,
+     * modifiable in place: it is kept if nobody else refers to it, otherwise
+     * it is replaced by a copy that refers to the same children.
+     *
+     * The modifications go down from the root, so by the time a node is
+     * reached its parent is owned by this map alone. A node of another map is
+     * thus always seen with at least two references. A throwing copy leaves
+     * the content of the map unchanged.
+     */
+    void
+    _make_mutable(_Node_ptr &slot)
+    {
+        if (slot == nullptr ||
+            slot->_refs.load(std::memory_order_acquire) == 1)
+            return;
+
+        _Node_ptr x = slot;
+        _Node_ptr y = _create_node(x->_value);
+        y->_left    = x->_left;
+        y->_right   = x->_right;
+        y->_height  = x->_height;
+        _retain(y->_left);
+        _retain(y->_right);
+        _release(x);
+        slot = y;
+    }
+
+    /**
+     * Makes the nodes on the path to @a k modifiable, as well as, when
+     * @a for_erase, the nodes that the rebalancing after a removal might
+     * rotate: at each node of the path, the other child and its child on the
+     * side of the path. A rebalancing after an insertion only rotates nodes
+     * of the path.
+     *
+     * Returns the node with key @a k, or null if there is none. This is the
+     * only step of a modification that might throw. The tree is then relinked
+     * without any allocation.
+     */
+    _Node_ptr
+    _prepare_path(const key_type &k, bool for_erase)
+    {
+        _Node_ptr *slot = &_root;
+        _Node_ptr found = nullptr;
+
+        while (*slot != nullptr)
+        {
+            _make_mutable(*slot);
+            _Node_ptr x = *slot;
+            bool left;
+
+            if (found != nullptr || _comp(k, x->_value.first))
+                left = true;
+            else if (_comp(x->_value.first, k))
+                left = false;
+            else
+            {
+                // A removed node with two children is replaced by its
+                // successor, the leftmost node of its right subtree
+                if (!for_erase || x->_left == nullptr || x->_right == nullptr)
+                    return x;
+                found = x;
+                left  = false;
+            }
+
+            if (for_erase && left)
+            {
+                _make_mutable(x->_right);
+                if (x->_right != nullptr)
+                    _make_mutable(x->_right->_left);
+            }
+            else if (for_erase)
+            {
+                _make_mutable(x->_left);
+                if (x->_left != nullptr)
+                    _make_mutable(x->_left->_right);
+            }
+
+            slot = left ? &x->_left : &x->_right;
+        }
+
+        return found;
+    }
+
+    _Const_ptr
+    _find(const key_type &k) const
+    {
+        _Const_ptr x = _root;
+        while (x != nullptr)
+        {
+            if (_comp(k, x->_value.first))
+                x = x->_left;
+            else if (_comp(x->_value.first, k))
+                x = x->_right;
+            else
+                return x;
+        }
+        return nullptr;
+    }
+
+    static int
+    _height(_Const_ptr x) noexcept
+    {
+        return x == nullptr ? 0 : x->_height;
+    }
+
+    static void
+    _update_height(_Node_ptr x) noexcept
+    {
+        x->_height = 1 + std::max(_height(x->_left), _height(x->_right));
+    }
+
+    static bool
+    _is_mutable(_Const_ptr x) noexcept
+    {
+        return x->_refs.load(std::memory_order_relaxed) == 1;
+    }
+
+    /**
+     * Rotates the subtree of @a x to the right and returns its new root.
+     */
+    static _Node_ptr
+    _rotate_right(_Node_ptr x) noexcept
+    {
+        _Node_ptr y = x->_left;
+        M_Assert(_is_mutable(x) && _is_mutable(y), "Rotating a shared node");
+        x->_left  = y->_right;
+        y->_right = x;
+        _update_height(x);
+        _update_height(y);
+        return y;
+    }
+
+    static _Node_ptr
+    _rotate_left(_Node_ptr x) noexcept
+    {
+        _Node_ptr y = x->_right;
+        M_Assert(_is_mutable(x) && _is_mutable(y), "Rotating a shared node");
+        x->_right = y->_left;
+        y->_left  = x;
+        _update_height(x);
+        _update_height(y);
+        return y;
+    }
+
+    /**
+     * Restores the AVL invariant at @a x, whose subtrees differ in height by
+     * two at most, and returns the new root of its subtree.
+     */
+    static _Node_ptr
+    _rebalance(_Node_ptr x) noexcept
+    {
+        const int balance = _height(x->_left) - _height(x->_right);
+
+        if (balance > 1)
+        {
+            if (_height(x->_left->_left) < _height(x->_left->_right))
+                x->_left = _rotate_left(x->_left);
+            return _rotate_right(x);
+        }
+
+        if (balance < -1)
+        {
+            if (_height(x->_right->_right) < _height(x->_right->_left))
+                x->_right = _rotate_right(x->_right);
+            return _rotate_left(x);
+        }
+
+        _update_height(x);
+        return x;
+    }
+
+    /**
+     * Links the new node @a z, whose key is not in the subtree of @a x yet,
+     * and returns the new root of the subtree.
+     */
+    _Node_ptr
+    _insert(_Node_ptr x, _Node_ptr z)
+    {
+        if (x == nullptr)
+            return z;
+
+        if (_comp(z->_value.first, x->_value.first))
+            x->_left = _insert(x->_left, z);
+        else
+            x->_right = _insert(x->_right, z);
+
+        return _rebalance(x);
+    }
+
+    /**
+     * Unlinks the leftmost node of the subtree of @a x into @a min, and
+     * returns the new root of the subtree.
+     */
+    static _Node_ptr
+    _erase_min(_Node_ptr x, _Node_ptr &min) noexcept
+    {
+        if (x->_left == nullptr)
+        {
+            _Node_ptr right = x->_right;
+            x->_right       = nullptr;
+            min             = x;
+            return right;
+        }
+
+        x->_left = _erase_min(x->_left, min);
+        return _rebalance(x);
+    }
+
+    /**
+     * Removes the node with key @a k, which is in the subtree of @a x, and
+     * returns the new root of the subtree.
+     */
+    _Node_ptr
+    _erase(_Node_ptr x, const key_type &k)
+    {
+        if (_comp(k, x->_value.first))
+        {
+            x->_left = _erase(x->_left, k);
+            return _rebalance(x);
+        }
+        if (_comp(x->_value.first, k))
+        {
+            x->_right = _erase(x->_right, k);
+            return _rebalance(x);
+        }
+
+        // The references of x to its children move to its replacement
+        _Node_ptr left  = x->_left;
+        _Node_ptr right = x->_right;
+        x->_left        = nullptr;
+        x->_right       = nullptr;
+        _release(x);
+
+        if (left == nullptr || right == nullptr)
+            return left == nullptr ? right : left;
+
+        // Put the successor of x in its place. The keys are const, so the
+        // node is moved rather than the value.
+        _Node_ptr min = nullptr;
+        right         = _erase_min(right, min);
+        min->_left    = left;
+        min->_right   = right;
+        return _rebalance(min);
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_PERSISTENT_MAP_H */
@@ -0,0 +1,396 @@
+/**
+ * @file pool.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Pool allocators for fixed-size nodes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_POOL_H
+#define __OPENDSA_POOL_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "helper.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A pool of uninitialized objects of the same type.
+ *
+ * @tparam _Tp    Type of the objects handed out by the pool.
+ * @tparam _Alloc Allocator used to get the blocks.
+ *
+ * The pool carves objects out of blocks that double in size, from 8 slots up
+ * to about 64 KiB. Deallocated slots are kept in an intrusive free list and
+ * handed out again before the current block is used, so consecutive
+ * allocations end up next to each other in memory. The blocks are only
+ * returned to @a _Alloc by release() or when the pool is destroyed, which
+ * costs one deallocation per block rather than one per object.
+ *
+ * The pool never constructs nor destroys an object: allocate() returns raw
+ * storage, and every object must be destroyed by the caller before its slot
+ * is deallocated or the pool is released. For the same reason, a pool cannot
+ * move its objects to blocks from another allocator: move assignment and
+ * swap take the blocks along with the objects, so the allocators must be
+ * equal unless they propagate.
+ */
+template <typename _Tp, typename _Alloc = std::allocator<_Tp>>
+class node_pool
+{
+private:
+    struct _Block
+    {
+        _Block *_next;
+        std::size_t _count;
+    };
+
+    union _Slot
+    {
+        _Slot *_next; // Next free slot
+        _Block _block;
+        alignas(_Tp) unsigned char _storage[sizeof(_Tp)];
+    };
+
+    using _Slot_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Slot>;
+    using _Slot_alloc_traits = std::allocator_traits<_Slot_alloc_type>;
+    using _Propagate_on_move =
+        typename _Slot_alloc_traits::propagate_on_container_move_assignment;
+    using _Propagate_on_swap =
+        typename _Slot_alloc_traits::propagate_on_container_swap;
+
+public:
+    using value_type     = _Tp;
+    using pointer        = _Tp *;
+    using size_type      = std::size_t;
+    using allocator_type = _Alloc;
+
+    /**
+     * @brief Creates an empty %node_pool.
+     */
+    node_pool() : node_pool(_Alloc()) { }
+
+    /**
+     * @brief Creates an empty %node_pool with a given allocator.
+     *
+     * @param alloc Allocator object used to get the blocks.
+     */
+    explicit node_pool(const _Alloc &alloc)
+    : _alloc(alloc), _blocks(nullptr), _free(nullptr), _cur(nullptr),
+      _end(nullptr), _next_count(_S_min_count)
+    {
+    }
+
+    node_pool(const node_pool &other) = delete;
+
+    /**
+     * @brief Creates a %node_pool by stealing the blocks of another one.
+     *
+     * Objects allocated from @a other now belong to this pool.
+     */
+    node_pool(node_pool &&other) noexcept
+    : _alloc(std::move(other._alloc)), _blocks(other._blocks),
+      _free(other._free), _cur(other._cur), _end(other._end),
+      _next_count(other._next_count)
+    {
+        other._reset();
+    }
+
+    ~node_pool() { release(); }
+
+    node_pool &
+    operator=(const node_pool &other) = delete;
+
+    /**
+     * @brief Takes the blocks of another pool, and its allocator if it
+     * propagates on move assignment. Otherwise the allocators must be equal.
+     */
+    node_pool &
+    operator=(node_pool &&other) noexcept
+    {
+        if (&other != this)
+        {
+            release();
+            if constexpr (_Propagate_on_move::value)
+                _alloc = std::move(other._alloc);
+            else
+                M_Assert(_alloc == other._alloc,
+                         "The pools must have equal allocators");
+            _steal(other);
+        }
+
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_alloc);
+    }
+
+    /**
+     * @brief Returns uninitialized storage for one object.
+     */
+    pointer
+    allocate()
+    {
+        _Slot *slot;
+
+        if (_free != nullptr)
+        {
+            slot  = _free;
+            _free = slot->_next;
+        }
+        else
+        {
+            if (_cur == _end)
+                _grow();
+            slot = _cur++;
+        }
+
+        return reinterpret_cast<pointer>(slot->_storage);
+    }
+
+    /**
+     * @brief Gives the storage of an object back to the pool.
+     *
+     * @param p Pointer returned by allocate() on this pool. The object must
+     *          have been destroyed already.
+     */
+    void
+    deallocate(pointer p) noexcept
+    {
+        _Slot *slot = reinterpret_cast<_Slot *>(p);
+        slot->_next = _free;
+        _free       = slot;
+    }
+
+    /**
+     * @brief Returns every block to the allocator at once.
+     *
+     * Every pointer handed out by this pool becomes invalid.
+     */
+    void
+    release() noexcept
+    {
+        while (_blocks != nullptr)
+        {
+            _Block *next = _blocks->_next;
+            _Slot_alloc_traits::deallocate(_alloc,
+                                           reinterpret_cast<_Slot *>(_blocks),
+                                           _blocks->_count + 1);
+            _blocks = next;
+        }
+
+        _reset();
+    }
+
+    /**
+     * @brief Returns every block to the allocator, then uses a copy of
+     * @a alloc for the next ones.
+     */
+    void
+    release(const _Alloc &alloc) noexcept
+    {
+        release();
+        _alloc = _Slot_alloc_type(alloc);
+    }
+
+    /**
+     * @brief Swaps the blocks of two pools, and their allocators if they
+     * propagate on swap. Otherwise the allocators must be equal.
+     */
+    void
+    swap(node_pool &other) noexcept
+    {
+        if constexpr (_Propagate_on_swap::value)
+            std::swap(_alloc, other._alloc);
+        else
+            M_Assert(_alloc == other._alloc,
+                     "The pools must have equal allocators");
+        std::swap(_blocks, other._blocks);
+        std::swap(_free, other._free);
+        std::swap(_cur, other._cur);
+        std::swap(_end, other._end);
+        std::swap(_next_count, other._next_count);
+    }
+
+private:
+    constexpr static size_type _S_min_count = 8;
+    constexpr static size_type _S_max_count =
+        std::max(_S_min_count, size_type(65536) / sizeof(_Slot));
+
+    _Slot_alloc_type _alloc;
+    _Block *_blocks; // Every block, the most recent first
+    _Slot *_free;    // Free list of deallocated slots
+    _Slot *_cur;     // Next untouched slot of the most recent block
+    _Slot *_end;
+    size_type _next_count;
+
+    void
+    _reset() noexcept
+    {
+        _blocks     = nullptr;
+        _free       = nullptr;
+        _cur        = nullptr;
+        _end        = nullptr;
+        _next_count = _S_min_count;
+    }
+
+    void
+    _steal(node_pool &other) noexcept
+    {
+        _blocks     = other._blocks;
+        _free       = other._free;
+        _cur        = other._cur;
+        _end        = other._end;
+        _next_count = other._next_count;
+        other._reset();
+    }
+
+    /**
+     * Allocates a new block. Its first slot holds the link to the previous
+     * block and the number of usable slots.
+     */
+    void
+    _grow()
+    {
+        const size_type count = _next_count;
+        _Slot *block = _Slot_alloc_traits::allocate(_alloc, count + 1);
+
+        block->_block._next  = _blocks;
+        block->_block._count = count;
+        _blocks              = &block->_block;
+
+        _cur        = block + 1;
+        _end        = block + 1 + count;
+        _next_count = std::min(count * 2, _S_max_count);
+    }
+};
+
+/**
+ * @brief An allocator backed by a thread-local %node_pool.
+ *
+ * @tparam _Tp Type of the allocated objects.
+ *
+ * Single objects come from a pool owned by the calling thread, so node-based
+ * containers such as std::map or std::list get the locality of a pool without
+ * any change. Arrays are forwarded to std::allocator.
+ *
+ * A single object must be deallocated by the thread that allocated it, since
+ * it goes back to the pool of the calling thread. An allocator is bound to
+ * the thread that created it, and two allocators are only equal if they are
+ * bound to the same thread, so a container does not take nodes from one of
+ * another thread. A copy of a container gets an allocator of the copying
+ * thread. A thread only gives its blocks back when it exits with no object
+ * of its pool still alive; otherwise the blocks are kept until the end of
+ * the process.
+ */
+template <typename _Tp>
+class pool_allocator
+{
+public:
+    using value_type      = _Tp;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    pool_allocator() noexcept : _thread(std::this_thread::get_id()) { }
+
+    template <typename _Up>
+    pool_allocator(const pool_allocator<_Up> &other) noexcept
+    : _thread(other._thread)
+    {
+    }
+
+    /**
+     * @brief Returns an allocator of the calling thread for a copy of a
+     * container.
+     */
+    pool_allocator
+    select_on_container_copy_construction() const noexcept
+    {
+        return pool_allocator();
+    }
+
+    _Tp *
+    allocate(size_type n)
+    {
+        if (n != 1)
+            return std::allocator<_Tp>().allocate(n);
+
+        M_Assert(_thread == std::this_thread::get_id(),
+                 "The allocator belongs to another thread");
+
+        _Local_pool &local = _S_local();
+        _Tp *p             = local._pool->allocate();
+        local._live++;
+        return p;
+    }
+
+    void
+    deallocate(_Tp *p, size_type n) noexcept
+    {
+        if (n != 1)
+        {
+            std::allocator<_Tp>().deallocate(p, n);
+            return;
+        }
+
+        M_Assert(_thread == std::this_thread::get_id(),
+                 "The allocator belongs to another thread");
+
+        _Local_pool &local = _S_local();
+        local._pool->deallocate(p);
+        local._live--;
+    }
+
+    friend bool
+    operator==(const pool_allocator &lhs, const pool_allocator &rhs) noexcept
+    {
+        return lhs._thread == rhs._thread;
+    }
+
+private:
+    template <typename _Up>
+    friend class pool_allocator;
+
+    std::thread::id _thread;
+
+    struct _Local_pool
+    {
+        node_pool<_Tp> *_pool = new node_pool<_Tp>();
+        difference_type _live = 0;
+
+        // Containers with static storage duration are destroyed after the
+        // thread-local pools of the main thread, so the blocks can only be
+        // freed if nothing points into them anymore.
+        ~_Local_pool()
+        {
+            if (_live == 0)
+                delete _pool;
+        }
+    };
+
+    static _Local_pool &
+    _S_local()
+    {
+        thread_local _Local_pool local;
+        return local;
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_POOL_H */
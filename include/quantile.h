@@ -0,0 +1,479 @@
+/**
+ * @file quantile.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A mergeable sketch of the quantiles of a stream in bounded memory
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_QUANTILE_H
+#define __OPENDSA_QUANTILE_H 1
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A KLL sketch, which estimates the quantiles of a stream of values in
+ * bounded memory.
+ *
+ * @tparam _Tp      Type of the values.
+ * @tparam _Compare Strict weak ordering of the values.
+ *
+ * The sketch is a stack of compactors. The values enter level 0, and each
+ * value retained at level h stands for 2^h values of the stream. When the
+ * sketch is full, the lowest level over its capacity is compacted: it is
+ * sorted, and every other value, starting at a random offset, is promoted to
+ * the next level while the others are discarded. The top levels have a
+ * capacity of k values and each level below two thirds of the one above, down
+ * to a minimum of 8, so the sketch retains about 3k values plus a few per
+ * level, i.e. O(k + log n) for a stream of n values.
+ *
+ * The rank of a value, and thus the value at a given quantile, is estimated
+ * with an error of about 1.7% of n for k = 200 with high probability, and the
+ * error scales as 1 / k. Two sketches of the same k are merged by stacking
+ * their levels, e.g. one sketch per thread combined when they are read, and
+ * the merged sketch has the same guarantees as a single one fed with both
+ * streams. A sketch itself is not synchronized.
+ *
+ * The smallest and largest values of the stream are kept exactly.
+ */
+template <typename _Tp, typename _Compare = std::less<_Tp>>
+class kll_sketch
+{
+public:
+    using value_type  = _Tp;
+    using size_type   = std::size_t;
+    using key_compare = _Compare;
+
+    /**
+     * @brief Default capacity of the top levels.
+     */
+    constexpr static size_type _S_default_k = 200;
+
+    /**
+     * @brief Creates an empty %kll_sketch.
+     *
+     * @param k    Capacity of the top levels, at least 8. Larger values are
+     *             more accurate and take more memory.
+     * @param seed Seed of the random offsets of the compactions.
+     * @param comp Comparison object.
+     */
+    explicit kll_sketch(size_type k = _S_default_k,
+                        std::uint64_t seed = 0x9e3779b97f4a7c15ULL,
+                        const _Compare &comp = _Compare())
+    : _comp(comp), _k(std::max(k, _S_min_width)), _count(0), _retained(0),
+      _capacity(0), _state(seed | 1), _height(0), _levels(), _level_caps(),
+      _min(), _max()
+    {
+        _add_level();
+    }
+
+    kll_sketch(const kll_sketch &other) = default;
+
+    kll_sketch(kll_sketch &&other) noexcept = default;
+
+    kll_sketch &
+    operator=(const kll_sketch &other)
+    {
+        if (&other != this)
+        {
+            kll_sketch tmp(other);
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    kll_sketch &
+    operator=(kll_sketch &&other) noexcept
+    {
+        if (&other != this)
+        {
+            kll_sketch tmp(std::move(other));
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _count == 0;
+    }
+
+    /**
+     * @brief Returns the number of values of the stream.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _count;
+    }
+
+    /**
+     * @brief Returns the number of values held by the sketch.
+     */
+    size_type
+    retained() const noexcept
+    {
+        return _retained;
+    }
+
+    size_type
+    k() const noexcept
+    {
+        return _k;
+    }
+
+    // Modifiers
+
+    void
+    insert(const value_type &x)
+    {
+        _track(x);
+        _levels[0].push_back(x);
+        _count++;
+        if (++_retained >= _capacity)
+            _compress();
+    }
+
+    /**
+     * @brief Inserts a range of values.
+     */
+    template <std::input_iterator _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    /**
+     * @brief Inserts the values of a %vector, e.g. a batch of samples.
+     *
+     * Level 0 is filled up to its free space at once, and the sketch is only
+     * compressed when it is full.
+     */
+    void
+    insert(const vector<value_type> &batch)
+    {
+        for (size_type i = 0; i < batch.size();)
+        {
+            const size_type room = std::min(_capacity - _retained,
+                                            batch.size() - i);
+            for (size_type j = i; j < i + room; j++)
+            {
+                _track(batch[j]);
+                _levels[0].push_back(batch[j]);
+            }
+
+            i += room;
+            _count += room;
+            _retained += room;
+            if (_retained >= _capacity)
+                _compress();
+        }
+    }
+
+    /**
+     * @brief Adds the values of @a other to this sketch.
+     *
+     * Both sketches must have the same k. A sketch merged into itself counts
+     * its values twice.
+     */
+    void
+    merge(const kll_sketch &other)
+    {
+        M_Assert(other._k == _k, "Merging sketches of different sizes");
+        if (other.empty())
+            return;
+
+        // The levels are appended to while they are read
+        if (&other == this)
+        {
+            const kll_sketch copy(other);
+            merge(copy);
+            return;
+        }
+
+        while (_height < other._height)
+            _add_level();
+
+        for (size_type h = 0; h < other._height; h++)
+        {
+            const vector<value_type> &src = other._levels[h];
+            for (size_type i = 0; i < src.size(); i++)
+                _levels[h].push_back(src[i]);
+        }
+
+        _track(other._min);
+        _track(other._max);
+        _count += other._count;
+        _retained += other._retained;
+        _compress();
+    }
+
+    void
+    clear()
+    {
+        kll_sketch tmp(_k, _state, _comp);
+        swap(tmp);
+    }
+
+    void
+    swap(kll_sketch &other) noexcept
+    {
+        std::swap(_comp, other._comp);
+        std::swap(_k, other._k);
+        std::swap(_count, other._count);
+        std::swap(_retained, other._retained);
+        std::swap(_capacity, other._capacity);
+        std::swap(_state, other._state);
+        std::swap(_height, other._height);
+        std::swap(_level_caps, other._level_caps);
+        for (size_type h = 0; h < _S_max_levels; h++)
+            _levels[h].swap(other._levels[h]);
+        std::swap(_min, other._min);
+        std::swap(_max, other._max);
+    }
+
+    // Queries
+
+    /**
+     * @brief Returns the smallest value of the stream.
+     */
+    const value_type &
+    min() const noexcept
+    {
+        M_Assert(!empty(), "The sketch is empty");
+        return _min;
+    }
+
+    /**
+     * @brief Returns the largest value of the stream.
+     */
+    const value_type &
+    max() const noexcept
+    {
+        M_Assert(!empty(), "The sketch is empty");
+        return _max;
+    }
+
+    /**
+     * @brief Estimates the number of values of the stream that are less
+     * than @a x.
+     */
+    size_type
+    rank(const value_type &x) const
+    {
+        size_type res = 0;
+        for (size_type h = 0; h < _height; h++)
+        {
+            const vector<value_type> &level = _levels[h];
+            for (size_type i = 0; i < level.size(); i++)
+                if (_comp(level[i], x))
+                    res += size_type(1) << h;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Estimates the value at the quantile @a q of the stream.
+     *
+     * The value is the one of rank ceil(q * n) - 1 in the stream, as for a
+     * percentile of nearest rank. The quantiles 0 and 1 are the exact
+     * smallest and largest values. The sketch must not be empty.
+     */
+    value_type
+    quantile(double q) const
+    {
+        return quantiles(vector<double>{q})[0];
+    }
+
+    /**
+     * @brief Estimates the values at several quantiles, in the order of
+     * @a fractions, sorting the retained values once.
+     */
+    vector<value_type>
+    quantiles(const vector<double> &fractions) const
+    {
+        M_Assert(!empty(), "The sketch is empty");
+
+        // The retained values in order, with the cumulated weights
+        vector<std::pair<value_type, size_type>> sorted;
+        sorted.reserve(_retained);
+        for (size_type h = 0; h < _height; h++)
+            for (size_type i = 0; i < _levels[h].size(); i++)
+                sorted.push_back({_levels[h][i], size_type(1) << h});
+
+        std::sort(sorted.begin(), sorted.end(),
+                  [this](const auto &a, const auto &b)
+                  { return _comp(a.first, b.first); });
+        for (size_type i = 1; i < sorted.size(); i++)
+            sorted[i].second += sorted[i - 1].second;
+
+        // A compaction halves the values and doubles their weight, so the
+        // weights still sum up to n
+        const double total = static_cast<double>(_count);
+        vector<value_type> res;
+        res.reserve(fractions.size());
+        for (size_type i = 0; i < fractions.size(); i++)
+        {
+            const double q = fractions[i];
+            if (q <= 0)
+            {
+                res.push_back(_min);
+                continue;
+            }
+            if (q >= 1)
+            {
+                res.push_back(_max);
+                continue;
+            }
+
+            const size_type rank =
+                static_cast<size_type>(std::ceil(q * total));
+            auto it = std::lower_bound(
+                sorted.cbegin(), sorted.cend(), rank,
+                [](const auto &a, size_type r) { return a.second < r; });
+            res.push_back(it == sorted.cend() ? _max : it->first);
+        }
+
+        return res;
+    }
+
+private:
+    constexpr static size_type _S_min_width = 8;
+
+    // A value at level h stands for 2^h values, which a size_type counts
+    constexpr static size_type _S_max_levels =
+        std::numeric_limits<size_type>::digits;
+
+    _Compare _comp;
+    size_type _k;
+    size_type _count;
+    size_type _retained;
+    size_type _capacity; // Sum of the capacities of the levels
+    std::uint64_t _state;
+    size_type _height;
+    vector<value_type> _levels[_S_max_levels];
+    size_type _level_caps[_S_max_levels];
+    value_type _min;
+    value_type _max;
+
+    void
+    _track(const value_type &x)
+    {
+        if (_count == 0)
+        {
+            _min = x;
+            _max = x;
+        }
+        else if (_comp(x, _min))
+            _min = x;
+        else if (_comp(_max, x))
+            _max = x;
+    }
+
+    /**
+     * Adds a level on top. The capacity of a level is k * (2/3)^depth, where
+     * depth is its distance to the top level, so every capacity changes.
+     */
+    void
+    _add_level()
+    {
+        M_Assert(_height < _S_max_levels, "Too many levels");
+        _height++;
+
+        _capacity = 0;
+        for (size_type h = 0; h < _height; h++)
+        {
+            const size_type depth = _height - 1 - h;
+            const double cap =
+                static_cast<double>(_k) *
+                std::pow(2.0 / 3, static_cast<double>(depth));
+            _level_caps[h] =
+                std::max(_S_min_width, static_cast<size_type>(cap));
+            _capacity += _level_caps[h];
+        }
+    }
+
+    // xorshift64, for the offsets of the compactions
+    bool
+    _coin() noexcept
+    {
+        _state ^= _state << 13;
+        _state ^= _state >> 7;
+        _state ^= _state << 17;
+        return _state >> 63;
+    }
+
+    /**
+     * Compacts the lowest levels over their capacity until the sketch fits.
+     * A level full up to the top adds a level, which raises the capacity of
+     * all the others.
+     */
+    void
+    _compress()
+    {
+        while (_retained >= _capacity)
+        {
+            size_type h = 0;
+            while (_levels[h].size() < _level_caps[h])
+                h++;
+
+            if (h + 1 == _height)
+                _add_level();
+            _compact(h);
+        }
+    }
+
+    /**
+     * Promotes every other value of the sorted level @a h to the next level.
+     * With an odd number of values, the largest one stays at level @a h.
+     */
+    void
+    _compact(size_type h)
+    {
+        vector<value_type> &level = _levels[h];
+        vector<value_type> &next  = _levels[h + 1];
+
+        std::sort(level.begin(), level.end(), _comp);
+        const size_type pairs = level.size() / 2;
+        const size_type start = _coin() ? 1 : 0;
+        for (size_type i = 0; i < pairs; i++)
+            next.push_back(level[2 * i + start]);
+
+        if (level.size() % 2 == 1)
+        {
+            value_type last = level.back();
+            level.clear();
+            level.push_back(last);
+        }
+        else
+            level.clear();
+
+        _retained -= pairs;
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_QUANTILE_H */
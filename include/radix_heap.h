@@ -0,0 +1,273 @@
+/**
+ * @file radix_heap.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A monotone priority queue for integer keys
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_RADIX_HEAP_H
+#define __OPENDSA_RADIX_HEAP_H 1
+
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A monotone min-priority queue keyed by integers.
+ *
+ * @tparam _Key Integral type of the keys.
+ * @tparam _Tp  Type of the values attached to each key.
+ *
+ * A radix heap keeps its elements in bit-width + 1 buckets. Bucket 0 holds the
+ * elements whose key equals the last extracted minimum and bucket i holds the
+ * elements whose key differs from it first at bit i - 1. An element only ever
+ * moves to a lower bucket, so push() is O(1) and pop() is amortized
+ * O(log C), where C is the range of the keys.
+ *
+ * The heap is monotone: a pushed key must not be smaller than the key most
+ * recently returned by top(). This is always the case for Dijkstra's algorithm
+ * and for discrete event simulations.
+ */
+template <typename _Key, typename _Tp>
+requires std::integral<_Key>
+class radix_heap
+{
+public:
+    using key_type        = _Key;
+    using mapped_type     = _Tp;
+    using value_type      = std::pair<_Key, _Tp>;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = std::size_t;
+    using container_type  = opendsa::vector<value_type>;
+
+    /**
+     * @brief Constructs an empty %radix_heap.
+     */
+    radix_heap() : _buckets(), _size(0), _last(0) { }
+
+    /**
+     * @brief Constructs a %radix_heap by copying an existing one.
+     *
+     * @param other Another %radix_heap of the same type.
+     */
+    radix_heap(const radix_heap &other) = default;
+
+    /**
+     * @brief Constructs a %radix_heap by moving an existing one.
+     *
+     * @param other Another %radix_heap of the same type.
+     */
+    radix_heap(radix_heap &&other) noexcept : radix_heap() { swap(other); }
+
+    // Element access
+
+    /**
+     * @brief Returns a readonly reference to the element with the smallest
+     * key.
+     *
+     * Calling top() on an empty %radix_heap is undefined behavior. The key of
+     * the returned element becomes the lower bound for later pushes.
+     */
+    const_reference
+    top() const
+    {
+        M_Assert(!empty(), "Can't use top() on an empty radix_heap");
+        _pull();
+        return _buckets[0].back();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %radix_heap is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Returns the number of elements in the %radix_heap.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Adds a new element to the %radix_heap.
+     *
+     * @param key   Key of the new element.
+     * @param value Value attached to the key.
+     */
+    void
+    push(const key_type &key, const mapped_type &value)
+    {
+        emplace(key, value);
+    }
+
+    /**
+     * @brief Adds a new element to the %radix_heap.
+     *
+     * @param x Key/value pair to be pushed.
+     */
+    void
+    push(const value_type &x)
+    {
+        emplace(x.first, x.second);
+    }
+
+    /**
+     * @brief Adds an rvalue element to the %radix_heap.
+     *
+     * @param x Key/value pair to be pushed.
+     */
+    void
+    push(value_type &&x)
+    {
+        emplace(x.first, std::move(x.second));
+    }
+
+    /**
+     * @brief Constructs a new element in the %radix_heap.
+     *
+     * @param key  Key of the new element.
+     * @param args Argument list to create a value of type _Tp.
+     */
+    template <typename... Args>
+    void
+    emplace(const key_type &key, Args &&...args)
+    {
+        const _Ukey ukey = _encode(key);
+        M_Assert(ukey >= _last,
+                 "radix_heap keys must not be smaller than the last top()");
+
+        _buckets[_bucket_of(ukey)].push_back(
+            value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...)));
+        ++_size;
+    }
+
+    /**
+     * @brief Removes the element with the smallest key.
+     *
+     * Calling pop() on an empty %radix_heap is undefined behavior.
+     */
+    void
+    pop()
+    {
+        M_Assert(!empty(), "Can't use pop() on an empty radix_heap");
+        _pull();
+        _buckets[0].pop_back();
+        --_size;
+    }
+
+    /**
+     * @brief Removes all elements, but keeps the allocated buckets.
+     *
+     * The lower bound set by the last top() is kept, so the heap stays
+     * monotone across clear().
+     */
+    void
+    clear() noexcept
+    {
+        for (size_type i = 0; i < _S_num_buckets; i++)
+            _buckets[i].clear();
+        _size = 0;
+    }
+
+    /**
+     * @brief Swaps the content between two radix heaps.
+     *
+     * @param other Another %radix_heap of the same type.
+     */
+    void
+    swap(radix_heap &other) noexcept
+    {
+        for (size_type i = 0; i < _S_num_buckets; i++)
+            _buckets[i].swap(other._buckets[i]);
+        std::swap(_size, other._size);
+        std::swap(_last, other._last);
+    }
+
+private:
+    using _Ukey = std::make_unsigned_t<_Key>;
+
+    constexpr static size_type _S_num_buckets = sizeof(_Key) * CHAR_BIT + 1;
+
+    // top() is a readonly operation for callers, but it may redistribute the
+    // first non-empty bucket so that the minimum ends up in bucket 0.
+    mutable container_type _buckets[_S_num_buckets];
+    size_type _size;
+    mutable _Ukey _last;
+
+    /**
+     * Maps a key to an unsigned integer of the same width while keeping the
+     * order, so that signed keys can share the bucketing scheme.
+     */
+    static _Ukey
+    _encode(const key_type &key) noexcept
+    {
+        if constexpr (std::is_signed_v<_Key>)
+            return _Ukey(key) ^ (_Ukey(1) << (sizeof(_Key) * CHAR_BIT - 1));
+        else
+            return _Ukey(key);
+    }
+
+    size_type
+    _bucket_of(_Ukey ukey) const noexcept
+    {
+        return size_type(std::bit_width(_Ukey(ukey ^ _last)));
+    }
+
+    /**
+     * Refills bucket 0 when it is empty: the smallest key of the first
+     * non-empty bucket becomes the new lower bound and every element of that
+     * bucket moves to a strictly lower bucket.
+     */
+    void
+    _pull() const
+    {
+        if (!_buckets[0].empty())
+            return;
+
+        size_type i = 1;
+        while (_buckets[i].empty())
+            i++;
+
+        container_type &bucket = _buckets[i];
+
+        _Ukey min_key = _encode(bucket[0].first);
+        for (size_type j = 1; j < bucket.size(); j++)
+            min_key = std::min(min_key, _encode(bucket[j].first));
+
+        _last = min_key;
+        for (size_type j = 0; j < bucket.size(); j++)
+            _buckets[_bucket_of(_encode(bucket[j].first))].push_back(
+                std::move(bucket[j]));
+
+        bucket.clear();
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_RADIX_HEAP_H */
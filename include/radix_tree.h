@@ -0,0 +1,881 @@
+/**
+ * @file radix_tree.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A path-compressed trie of string keys
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_RADIX_TREE_H
+#define __OPENDSA_RADIX_TREE_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include "pool.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A node of a radix_tree.
+ *
+ * The key of a node is the concatenation of the labels from the root down to
+ * it. The children are sorted by the first byte of their label, which is
+ * unique among siblings. Every node holds a value or has two children or
+ * more, except the root, whose label is empty.
+ */
+template <typename _Tp>
+struct _Radix_node
+{
+    using value_type = std::pair<const std::string, _Tp>;
+
+    std::string _label;
+    _Radix_node *_parent;
+    vector<_Radix_node *> _children;
+    std::optional<value_type> _value;
+
+    _Radix_node(std::string_view label, _Radix_node *parent)
+    : _label(label), _parent(parent), _children(), _value()
+    {
+    }
+
+    static unsigned char
+    _S_byte(char c) noexcept
+    {
+        return static_cast<unsigned char>(c);
+    }
+
+    /**
+     * @brief Returns the position of the child whose label starts with @a c,
+     * or where it would be inserted.
+     */
+    typename vector<_Radix_node *>::const_iterator
+    _child_pos(char c) const noexcept
+    {
+        return std::lower_bound(_children.cbegin(), _children.cend(), c,
+                                [](const _Radix_node *x, char c)
+                                {
+                                    return _S_byte(x->_label[0]) < _S_byte(c);
+                                });
+    }
+
+    /**
+     * @brief Returns the child whose label starts with @a c, or null.
+     */
+    _Radix_node *
+    _child(char c) const noexcept
+    {
+        auto pos = _child_pos(c);
+        if (pos == _children.cend() || (*pos)->_label[0] != c)
+            return nullptr;
+        return *pos;
+    }
+
+    /**
+     * @brief Returns the next node in preorder after the subtree of @a x,
+     * or null.
+     */
+    static _Radix_node *
+    _S_skip(const _Radix_node *x) noexcept
+    {
+        while (x->_parent != nullptr)
+        {
+            const _Radix_node *p = x->_parent;
+            auto pos             = p->_child_pos(x->_label[0]) + 1;
+            if (pos != p->_children.cend())
+                return *pos;
+            x = p;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Returns the first node holding a value in preorder, starting
+     * from @a x itself, or null.
+     */
+    static _Radix_node *
+    _S_first_value(_Radix_node *x) noexcept
+    {
+        while (x != nullptr && !x->_value)
+            x = x->_children.empty() ? _S_skip(x) : x->_children[0];
+        return x;
+    }
+
+    /**
+     * @brief Returns the next node holding a value in preorder, i.e. the
+     * next key in lexicographic order, or null.
+     */
+    static _Radix_node *
+    _S_next_value(const _Radix_node *x) noexcept
+    {
+        return _S_first_value(x->_children.empty() ? _S_skip(x)
+                                                   : x->_children[0]);
+    }
+};
+
+/**
+ * @brief Forward iterator over the keys of a radix_tree in lexicographic
+ * order. The past-the-end iterator holds a null node.
+ */
+template <typename _Tp>
+struct _Radix_tree_iterator
+{
+    using value_type = typename _Radix_node<_Tp>::value_type;
+    using reference  = value_type &;
+    using pointer    = value_type *;
+
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Radix_node<_Tp>;
+
+    node_type *_node;
+
+    _Radix_tree_iterator() noexcept : _node() { }
+
+    explicit _Radix_tree_iterator(node_type *x) noexcept : _node(x) { }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_value;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return std::addressof(*_node->_value);
+    }
+
+    _Radix_tree_iterator &
+    operator++() noexcept
+    {
+        _node = node_type::_S_next_value(_node);
+        return *this;
+    }
+
+    _Radix_tree_iterator
+    operator++(int) noexcept
+    {
+        _Radix_tree_iterator tmp = *this;
+        _node                    = node_type::_S_next_value(_node);
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Radix_tree_iterator &lhs,
+               const _Radix_tree_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+};
+
+/**
+ * @brief Readonly version of _Radix_tree_iterator.
+ */
+template <typename _Tp>
+struct _Radix_tree_const_iterator
+{
+    using value_type = typename _Radix_node<_Tp>::value_type;
+    using reference  = const value_type &;
+    using pointer    = const value_type *;
+
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Radix_node<_Tp>;
+    using iterator  = _Radix_tree_iterator<_Tp>;
+
+    const node_type *_node;
+
+    _Radix_tree_const_iterator() noexcept : _node() { }
+
+    explicit _Radix_tree_const_iterator(const node_type *x) noexcept
+    : _node(x)
+    {
+    }
+
+    _Radix_tree_const_iterator(const iterator &it) noexcept : _node(it._node)
+    {
+    }
+
+    /**
+     * @brief Converts back to a mutable iterator, e.g. for erase().
+     */
+    iterator
+    _const_cast() const noexcept
+    {
+        return iterator(const_cast<node_type *>(_node));
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *_node->_value;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return std::addressof(*_node->_value);
+    }
+
+    _Radix_tree_const_iterator &
+    operator++() noexcept
+    {
+        _node = node_type::_S_next_value(_node);
+        return *this;
+    }
+
+    _Radix_tree_const_iterator
+    operator++(int) noexcept
+    {
+        _Radix_tree_const_iterator tmp = *this;
+        _node                          = node_type::_S_next_value(_node);
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Radix_tree_const_iterator &lhs,
+               const _Radix_tree_const_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+};
+
+/**
+ * @brief A map of string keys backed by a path-compressed trie.
+ *
+ * @tparam _Tp Type of the mapped values.
+ *
+ * Each edge of the tree is labeled by a string rather than a single byte:
+ * a chain of nodes with one child each is merged into one node, so a lookup
+ * visits at most one node per branching point of the keys and compares whole
+ * labels at once. The cost of a lookup depends on the length of the key
+ * rather than on the number of keys.
+ *
+ * Keys are arbitrary byte strings and are iterated in lexicographic order of
+ * their bytes as unsigned char. Since the keys sharing a prefix form a
+ * subtree, prefix_range() and longest_prefix_match() take a single walk down
+ * the tree, e.g. for URL routing. IP prefixes can be stored as bytes for
+ * prefixes at byte boundaries, or as strings of '0' and '1' otherwise.
+ *
+ * A node is never moved once it holds a value, so iterators and references
+ * stay valid until their element is erased.
+ */
+template <typename _Tp>
+class radix_tree
+{
+private:
+    using _Node      = _Radix_node<_Tp>;
+    using _Node_ptr  = _Node *;
+    using _Const_ptr = const _Node *;
+
+public:
+    using key_type        = std::string;
+    using mapped_type     = _Tp;
+    using value_type      = std::pair<const std::string, _Tp>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using iterator        = _Radix_tree_iterator<_Tp>;
+    using const_iterator  = _Radix_tree_const_iterator<_Tp>;
+
+    /**
+     * @brief Creates an empty %radix_tree.
+     */
+    radix_tree() : _root(nullptr), _count(0), _pool() { }
+
+    /**
+     * @brief Creates a %radix_tree based on an initializer list.
+     *
+     * @param list An initializer list of key/value pairs.
+     */
+    radix_tree(std::initializer_list<value_type> list) : radix_tree()
+    {
+        for (const value_type &x : list)
+            insert(x);
+    }
+
+    /**
+     * @brief Creates a %radix_tree by deep copying another one.
+     */
+    radix_tree(const radix_tree &other) : radix_tree()
+    {
+        if (other._root != nullptr)
+        {
+            try
+            {
+                _root  = _copy(other._root, nullptr);
+                _count = other._count;
+            }
+            catch (...)
+            {
+                _pool.release();
+                throw;
+            }
+        }
+    }
+
+    radix_tree(radix_tree &&other) noexcept
+    : _root(other._root), _count(other._count), _pool(std::move(other._pool))
+    {
+        other._root  = nullptr;
+        other._count = 0;
+    }
+
+    ~radix_tree() { _destroy(_root); }
+
+    radix_tree &
+    operator=(const radix_tree &other)
+    {
+        if (&other != this)
+        {
+            radix_tree tmp(other);
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    radix_tree &
+    operator=(radix_tree &&other) noexcept
+    {
+        if (&other != this)
+        {
+            radix_tree tmp(std::move(other));
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(_Node::_S_first_value(_root));
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_Node::_S_first_value(_root));
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(nullptr);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(nullptr);
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %radix_tree is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _count == 0;
+    }
+
+    /**
+     * @brief Returns the number of keys in the %radix_tree.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _count;
+    }
+
+    // Element access
+
+    /**
+     * @brief Returns the value mapped to @a k, inserting a default value if
+     * the key doesn't exist.
+     */
+    _Tp &
+    operator[](std::string_view k)
+    {
+        return _try_emplace(k)->_value->second;
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts a key/value pair unless the key already exists.
+     *
+     * Returns an iterator to the element with the key of @a x, and whether
+     * the insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        return try_emplace(x.first, x.second);
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        return try_emplace(x.first, std::move(x.second));
+    }
+
+    /**
+     * @brief Constructs the value mapped to @a k in place, unless the key
+     * already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    try_emplace(std::string_view k, Args &&...args)
+    {
+        const size_type old_count = _count;
+        _Node_ptr x = _try_emplace(k, std::forward<Args>(args)...);
+        return {iterator(x), _count != old_count};
+    }
+
+    /**
+     * @brief Inserts a key/value pair, or assigns @a obj to the value mapped
+     * to @a k if the key already exists.
+     */
+    template <typename _Obj>
+    std::pair<iterator, bool>
+    insert_or_assign(std::string_view k, _Obj &&obj)
+    {
+        std::pair<iterator, bool> res = try_emplace(k, std::forward<_Obj>(obj));
+        if (!res.second)
+            res.first->second = std::forward<_Obj>(obj);
+        return res;
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        _Node_ptr x    = const_cast<_Node_ptr>(pos._node);
+        _Node_ptr next = _Node::_S_next_value(x);
+
+        x->_value.reset();
+        --_count;
+        _compact(x);
+
+        return iterator(next);
+    }
+
+    /**
+     * @brief Removes the key @a k, if present.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(std::string_view k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+
+        erase(it);
+        return 1;
+    }
+
+    /**
+     * @brief Removes every element.
+     */
+    void
+    clear() noexcept
+    {
+        _destroy(_root);
+        _pool.release();
+        _root  = nullptr;
+        _count = 0;
+    }
+
+    /**
+     * @brief Swaps the content of two trees in constant time.
+     */
+    void
+    swap(radix_tree &other) noexcept
+    {
+        std::swap(_root, other._root);
+        std::swap(_count, other._count);
+        _pool.swap(other._pool);
+    }
+
+    // Lookup
+
+    iterator
+    find(std::string_view k)
+    {
+        return iterator(const_cast<_Node_ptr>(_find(k)));
+    }
+
+    const_iterator
+    find(std::string_view k) const
+    {
+        return const_iterator(_find(k));
+    }
+
+    bool
+    contains(std::string_view k) const
+    {
+        return _find(k) != nullptr;
+    }
+
+    size_type
+    count(std::string_view k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the range of the keys that start with @a prefix, in
+     * lexicographic order.
+     */
+    std::pair<iterator, iterator>
+    prefix_range(std::string_view prefix)
+    {
+        std::pair<const_iterator, const_iterator> res =
+            std::as_const(*this).prefix_range(prefix);
+        return {res.first._const_cast(), res.second._const_cast()};
+    }
+
+    std::pair<const_iterator, const_iterator>
+    prefix_range(std::string_view prefix) const
+    {
+        _Const_ptr x = _root;
+
+        while (x != nullptr && !prefix.empty())
+        {
+            _Const_ptr c = x->_child(prefix[0]);
+            if (c == nullptr)
+                return {end(), end()};
+
+            const size_type m = _S_common_prefix(c->_label, prefix);
+            if (m == prefix.size())
+            {
+                // The prefix ends within the label of c, so the whole
+                // subtree of c matches
+                x = c;
+                break;
+            }
+            if (m < c->_label.size())
+                return {end(), end()};
+
+            prefix.remove_prefix(m);
+            x = c;
+        }
+
+        if (x == nullptr)
+            return {end(), end()};
+
+        _Node_ptr first = _Node::_S_first_value(const_cast<_Node_ptr>(x));
+        _Node_ptr last  = _Node::_S_first_value(_Node::_S_skip(x));
+        return {const_iterator(first), const_iterator(last)};
+    }
+
+    /**
+     * @brief Returns the element whose key is the longest prefix of @a k,
+     * which might be @a k itself, or end() if no key is a prefix of @a k.
+     */
+    iterator
+    longest_prefix_match(std::string_view k)
+    {
+        return std::as_const(*this).longest_prefix_match(k)._const_cast();
+    }
+
+    const_iterator
+    longest_prefix_match(std::string_view k) const
+    {
+        _Const_ptr best = nullptr;
+        _Const_ptr x    = _root;
+
+        while (x != nullptr)
+        {
+            if (x->_value)
+                best = x;
+            if (k.empty())
+                break;
+
+            x = x->_child(k[0]);
+            if (x == nullptr || !k.starts_with(x->_label))
+                break;
+            k.remove_prefix(x->_label.size());
+        }
+
+        return const_iterator(best);
+    }
+
+private:
+    _Node_ptr _root;
+    size_type _count;
+    node_pool<_Node> _pool;
+
+    static size_type
+    _S_common_prefix(std::string_view a, std::string_view b) noexcept
+    {
+        const size_type n = std::min(a.size(), b.size());
+        size_type i       = 0;
+
+        while (i < n && a[i] == b[i])
+            i++;
+        return i;
+    }
+
+    _Node_ptr
+    _create_node(std::string_view label, _Node_ptr parent)
+    {
+        _Node_ptr x = _pool.allocate();
+
+        try
+        {
+            ::new (static_cast<void *>(x)) _Node(label, parent);
+        }
+        catch (...)
+        {
+            _pool.deallocate(x);
+            throw;
+        }
+
+        return x;
+    }
+
+    void
+    _drop_node(_Node_ptr x) noexcept
+    {
+        std::destroy_at(x);
+        _pool.deallocate(x);
+    }
+
+    /**
+     * Destroys the subtree rooted at @a x and gives its nodes back to the
+     * pool.
+     */
+    void
+    _destroy(_Node_ptr x) noexcept
+    {
+        if (x == nullptr)
+            return;
+
+        for (_Node_ptr c : x->_children)
+            _destroy(c);
+        _drop_node(x);
+    }
+
+    _Node_ptr
+    _copy(_Const_ptr x, _Node_ptr parent)
+    {
+        _Node_ptr y = _create_node(x->_label, parent);
+
+        try
+        {
+            if (x->_value)
+                y->_value.emplace(*x->_value);
+            for (size_type i = 0; i < x->_children.size(); i++)
+            {
+                _Node_ptr c = _copy(x->_children[i], y);
+
+                try
+                {
+                    y->_children.push_back(c);
+                }
+                catch (...)
+                {
+                    _destroy(c);
+                    throw;
+                }
+            }
+        }
+        catch (...)
+        {
+            _destroy(y);
+            throw;
+        }
+
+        return y;
+    }
+
+    _Const_ptr
+    _find(std::string_view k) const noexcept
+    {
+        _Const_ptr x = _root;
+
+        while (x != nullptr && !k.empty())
+        {
+            x = x->_child(k[0]);
+            if (x == nullptr || !k.starts_with(x->_label))
+                return nullptr;
+            k.remove_prefix(x->_label.size());
+        }
+
+        return (x != nullptr && x->_value) ? x : nullptr;
+    }
+
+    /**
+     * Returns the node of the key @a k, where a value is constructed from
+     * @a args if there was none.
+     *
+     * If the value throws, the tree might be left with a node that has a
+     * single child and no value, which is still a valid tree.
+     */
+    template <typename... Args>
+    _Node_ptr
+    _try_emplace(std::string_view k, Args &&...args)
+    {
+        if (_root == nullptr)
+            _root = _create_node(std::string_view(), nullptr);
+
+        const std::string_view key = k;
+        _Node_ptr x                = _root;
+
+        while (!k.empty())
+        {
+            auto pos = x->_child_pos(k[0]);
+
+            if (pos == x->_children.cend() || (*pos)->_label[0] != k[0])
+            {
+                // No key shares the next byte: add a leaf for the rest of k
+                _Node_ptr leaf = _create_node(k, x);
+
+                try
+                {
+                    x->_children.insert(pos, leaf);
+                }
+                catch (...)
+                {
+                    _drop_node(leaf);
+                    throw;
+                }
+
+                try
+                {
+                    _emplace_value(leaf, key, std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    x->_children.erase(x->_child_pos(k[0]));
+                    _drop_node(leaf);
+                    throw;
+                }
+
+                return leaf;
+            }
+
+            _Node_ptr c       = *pos;
+            const size_type m = _S_common_prefix(c->_label, k);
+
+            if (m < c->_label.size())
+            {
+                // Split the label of c after the common part
+                _Node_ptr mid =
+                    _create_node(std::string_view(c->_label).substr(0, m), x);
+
+                try
+                {
+                    mid->_children.push_back(c);
+                }
+                catch (...)
+                {
+                    _drop_node(mid);
+                    throw;
+                }
+
+                c->_label.erase(0, m);
+                c->_parent = mid;
+                x->_children[pos - x->_children.cbegin()] = mid;
+                c = mid;
+            }
+
+            k.remove_prefix(m);
+            x = c;
+        }
+
+        if (!x->_value)
+            _emplace_value(x, key, std::forward<Args>(args)...);
+
+        return x;
+    }
+
+    template <typename... Args>
+    void
+    _emplace_value(_Node_ptr x, std::string_view key, Args &&...args)
+    {
+        x->_value.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+        ++_count;
+    }
+
+    /**
+     * Restores the path compression around @a x, whose value was removed:
+     * a leaf without value is removed, and a node without value and with a
+     * single child is merged into it. The nodes holding a value are never
+     * moved.
+     */
+    void
+    _compact(_Node_ptr x) noexcept
+    {
+        if (x == _root || x->_value)
+            return;
+
+        if (x->_children.empty())
+        {
+            _Node_ptr p = x->_parent;
+            p->_children.erase(p->_child_pos(x->_label[0]));
+            _drop_node(x);
+
+            x = p;
+            if (x == _root || x->_value)
+                return;
+        }
+
+        if (x->_children.size() == 1)
+        {
+            _Node_ptr c = x->_children[0];
+            _Node_ptr p = x->_parent;
+
+            try
+            {
+                c->_label.insert(0, x->_label);
+            }
+            catch (...)
+            {
+                // Leave x in place: the tree is less compact but valid
+                return;
+            }
+
+            c->_parent = p;
+            p->_children[p->_child_pos(c->_label[0]) - p->_children.cbegin()] =
+                c;
+            _drop_node(x);
+        }
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_RADIX_TREE_H */
@@ -0,0 +1,224 @@
+/**
+ * @file search.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Branch-free binary searches over contiguous sorted arrays
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_SEARCH_H
+#define __OPENDSA_SEARCH_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief An array the searches of search.h run on, or take their keys from:
+ * a range with contiguous elements and a size, e.g. a vector or a std::span.
+ */
+template <typename _Range>
+concept _Contiguous_sized = requires(const _Range &r) {
+    { std::ranges::data(r) };
+    { std::ranges::size(r) } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * Returns the position of the first element of [data, data + n) for which
+ * @a before is false, the elements for which it is true coming first.
+ *
+ * Every step halves the window without a branch: the window moves to its
+ * upper half if the element at its middle comes before the key, with a
+ * conditional move, so the search does not depend on the branch predictor.
+ * The number of steps only depends on n, and the two elements the next step
+ * may probe, the middles of both halves, are prefetched so that the miss of
+ * the next step overlaps the current one.
+ */
+template <typename _Tp, typename _Pred>
+std::size_t
+__branchless_partition_point(const _Tp *data, std::size_t n, _Pred before)
+{
+    if (n == 0)
+        return 0;
+
+    const _Tp *base = data;
+    while (n > 1)
+    {
+        const std::size_t half = n / 2;
+        const std::size_t next = (n - half) / 2;
+        __builtin_prefetch(base + next);
+        __builtin_prefetch(base + half + next);
+        base = before(base[half]) ? base + half : base;
+        n -= half;
+    }
+    return (base - data) + before(*base);
+}
+
+/**
+ * @brief Returns the position of the first element of a sorted array that is
+ * not less than @a x, or its size if there is none.
+ *
+ * @param range Contiguous range sorted by @a comp
+ * @param x     Key to search for
+ * @param comp  Comparison object
+ *
+ * Same result as std::lower_bound, as a position, with a branch-free search
+ * that prefetches the next probes.
+ */
+template <_Contiguous_sized _Range, typename _Key,
+          typename _Compare = std::less<>>
+std::size_t
+lower_bound(const _Range &range, const _Key &x, _Compare comp = _Compare())
+{
+    return __branchless_partition_point(
+        std::ranges::data(range), std::ranges::size(range),
+        [&](const auto &e) { return comp(e, x); });
+}
+
+/**
+ * @brief Returns the position of the first element of a sorted array that is
+ * greater than @a x, or its size if there is none.
+ *
+ * @param range Contiguous range sorted by @a comp
+ * @param x     Key to search for
+ * @param comp  Comparison object
+ */
+template <_Contiguous_sized _Range, typename _Key,
+          typename _Compare = std::less<>>
+std::size_t
+upper_bound(const _Range &range, const _Key &x, _Compare comp = _Compare())
+{
+    return __branchless_partition_point(
+        std::ranges::data(range), std::ranges::size(range),
+        [&](const auto &e) { return !comp(x, e); });
+}
+
+/**
+ * @brief Returns the positions of the first element of a sorted array that
+ * is not less than @a x and of the first one greater than @a x.
+ *
+ * @param range Contiguous range sorted by @a comp
+ * @param x     Key to search for
+ * @param comp  Comparison object
+ *
+ * The upper bound is searched for after the lower one only.
+ */
+template <_Contiguous_sized _Range, typename _Key,
+          typename _Compare = std::less<>>
+std::pair<std::size_t, std::size_t>
+equal_range(const _Range &range, const _Key &x, _Compare comp = _Compare())
+{
+    const auto *data    = std::ranges::data(range);
+    const std::size_t n = std::ranges::size(range);
+
+    const std::size_t lo = __branchless_partition_point(
+        data, n, [&](const auto &e) { return comp(e, x); });
+    const std::size_t hi =
+        lo + __branchless_partition_point(data + lo, n - lo,
+                                          [&](const auto &e)
+                                          { return !comp(x, e); });
+    return {lo, hi};
+}
+
+/**
+ * Searches for every key of @a keys at once, a group of them at a time.
+ * All the searches over an array take the same number of steps, so a group
+ * runs in lock step: each step probes every search of the group before the
+ * next step, and prefetches the next probe of each search, which is known
+ * once its current probe is, so the misses of the searches of a group are in
+ * flight together rather than one after the other.
+ */
+template <typename _Tp, typename _Keys, typename _Before>
+vector<std::size_t>
+__branchless_partition_points(const _Tp *data, std::size_t n,
+                              const _Keys &keys, _Before before)
+{
+    constexpr std::size_t group = 16;
+
+    const auto *key         = std::ranges::data(keys);
+    const std::size_t count = std::ranges::size(keys);
+    vector<std::size_t> res(count);
+    if (n == 0)
+        return res;
+
+    const _Tp *base[group];
+    for (std::size_t first = 0; first < count; first += group)
+    {
+        const std::size_t size = std::min(group, count - first);
+        for (std::size_t g = 0; g < size; g++)
+            base[g] = data;
+
+        for (std::size_t len = n; len > 1;)
+        {
+            const std::size_t half = len / 2;
+            const std::size_t next = (len - half) / 2;
+            for (std::size_t g = 0; g < size; g++)
+            {
+                const _Tp *b = base[g];
+                b = before(b[half], key[first + g]) ? b + half : b;
+                __builtin_prefetch(b + next);
+                base[g] = b;
+            }
+            len -= half;
+        }
+
+        for (std::size_t g = 0; g < size; g++)
+            res[first + g] =
+                (base[g] - data) + before(*base[g], key[first + g]);
+    }
+
+    return res;
+}
+
+/**
+ * @brief Returns the lower bound of every key of @a keys in a sorted array,
+ * as by lower_bound().
+ *
+ * @param range Contiguous range sorted by @a comp
+ * @param keys  Contiguous range of keys, in any order
+ * @param comp  Comparison object
+ *
+ * The searches of a group of keys are interleaved to hide the latency of
+ * memory, which makes many lookups into an array larger than the caches,
+ * e.g. the probes of a join, several times faster than searching for the
+ * keys one by one.
+ */
+template <_Contiguous_sized _Range, _Contiguous_sized _Keys,
+          typename _Compare = std::less<>>
+vector<std::size_t>
+lower_bound_batch(const _Range &range, const _Keys &keys,
+                  _Compare comp = _Compare())
+{
+    return __branchless_partition_points(
+        std::ranges::data(range), std::ranges::size(range), keys,
+        [&](const auto &e, const auto &x) { return comp(e, x); });
+}
+
+/**
+ * @brief Returns the upper bound of every key of @a keys in a sorted array,
+ * as by upper_bound(), see lower_bound_batch().
+ */
+template <_Contiguous_sized _Range, _Contiguous_sized _Keys,
+          typename _Compare = std::less<>>
+vector<std::size_t>
+upper_bound_batch(const _Range &range, const _Keys &keys,
+                  _Compare comp = _Compare())
+{
+    return __branchless_partition_points(
+        std::ranges::data(range), std::ranges::size(range), keys,
+        [&](const auto &e, const auto &x) { return !comp(x, e); });
+}
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_SEARCH_H */
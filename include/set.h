@@ -0,0 +1,539 @@
+/**
+ * @file set.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered associative container of unique keys
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_SET_H
+#define __OPENDSA_SET_H 1
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "helper.h"
+#include "tree.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief An ordered set of unique keys
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Compare Strict weak ordering of the keys.
+ * @tparam _Alloc   User-defined allocator.
+ * @tparam _Balance Balancing scheme of the tree, see avl_set.
+ * @tparam _Augment Data folded over every subtree, see order_statistic_set.
+ *
+ * A set is an adapter over a red-black _Bi_search_tree whose values are their
+ * own keys. Since modifying a key would break the order, both iterator and
+ * const_iterator are readonly.
+ */
+template <typename _Key, typename _Compare = std::less<_Key>,
+          typename _Alloc   = std::allocator<_Key>,
+          typename _Balance = _Rb_tree_balance, typename _Augment = void>
+class set
+{
+private:
+    using _Tree_type =
+        _Bi_search_tree<_Key, _Key, _Identity, _Compare, _Alloc, _Balance,
+                        _Augment>;
+
+public:
+    using key_type               = _Key;
+    using value_type             = _Key;
+    using key_compare            = _Compare;
+    using value_compare          = _Compare;
+    using allocator_type         = _Alloc;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using size_type              = typename _Tree_type::size_type;
+    using difference_type        = typename _Tree_type::difference_type;
+    using iterator               = typename _Tree_type::const_iterator;
+    using const_iterator         = typename _Tree_type::const_iterator;
+    using reverse_iterator       = typename _Tree_type::const_reverse_iterator;
+    using const_reverse_iterator = typename _Tree_type::const_reverse_iterator;
+
+    /**
+     * @brief Creates an empty %set.
+     */
+    set() : _tree() { }
+
+    /**
+     * @brief Creates an empty %set with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit set(const _Compare &comp, const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %set based on a range of elements.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     *
+     * Duplicated keys are only inserted once.
+     */
+    template <typename _InputIter>
+    set(_InputIter first, _InputIter last, const _Compare &comp = _Compare(),
+        const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %set based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    set(std::initializer_list<value_type> list,
+        const _Compare &comp = _Compare(), const _Alloc &alloc = _Alloc())
+    : _tree(comp, alloc)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Creates a %set from a sorted range in linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The range must be sorted by @a comp. The tree is built perfectly
+     * balanced without any search nor rebalancing, e.g. to reload a snapshot.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static set
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        set res(comp, alloc);
+        res.insert_sorted(first, last);
+        return res;
+    }
+
+    set(const set &other) = default;
+
+    set(set &&other) noexcept = default;
+
+    set &
+    operator=(const set &other) = default;
+
+    set &
+    operator=(set &&other) = default;
+
+    set &
+    operator=(std::initializer_list<value_type> list)
+    {
+        _tree.clear();
+        insert(list.begin(), list.end());
+        return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return _tree.get_allocator();
+    }
+
+    // Iterators
+
+    iterator
+    begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    iterator
+    end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return _tree.end();
+    }
+
+    reverse_iterator
+    rbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    const_reverse_iterator
+    crbegin() const noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    reverse_iterator
+    rend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    const_reverse_iterator
+    crend() const noexcept
+    {
+        return _tree.rend();
+    }
+
+    // Capacity
+
+    /**
+     * @brief Returns true if the %set is empty.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the %set.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _tree.max_size();
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Removes every element of the %set.
+     */
+    void
+    clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief Inserts a key unless it already exists.
+     *
+     * @param x Key to be inserted.
+     *
+     * Returns an iterator to the element equivalent to @a x, and whether the
+     * insertion took place.
+     */
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._insert_unique(x);
+        return {res.first, res.second};
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._insert_unique(std::move(x));
+        return {res.first, res.second};
+    }
+
+    /**
+     * @brief Inserts a key using @a hint as a suggestion of where it goes.
+     *
+     * @param hint Iterator to the element that would follow the new one.
+     * @param x    Key to be inserted.
+     *
+     * The insertion is amortized O(1) if the new element goes right before
+     * @a hint, e.g. when inserting sorted data with end() as the hint.
+     */
+    iterator
+    insert(const_iterator hint, const value_type &x)
+    {
+        return _tree._insert_hint_unique(hint, x);
+    }
+
+    iterator
+    insert(const_iterator hint, value_type &&x)
+    {
+        return _tree._insert_hint_unique(hint, std::move(x));
+    }
+
+    /**
+     * @brief Inserts the elements in [first, last).
+     */
+    template <typename _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            _tree._emplace_hint_unique(end(), *first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Inserts a sorted range of keys.
+     *
+     * Large batches are merged with the %set in O(n + k), small ones are
+     * inserted with hints. See _Bi_search_tree::insert_sorted().
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        _tree.insert_sorted(first, last);
+    }
+
+    /**
+     * @brief Constructs a new key in place unless it already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        std::pair<typename _Tree_type::iterator, bool> res =
+            _tree._emplace_unique(std::forward<Args>(args)...);
+        return {res.first, res.second};
+    }
+
+    /**
+     * @brief Constructs a new key in place using @a hint as a suggestion of
+     * where it goes.
+     */
+    template <typename... Args>
+    iterator
+    emplace_hint(const_iterator hint, Args &&...args)
+    {
+        return _tree._emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Removes the element at @a pos.
+     *
+     * Returns an iterator to the element following the removed one.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief Removes the key @a k, if present.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+
+        _tree.erase(it);
+        return 1;
+    }
+
+    /**
+     * @brief Swaps the content between two sets in constant time.
+     */
+    void
+    swap(set &other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // Lookup
+
+    size_type
+    count(const key_type &k) const
+    {
+        return _tree.find(k) == _tree.end() ? 0 : 1;
+    }
+
+    iterator
+    find(const key_type &k) const
+    {
+        return _tree.find(k);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return _tree.find(k) != _tree.end();
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k) const
+    {
+        return _tree.equal_range(k);
+    }
+
+    /**
+     * @brief Returns the first key that is not less than @a k.
+     */
+    iterator
+    lower_bound(const key_type &k) const
+    {
+        return _tree.lower_bound(k);
+    }
+
+    /**
+     * @brief Returns the first key that is greater than @a k.
+     */
+    iterator
+    upper_bound(const key_type &k) const
+    {
+        return _tree.upper_bound(k);
+    }
+
+    // Traversal
+
+    /**
+     * @brief Calls @a fn on every key in ascending order.
+     *
+     * Faster than iterating for a full scan, see
+     * _Bi_search_tree::for_each_inorder(). @a fn must not insert nor remove
+     * keys.
+     */
+    template <typename _Fn>
+    void
+    for_each_inorder(_Fn fn) const
+    {
+        _tree.for_each_inorder(fn);
+    }
+
+    // Order statistics
+
+    /**
+     * @brief Returns the key at position @a k in ascending order, or end()
+     * if there are not that many.
+     */
+    const_iterator
+    select(size_type k) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.select(k);
+    }
+
+    /**
+     * @brief Returns the number of keys that is less than @a k.
+     */
+    size_type
+    rank(const key_type &k) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.rank(k);
+    }
+
+    /**
+     * @brief Returns the number of keys that is in [lo, hi).
+     */
+    size_type
+    count_range(const key_type &lo, const key_type &hi) const
+        requires _Counting_augment<_Augment, value_type>
+    {
+        return _tree.count_range(lo, hi);
+    }
+
+    /**
+     * @brief Returns the augmented data folded over the keys that is in
+     * [lo, hi).
+     */
+    auto
+    fold(const key_type &lo, const key_type &hi) const
+        requires(!std::is_void_v<_Augment>)
+    {
+        return _tree.fold(lo, hi);
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _tree.key_comp();
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return _tree.key_comp();
+    }
+
+    friend bool
+    operator==(const set &lhs, const set &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool
+    operator!=(const set &lhs, const set &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    _Tree_type _tree;
+};
+
+/**
+ * @brief A %set backed by an AVL tree, for lookup-heavy workloads.
+ */
+template <typename _Key, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<_Key>>
+using avl_set = set<_Key, _Compare, _Alloc, _Avl_tree_balance>;
+
+/**
+ * @brief A %set that also finds the key at a given position and the position
+ * of a key in O(log n), see select() and rank().
+ */
+template <typename _Key, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<_Key>>
+using order_statistic_set =
+    set<_Key, _Compare, _Alloc, _Rb_tree_balance, subtree_size>;
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_SET_H */
@@ -0,0 +1,825 @@
+/**
+ * @file sort.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Sorting of vectors, by radix, on several threads or for tiny arrays
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_SORT_H
+#define __OPENDSA_SORT_H 1
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                             \
+    (defined(__x86_64__) || defined(__i386__))
+#define __OPENDSA_SORT_AVX2 1
+#include <immintrin.h>
+#endif
+
+#include "algorithm.h"
+#include "merge.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A key radix_sort() orders by its bits: an integer, or an IEEE float
+ * of 32 or 64 bits.
+ */
+template <typename _Tp>
+concept _Radix_key =
+    (std::integral<_Tp> && !std::same_as<_Tp, bool>) ||
+    (std::floating_point<_Tp> && std::numeric_limits<_Tp>::is_iec559 &&
+     (sizeof(_Tp) == 4 || sizeof(_Tp) == 8));
+
+/**
+ * Maps a key to an unsigned integer of the same width that orders the same
+ * way. A signed integer has its sign bit flipped. A float has its sign bit
+ * set if positive, or all of its bits flipped if negative, so that -0.0 comes
+ * before 0.0 and a NaN comes before the negatives or after the positives by
+ * its sign.
+ */
+template <_Radix_key _Tp>
+constexpr auto
+__radix_bits(_Tp x) noexcept
+{
+    if constexpr (std::unsigned_integral<_Tp>)
+        return x;
+    else if constexpr (std::signed_integral<_Tp>)
+    {
+        using bits_type = std::make_unsigned_t<_Tp>;
+        constexpr bits_type sign =
+            bits_type(1) << (std::numeric_limits<bits_type>::digits - 1);
+        return bits_type(bits_type(x) ^ sign);
+    }
+    else
+    {
+        using bits_type = std::conditional_t<sizeof(_Tp) == 4, std::uint32_t,
+                                             std::uint64_t>;
+        constexpr int width = std::numeric_limits<bits_type>::digits;
+        constexpr bits_type sign = bits_type(1) << (width - 1);
+
+        const bits_type bits = std::bit_cast<bits_type>(x);
+        const bits_type mask = bits_type(0) - (bits >> (width - 1));
+        return bits_type(bits ^ (mask | sign));
+    }
+}
+
+// radix_sort() sorts by a digit of 8 bits per pass
+constexpr std::size_t __radix_digit_bits = 8;
+constexpr std::size_t __radix_size = std::size_t(1) << __radix_digit_bits;
+
+/**
+ * Sorts [src, src + n) by the digits [0, passes) of their keys, from the least
+ * significant one, given the counts of each digit. Each pass scatters the
+ * elements from one buffer to the other, and the passes whose digit is the
+ * same for every element are skipped, e.g. the high bytes of small integers.
+ * Returns whether the result is in @a dst rather than in @a src.
+ */
+template <typename _Tp, typename _BitsFn>
+bool
+__radix_sort_lsd(_Tp *src, _Tp *dst, std::size_t n, std::size_t passes,
+                 const std::size_t (*counts)[__radix_size], _BitsFn bits_of)
+{
+    using size_type = std::size_t;
+
+    bool swapped = false;
+    for (size_type p = 0; p < passes; p++)
+    {
+        const size_type shift = p * __radix_digit_bits;
+        if (counts[p][(bits_of(src[0]) >> shift) & (__radix_size - 1)] == n)
+            continue;
+
+        size_type offsets[__radix_size];
+        size_type sum = 0;
+        for (size_type d = 0; d < __radix_size; d++)
+        {
+            offsets[d] = sum;
+            sum += counts[p][d];
+        }
+
+        for (size_type i = 0; i < n; i++)
+        {
+            const size_type digit =
+                (bits_of(src[i]) >> shift) & (__radix_size - 1);
+            dst[offsets[digit]++] = std::move(src[i]);
+        }
+
+        std::swap(src, dst);
+        swapped = !swapped;
+    }
+
+    return swapped;
+}
+
+/**
+ * Sorts [src, src + n) by the digits [0, top) of their keys, from the most
+ * significant one, and leaves the result in @a dst if @a to_dst, else in
+ * @a src. A pass that scatters more elements than the cache holds to 256
+ * places is bound by the misses of its writes, so the elements are scattered
+ * by their most significant digit that varies into buckets, until a bucket
+ * fits in the cache and is sorted from its least significant digit.
+ */
+template <typename _Tp, typename _BitsFn>
+void
+__radix_sort_msd(_Tp *src, _Tp *dst, std::size_t n, std::size_t top,
+                 bool to_dst, _BitsFn bits_of)
+{
+    using size_type = std::size_t;
+    using bits_type = decltype(bits_of(*src));
+
+    constexpr size_type passes      = sizeof(bits_type);
+    constexpr size_type cache_bytes = size_type(1) << 20;
+
+    if (n * sizeof(_Tp) <= cache_bytes || top == 1)
+    {
+        size_type counts[passes][__radix_size] = {};
+        for (size_type i = 0; i < n; i++)
+        {
+            const bits_type bits = bits_of(src[i]);
+            for (size_type p = 0; p < top; p++)
+                counts[p][(bits >> (p * __radix_digit_bits)) &
+                          (__radix_size - 1)]++;
+        }
+
+        if (__radix_sort_lsd(src, dst, n, top, counts, bits_of) != to_dst)
+        {
+            if (to_dst)
+                std::move(src, src + n, dst);
+            else
+                std::move(dst, dst + n, src);
+        }
+        return;
+    }
+
+    // Skips the digits that are the same for every element
+    size_type offsets[__radix_size + 1];
+    size_type shift;
+    for (;; top--)
+    {
+        shift = (top - 1) * __radix_digit_bits;
+        std::fill(offsets, offsets + __radix_size + 1, 0);
+        for (size_type i = 0; i < n; i++)
+            offsets[((bits_of(src[i]) >> shift) & (__radix_size - 1)) + 1]++;
+
+        if (offsets[((bits_of(src[0]) >> shift) & (__radix_size - 1)) + 1] < n)
+            break;
+        if (top == 1)
+        {
+            if (to_dst)
+                std::move(src, src + n, dst);
+            return;
+        }
+    }
+
+    for (size_type d = 0; d < __radix_size; d++)
+        offsets[d + 1] += offsets[d];
+
+    size_type next[__radix_size];
+    std::copy(offsets, offsets + __radix_size, next);
+    for (size_type i = 0; i < n; i++)
+    {
+        const size_type digit = (bits_of(src[i]) >> shift) & (__radix_size - 1);
+        dst[next[digit]++] = std::move(src[i]);
+    }
+
+    // The buckets are in dst now, so they go back to src unless to_dst
+    for (size_type d = 0; d < __radix_size; d++)
+    {
+        const size_type begin = offsets[d];
+        const size_type size  = offsets[d + 1] - begin;
+        if (top > 1 && size > 1)
+            __radix_sort_msd(dst + begin, src + begin, size, top - 1, !to_dst,
+                             bits_of);
+        else if (!to_dst)
+            std::move(dst + begin, dst + begin + size, src + begin);
+    }
+}
+
+/**
+ * Sorts by a digit of 8 bits per pass, with the counts of every digit taken
+ * in a single pass. Short vectors are sorted by insertion instead.
+ */
+template <typename _Tp, typename _KeyFn>
+void
+__radix_sort(vector<_Tp> &v, _KeyFn key)
+{
+    using size_type = std::size_t;
+
+    constexpr size_type threshold = 64;
+
+    const size_type n = v.size();
+    auto bits_of      = [&key](const _Tp &x)
+    { return __radix_bits(std::invoke(key, x)); };
+
+    using bits_type = decltype(bits_of(v[0]));
+
+    if (n < threshold)
+    {
+        for (size_type i = 1; i < n; i++)
+        {
+            _Tp x                = std::move(v[i]);
+            const bits_type bits = bits_of(x);
+            size_type j          = i;
+            for (; j > 0 && bits < bits_of(v[j - 1]); j--)
+                v[j] = std::move(v[j - 1]);
+            v[j] = std::move(x);
+        }
+        return;
+    }
+
+    vector<_Tp> scratch(n);
+    __radix_sort_msd(v.data(), scratch.data(), n, sizeof(bits_type), false,
+                     bits_of);
+}
+
+/**
+ * @brief Sorts a %vector of integers or floats in ascending order with an LSD
+ * radix sort.
+ *
+ * @param v Vector to sort
+ *
+ * Takes O(w n) time for keys of w bytes and a scratch buffer of n elements.
+ * Floats are ordered by their bits: -0.0 comes before 0.0, and NaNs are put
+ * at either end by their sign rather than left anywhere.
+ */
+template <_Radix_key _Tp>
+void
+radix_sort(vector<_Tp> &v)
+{
+    __radix_sort(v, std::identity());
+}
+
+/**
+ * @brief Sorts a %vector of records by an integer or float key with an LSD
+ * radix sort.
+ *
+ * @param v   Vector to sort
+ * @param key Function that returns the key of a record, e.g. a pointer to a
+ *            data member
+ *
+ * The sort is stable: records of equal keys keep their order. The key is
+ * computed again on every pass, so it should be cheap. The records are
+ * moved through a scratch %vector of default-constructed records.
+ */
+template <typename _Tp, typename _KeyFn>
+requires std::default_initializable<_Tp> &&
+         _Radix_key<std::remove_cvref_t<
+             std::invoke_result_t<_KeyFn &, const _Tp &>>>
+void
+radix_sort(vector<_Tp> &v, _KeyFn key)
+{
+    __radix_sort(v, key);
+}
+
+/**
+ * Sorts one chunk of the vector per thread of the pool into a buffer, then
+ * cuts the output into as many parts of the same size, and merges the
+ * elements of each part from the chunks back into the vector. A cut of rank
+ * k is found by selecting the element x of rank k across the chunks: the
+ * elements less than x come before the cut, and the ones equivalent to x are
+ * taken from the first chunks until there are k of them. The chunks are in
+ * the order of the vector and the merge of a part is stable, so the whole
+ * sort is stable if the chunks are sorted stably.
+ */
+template <bool _Stable, typename _Tp, typename _Compare>
+void
+__parallel_merge_sort(vector<_Tp> &v, _Compare comp, thread_pool &pool)
+{
+    using size_type = std::size_t;
+    using span_type = std::span<_Tp>;
+
+    // Below this, the threads would cost more than they save
+    constexpr size_type cutoff = size_type(1) << 15;
+
+    const size_type n       = v.size();
+    const size_type threads = std::min(pool.size(), n / cutoff);
+    if (threads <= 1)
+    {
+        if constexpr (_Stable)
+            std::stable_sort(v.begin(), v.end(), comp);
+        else
+            std::sort(v.begin(), v.end(), comp);
+        return;
+    }
+
+    std::unique_ptr<_Tp[]> buffer = std::make_unique_for_overwrite<_Tp[]>(n);
+    auto bound = [n, threads](size_type i) { return i * n / threads; };
+
+    vector<span_type> chunks(threads);
+    pool.parallel_for(
+        threads,
+        [&](size_type c)
+        {
+            _Tp *first = buffer.get() + bound(c);
+            _Tp *last  = buffer.get() + bound(c + 1);
+            std::move(v.data() + bound(c), v.data() + bound(c + 1), first);
+            if constexpr (_Stable)
+                std::stable_sort(first, last, comp);
+            else
+                std::sort(first, last, comp);
+            chunks[c] = span_type(first, last);
+        });
+
+    // Row i holds where the cut before part i falls in each chunk
+    vector<size_type> cuts((threads + 1) * threads, 0);
+    for (size_type c = 0; c < threads; c++)
+        cuts[threads * threads + c] = chunks[c].size();
+
+    pool.parallel_for(
+        threads - 1,
+        [&](size_type i)
+        {
+            const size_type k = bound(i + 1);
+            size_type *cut    = cuts.data() + (i + 1) * threads;
+
+            vector<size_type> lo(threads, 0);
+            const _Tp &x = __kth_of_sorted_runs(chunks, k, lo, comp);
+
+            size_type left = k;
+            for (size_type c = 0; c < threads; c++)
+                left -= lo[c];
+            for (size_type c = 0; c < threads; c++)
+            {
+                const span_type &chunk = chunks[c];
+                const size_type equal =
+                    std::upper_bound(chunk.begin() + lo[c], chunk.end(), x,
+                                     comp) -
+                    (chunk.begin() + lo[c]);
+                const size_type take = std::min(equal, left);
+                cut[c]               = lo[c] + take;
+                left -= take;
+            }
+        });
+
+    pool.parallel_for(
+        threads,
+        [&](size_type i)
+        {
+            const size_type *from = cuts.data() + i * threads;
+            const size_type *to   = cuts.data() + (i + 1) * threads;
+            _Tp *out              = v.data() + bound(i);
+
+            if constexpr (std::is_trivially_copyable_v<_Tp>)
+            {
+                vector<span_type> runs(threads);
+                for (size_type c = 0; c < threads; c++)
+                    runs[c] = chunks[c].subspan(from[c], to[c] - from[c]);
+                multiway_merge(runs, out, comp);
+            }
+            else
+            {
+                using iter_type = std::move_iterator<_Tp *>;
+
+                vector<std::pair<iter_type, iter_type>> runs(threads);
+                for (size_type c = 0; c < threads; c++)
+                    runs[c] = {iter_type(chunks[c].data() + from[c]),
+                               iter_type(chunks[c].data() + to[c])};
+
+                loser_tree<iter_type, _Compare> tree(runs, comp);
+                for (; !tree.empty(); tree.pop())
+                    *out++ = tree.top();
+            }
+        });
+}
+
+/**
+ * @brief Sorts a %vector on the threads of a pool.
+ *
+ * @param v    Vector to sort
+ * @param comp Comparison object
+ * @param pool Pool of threads to sort on
+ *
+ * Each thread sorts a chunk of the vector, then merges a part of the result
+ * from the sorted chunks, which takes O(n log n / p) time on p threads and a
+ * buffer of n elements. Vectors too small to be worth the threads are sorted
+ * by the calling thread alone.
+ */
+template <typename _Tp, typename _Compare = std::less<>>
+requires std::default_initializable<_Tp>
+void
+parallel_sort(vector<_Tp> &v, _Compare comp = _Compare(),
+              thread_pool &pool = default_thread_pool())
+{
+    __parallel_merge_sort<false>(v, comp, pool);
+}
+
+/**
+ * @brief Sorts a %vector on the threads of a pool, keeping the order of the
+ * equivalent elements.
+ *
+ * @param v    Vector to sort
+ * @param comp Comparison object
+ * @param pool Pool of threads to sort on
+ *
+ * Same as parallel_sort(), with the chunks sorted by std::stable_sort.
+ */
+template <typename _Tp, typename _Compare = std::less<>>
+requires std::default_initializable<_Tp>
+void
+parallel_stable_sort(vector<_Tp> &v, _Compare comp = _Compare(),
+                     thread_pool &pool = default_thread_pool())
+{
+    __parallel_merge_sort<true>(v, comp, pool);
+}
+
+/**
+ * @brief A type sort_small() has a sorting network for.
+ */
+template <typename _Tp>
+concept _Small_sort_key = std::same_as<_Tp, std::int32_t> ||
+                          std::same_as<_Tp, std::int64_t> ||
+                          std::same_as<_Tp, float>;
+
+/**
+ * Moves the lesser of @a a and @a b to @a a, with selects that compile to
+ * conditional moves.
+ */
+template <typename _Tp>
+inline void
+__compare_exchange(_Tp &a, _Tp &b) noexcept
+{
+    const _Tp x     = a, y = b;
+    const bool swap = y < x;
+    a               = swap ? y : x;
+    b               = swap ? x : y;
+}
+
+/**
+ * Bitonic sorting network over _N elements, _N a power of 2. Each merge of
+ * two sorted blocks of size k / 2 first compares element i of a block of k
+ * to element i ^ (k - 1), i.e. the first half to the reversed second half,
+ * then halves of decreasing size, so every compare-exchange puts the lesser
+ * element first.
+ */
+template <typename _Tp, std::size_t _N>
+void
+__sort_network(_Tp *a) noexcept
+{
+    for (std::size_t k = 2; k <= _N; k *= 2)
+    {
+        for (std::size_t i = 0; i < _N; i++)
+            if ((i & (k / 2)) == 0)
+                __compare_exchange(a[i], a[i ^ (k - 1)]);
+
+        for (std::size_t j = k / 4; j > 0; j /= 2)
+            for (std::size_t i = 0; i < _N; i++)
+                if ((i & j) == 0)
+                    __compare_exchange(a[i], a[i ^ j]);
+    }
+}
+
+#ifdef __OPENDSA_SORT_AVX2
+
+/**
+ * Operations on the AVX2 registers of _Tp that __sort_network_avx2 needs.
+ * permute(v, x) moves lane l ^ x to lane l, and blend(a, b, bit) takes the
+ * lanes l of @a b with l & bit clear and the others from @a a.
+ */
+template <typename _Tp>
+struct __avx2_lanes;
+
+template <>
+struct __avx2_lanes<std::int32_t>
+{
+    using value_type                   = std::int32_t;
+    using reg                          = __m256i;
+    constexpr static std::size_t lanes = 8;
+
+    [[gnu::target("avx2")]] static reg
+    load(const value_type *p) noexcept
+    {
+        return _mm256_load_si256(reinterpret_cast<const reg *>(p));
+    }
+
+    [[gnu::target("avx2")]] static void
+    store(value_type *p, reg v) noexcept
+    {
+        _mm256_store_si256(reinterpret_cast<reg *>(p), v);
+    }
+
+    [[gnu::target("avx2")]] static reg
+    min(reg a, reg b) noexcept
+    {
+        return _mm256_min_epi32(a, b);
+    }
+
+    [[gnu::target("avx2")]] static reg
+    max(reg a, reg b) noexcept
+    {
+        return _mm256_max_epi32(a, b);
+    }
+
+    [[gnu::target("avx2")]] static reg
+    permute(reg v, int x) noexcept
+    {
+        return _mm256_permutevar8x32_epi32(
+            v, _mm256_setr_epi32(0 ^ x, 1 ^ x, 2 ^ x, 3 ^ x, 4 ^ x, 5 ^ x,
+                                 6 ^ x, 7 ^ x));
+    }
+
+    [[gnu::target("avx2")]] static reg
+    blend(reg a, reg b, int bit) noexcept
+    {
+        const reg lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const reg mask = _mm256_cmpeq_epi32(
+            _mm256_and_si256(lane, _mm256_set1_epi32(bit)),
+            _mm256_setzero_si256());
+        return _mm256_blendv_epi8(a, b, mask);
+    }
+};
+
+template <>
+struct __avx2_lanes<std::int64_t>
+{
+    using value_type                   = std::int64_t;
+    using reg                          = __m256i;
+    constexpr static std::size_t lanes = 4;
+
+    [[gnu::target("avx2")]] static reg
+    load(const value_type *p) noexcept
+    {
+        return _mm256_load_si256(reinterpret_cast<const reg *>(p));
+    }
+
+    [[gnu::target("avx2")]] static void
+    store(value_type *p, reg v) noexcept
+    {
+        _mm256_store_si256(reinterpret_cast<reg *>(p), v);
+    }
+
+    // AVX2 has no min and max of 64-bit integers
+    [[gnu::target("avx2")]] static reg
+    min(reg a, reg b) noexcept
+    {
+        return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+    }
+
+    [[gnu::target("avx2")]] static reg
+    max(reg a, reg b) noexcept
+    {
+        return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+    }
+
+    [[gnu::target("avx2")]] static reg
+    permute(reg v, int x) noexcept
+    {
+        const int l0 = 2 * (0 ^ x), l1 = 2 * (1 ^ x), l2 = 2 * (2 ^ x),
+                  l3 = 2 * (3 ^ x);
+        return _mm256_permutevar8x32_epi32(
+            v, _mm256_setr_epi32(l0, l0 + 1, l1, l1 + 1, l2, l2 + 1, l3,
+                                 l3 + 1));
+    }
+
+    [[gnu::target("avx2")]] static reg
+    blend(reg a, reg b, int bit) noexcept
+    {
+        const reg lane = _mm256_setr_epi64x(0, 1, 2, 3);
+        const reg mask = _mm256_cmpeq_epi64(
+            _mm256_and_si256(lane, _mm256_set1_epi64x(bit)),
+            _mm256_setzero_si256());
+        return _mm256_blendv_epi8(a, b, mask);
+    }
+};
+
+/**
+ * Compare-exchanges every lane l of @a v with lane l ^ x, keeping the lesser
+ * element in the lanes with l & bit clear.
+ */
+template <typename _Lanes>
+[[gnu::target("avx2")]] inline typename _Lanes::reg
+__avx2_exchange(typename _Lanes::reg v, int x, int bit) noexcept
+{
+    const typename _Lanes::reg w = _Lanes::permute(v, x);
+    return _Lanes::blend(_Lanes::max(v, w), _Lanes::min(v, w), bit);
+}
+
+/**
+ * __sort_network over _Regs registers, with element i in lane i % lanes of
+ * register i / lanes. A compare-exchange between registers is a min and a
+ * max of whole registers, and one within a register compares it to a
+ * permutation of itself and blends the mins and the maxes. The loops have
+ * constant bounds and are unrolled, so the permutations and the blend masks
+ * are constants.
+ */
+template <typename _Tp, std::size_t _Regs>
+[[gnu::target("avx2")]] void
+__sort_network_avx2(_Tp *a) noexcept
+{
+    using lanes_type           = __avx2_lanes<_Tp>;
+    using reg                  = typename lanes_type::reg;
+    constexpr std::size_t L    = lanes_type::lanes;
+    constexpr std::size_t size = _Regs * L;
+
+    reg r[_Regs];
+    for (std::size_t b = 0; b < _Regs; b++)
+        r[b] = lanes_type::load(a + b * L);
+
+    for (std::size_t k = 2; k <= size; k *= 2)
+    {
+        if (k <= L)
+            for (std::size_t b = 0; b < _Regs; b++)
+                r[b] = __avx2_exchange<lanes_type>(r[b], int(k - 1),
+                                                   int(k / 2));
+        else
+        {
+            // The partner of register b is b ^ (k / L - 1), lane reversed
+            const std::size_t kr = k / L;
+            for (std::size_t b = 0; b < _Regs; b++)
+                if ((b & (kr / 2)) == 0)
+                {
+                    const std::size_t p = b ^ (kr - 1);
+
+                    const reg rev = lanes_type::permute(r[p], int(L - 1));
+                    const reg lo  = lanes_type::min(r[b], rev);
+                    const reg hi  = lanes_type::max(r[b], rev);
+                    r[b]          = lo;
+                    r[p]          = lanes_type::permute(hi, int(L - 1));
+                }
+        }
+
+        for (std::size_t j = k / 4; j > 0; j /= 2)
+        {
+            if (j < L)
+            {
+                for (std::size_t b = 0; b < _Regs; b++)
+                    r[b] = __avx2_exchange<lanes_type>(r[b], int(j), int(j));
+                continue;
+            }
+
+            const std::size_t jr = j / L;
+            for (std::size_t b = 0; b < _Regs; b++)
+                if ((b & jr) == 0)
+                {
+                    const reg lo = lanes_type::min(r[b], r[b + jr]);
+                    const reg hi = lanes_type::max(r[b], r[b + jr]);
+                    r[b]         = lo;
+                    r[b + jr]    = hi;
+                }
+        }
+    }
+
+    for (std::size_t b = 0; b < _Regs; b++)
+        lanes_type::store(a + b * L, r[b]);
+}
+
+inline bool
+__has_avx2() noexcept
+{
+    static const bool res = __builtin_cpu_supports("avx2");
+    return res;
+}
+
+#endif /* __OPENDSA_SORT_AVX2 */
+
+/**
+ * Sorts at most 64 integers with the AVX2 network if the CPU has AVX2, found
+ * when the program runs, or the scalar one otherwise. The integers are padded
+ * with the largest one up to a power of 2.
+ */
+template <typename _Tp>
+void
+__sort_small(_Tp *first, std::size_t n)
+{
+    constexpr std::size_t max_size = 64;
+    constexpr _Tp pad              = std::numeric_limits<_Tp>::max();
+
+    alignas(32) _Tp buf[max_size];
+    const std::size_t size = std::bit_ceil(n);
+    std::copy(first, first + n, buf);
+
+#ifdef __OPENDSA_SORT_AVX2
+    if (__has_avx2())
+    {
+        constexpr std::size_t L = __avx2_lanes<_Tp>::lanes;
+        std::fill(buf + n, buf + std::max(size, L), pad);
+        switch (std::max(size, L) / L)
+        {
+        case 1:
+            __sort_network_avx2<_Tp, 1>(buf);
+            break;
+        case 2:
+            __sort_network_avx2<_Tp, 2>(buf);
+            break;
+        case 4:
+            __sort_network_avx2<_Tp, 4>(buf);
+            break;
+        case 8:
+            __sort_network_avx2<_Tp, 8>(buf);
+            break;
+        default:
+            __sort_network_avx2<_Tp, max_size / L>(buf);
+        }
+        std::copy(buf, buf + n, first);
+        return;
+    }
+#endif
+
+    std::fill(buf + n, buf + size, pad);
+    switch (size)
+    {
+    case 2:
+        __sort_network<_Tp, 2>(buf);
+        break;
+    case 4:
+        __sort_network<_Tp, 4>(buf);
+        break;
+    case 8:
+        __sort_network<_Tp, 8>(buf);
+        break;
+    case 16:
+        __sort_network<_Tp, 16>(buf);
+        break;
+    case 32:
+        __sort_network<_Tp, 32>(buf);
+        break;
+    default:
+        __sort_network<_Tp, max_size>(buf);
+    }
+    std::copy(buf, buf + n, first);
+}
+
+/**
+ * Maps a float to an int32 of the same order and back: a negative float has
+ * all of its bits but the sign flipped.
+ */
+inline std::int32_t
+__float_order(std::int32_t bits) noexcept
+{
+    return bits ^ ((bits >> 31) & 0x7fffffff);
+}
+
+/**
+ * @brief Sorts an array of at most 64 integers or floats with a sorting
+ * network.
+ *
+ * @param first Pointer to the first element
+ * @param last  Pointer past the last element
+ *
+ * The array is sorted by a bitonic network, whose sequence of
+ * compare-exchanges does not depend on the values, so sorting many tiny
+ * arrays costs no mispredicted branches. On a CPU with AVX2 the network works
+ * on 8 or 4 elements at once, and it is scalar otherwise. Longer arrays are
+ * sorted by std::sort. Floats are ordered by their bits as by radix_sort():
+ * -0.0 comes before 0.0, and NaNs go at either end by their sign.
+ */
+template <_Small_sort_key _Tp>
+void
+sort_small(_Tp *first, _Tp *last)
+{
+    const std::size_t n = last - first;
+    if (n < 2)
+        return;
+    if constexpr (std::is_same_v<_Tp, float>)
+    {
+        auto order = [](float x)
+        { return __float_order(std::bit_cast<std::int32_t>(x)); };
+        if (n > 64)
+        {
+            std::sort(first, last, [&order](float x, float y)
+                      { return order(x) < order(y); });
+            return;
+        }
+
+        std::int32_t keys[64];
+        for (std::size_t i = 0; i < n; i++)
+            keys[i] = order(first[i]);
+        __sort_small(keys, n);
+        for (std::size_t i = 0; i < n; i++)
+            first[i] = std::bit_cast<float>(__float_order(keys[i]));
+    }
+    else if (n > 64)
+        std::sort(first, last);
+    else
+        __sort_small(first, n);
+}
+
+/**
+ * @brief Sorts a %vector of at most 64 integers or floats with a sorting
+ * network, see sort_small(_Tp *, _Tp *).
+ */
+template <_Small_sort_key _Tp>
+void
+sort_small(vector<_Tp> &v)
+{
+    sort_small(v.data(), v.data() + v.size());
+}
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_SORT_H */
@@ -0,0 +1,478 @@
+/**
+ * @file static_search_tree.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An immutable sorted set laid out for fast searches
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_STATIC_SEARCH_TREE_H
+#define __OPENDSA_STATIC_SEARCH_TREE_H 1
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief Bidirectional iterator over a static_search_tree in ascending order.
+ *
+ * The iterator holds an index in the Eytzinger layout, where the children of
+ * the node at index k are at 2k and 2k + 1. Index 0 is the past-the-end
+ * position.
+ */
+template <typename _Key>
+struct _Eytzinger_iterator
+{
+    using value_type        = _Key;
+    using reference         = const _Key &;
+    using pointer           = const _Key *;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using size_type         = std::size_t;
+
+    const _Key *_data;
+    size_type _size;
+    size_type _index;
+
+    _Eytzinger_iterator() noexcept : _data(nullptr), _size(0), _index(0) { }
+
+    _Eytzinger_iterator(const _Key *data, size_type size,
+                        size_type index) noexcept
+    : _data(data), _size(size), _index(index)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return _data[_index];
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _data + _index;
+    }
+
+    _Eytzinger_iterator &
+    operator++() noexcept
+    {
+        _index = _S_next(_index, _size);
+        return *this;
+    }
+
+    _Eytzinger_iterator
+    operator++(int) noexcept
+    {
+        _Eytzinger_iterator tmp = *this;
+        _index                  = _S_next(_index, _size);
+        return tmp;
+    }
+
+    _Eytzinger_iterator &
+    operator--() noexcept
+    {
+        _index = _S_prev(_index, _size);
+        return *this;
+    }
+
+    _Eytzinger_iterator
+    operator--(int) noexcept
+    {
+        _Eytzinger_iterator tmp = *this;
+        _index                  = _S_prev(_index, _size);
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Eytzinger_iterator &lhs,
+               const _Eytzinger_iterator &rhs) noexcept
+    {
+        return lhs._index == rhs._index;
+    }
+
+    /**
+     * @brief Returns the index of the smallest key, or 0 if there is none.
+     */
+    static size_type
+    _S_first(size_type n) noexcept
+    {
+        if (n == 0)
+            return 0;
+
+        size_type k = 1;
+        while (2 * k <= n)
+            k = 2 * k;
+        return k;
+    }
+
+    /**
+     * @brief Returns the index of the in-order successor of @a k, or 0 for
+     * the largest key.
+     */
+    static size_type
+    _S_next(size_type k, size_type n) noexcept
+    {
+        if (2 * k + 1 <= n)
+        {
+            k = 2 * k + 1;
+            while (2 * k <= n)
+                k = 2 * k;
+            return k;
+        }
+
+        // Climb while k is a right child, then once more to its parent
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    /**
+     * @brief Returns the index of the in-order predecessor of @a k. The
+     * predecessor of the past-the-end index 0 is the largest key.
+     */
+    static size_type
+    _S_prev(size_type k, size_type n) noexcept
+    {
+        if (k == 0)
+        {
+            k = 1;
+            while (2 * k + 1 <= n)
+                k = 2 * k + 1;
+            return k;
+        }
+
+        if (2 * k <= n)
+        {
+            k = 2 * k;
+            while (2 * k + 1 <= n)
+                k = 2 * k + 1;
+            return k;
+        }
+
+        // Climb while k is a left child, then once more to its parent
+        return k >> (std::countr_zero(k) + 1);
+    }
+};
+
+/**
+ * @brief An immutable set of sorted keys, laid out for fast searches.
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Compare Strict weak ordering of the keys.
+ *
+ * The keys are stored in Eytzinger order, i.e. as an implicit binary search
+ * tree in breadth-first order: the root at index 1 and the children of index
+ * k at 2k and 2k + 1. Compared to a binary search over the sorted array, the
+ * first levels of every search share a few cache lines, and the 2^i nodes
+ * i levels below any node are contiguous.
+ *
+ * A search descends the whole height of the tree with a branch-free loop,
+ * k = 2k + (key[k] < x), so there is no branch to mispredict. The array is
+ * aligned on a cache line and the descendants four levels below the current
+ * node are prefetched at every step, so several cache misses of a search are
+ * in flight at once. On arrays much larger than the caches this makes
+ * lower_bound() several times faster than std::lower_bound().
+ *
+ * The tree is built in O(n) from a sorted range and never modified
+ * afterwards; rebuild a new one to change the keys.
+ */
+template <typename _Key, typename _Compare = std::less<_Key>>
+class static_search_tree
+{
+public:
+    using key_type        = _Key;
+    using value_type      = _Key;
+    using key_compare     = _Compare;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_reference = const _Key &;
+    using iterator        = _Eytzinger_iterator<_Key>;
+    using const_iterator  = _Eytzinger_iterator<_Key>;
+
+    /**
+     * @brief Creates an empty %static_search_tree.
+     */
+    static_search_tree() : _comp(), _data(nullptr), _size(0) { }
+
+    /**
+     * @brief Creates a %static_search_tree from a sorted %vector.
+     *
+     * @param sorted Keys sorted by @a comp.
+     * @param comp   Comparison object.
+     */
+    explicit static_search_tree(const vector<_Key> &sorted,
+                                const _Compare &comp = _Compare())
+    : static_search_tree(sorted.cbegin(), sorted.cend(), comp)
+    {
+    }
+
+    /**
+     * @brief Creates a %static_search_tree from a sorted range.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     *
+     * The range must be sorted by @a comp.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static_search_tree(_ForwardIter first, _ForwardIter last,
+                       const _Compare &comp = _Compare())
+    : _comp(comp), _data(nullptr), _size(0)
+    {
+        M_Assert(std::is_sorted(first, last, _comp),
+                 "The keys of a static_search_tree must be sorted");
+        _build(first, static_cast<size_type>(std::distance(first, last)));
+    }
+
+    static_search_tree(const static_search_tree &other)
+    : _comp(other._comp), _data(nullptr), _size(0)
+    {
+        _build(other.begin(), other._size);
+    }
+
+    static_search_tree(static_search_tree &&other) noexcept
+    : _comp(other._comp), _data(other._data), _size(other._size)
+    {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    ~static_search_tree() { _release(); }
+
+    static_search_tree &
+    operator=(const static_search_tree &other)
+    {
+        if (&other != this)
+        {
+            static_search_tree tmp(other);
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    static_search_tree &
+    operator=(static_search_tree &&other) noexcept
+    {
+        if (&other != this)
+        {
+            static_search_tree tmp(std::move(other));
+            swap(tmp);
+        }
+
+        return *this;
+    }
+
+    // Iterators
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_data, _size, iterator::_S_first(_size));
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(_data, _size, 0);
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    // Lookup
+
+    /**
+     * @brief Returns the first key that is not less than @a k.
+     */
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        size_type i = 1;
+        while (i <= _size)
+        {
+            _prefetch(i);
+            i = 2 * i + size_type(_comp(_data[i], k));
+        }
+
+        return const_iterator(_data, _size, _S_resolve(i));
+    }
+
+    /**
+     * @brief Returns the first key that is greater than @a k.
+     */
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        size_type i = 1;
+        while (i <= _size)
+        {
+            _prefetch(i);
+            i = 2 * i + size_type(!_comp(k, _data[i]));
+        }
+
+        return const_iterator(_data, _size, _S_resolve(i));
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        const_iterator it = lower_bound(k);
+        if (it == end() || _comp(k, *it))
+            return end();
+        return it;
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return find(k) != end();
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    // Modifiers
+
+    void
+    swap(static_search_tree &other) noexcept
+    {
+        std::swap(_comp, other._comp);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _comp;
+    }
+
+private:
+    constexpr static std::size_t _S_cache_line = 64;
+    constexpr static std::size_t _S_align =
+        std::max(_S_cache_line, alignof(_Key));
+
+    // Number of keys per cache line. The 16 descendants four levels below
+    // index k start at index 16k.
+    constexpr static size_type _S_per_line =
+        std::max(std::size_t(1), _S_cache_line / sizeof(_Key));
+    constexpr static size_type _S_lookahead =
+        std::min(size_type(16), _S_per_line);
+
+    _Compare _comp;
+    _Key *_data; // 1-based: the root is at _data[1]
+    size_type _size;
+
+    /**
+     * Hints the cache about the nodes a few levels below index @a i. The
+     * address might be past the end of the array, which is harmless for a
+     * prefetch, so it is computed on integers rather than on pointers.
+     */
+    void
+    _prefetch(size_type i) const noexcept
+    {
+        const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(_data) +
+                                    i * _S_lookahead * sizeof(_Key);
+        __builtin_prefetch(reinterpret_cast<const void *>(addr));
+    }
+
+    /**
+     * Maps the index where a search fell off the tree to the last node where
+     * it went left, which holds the result. The bits of the index record the
+     * turns, 1 for right, so that node is found by dropping the trailing
+     * right turns and then the left turn itself. A search that never went
+     * left yields 0, i.e. end().
+     */
+    static size_type
+    _S_resolve(size_type i) noexcept
+    {
+        return i >> (std::countr_one(i) + 1);
+    }
+
+    /**
+     * Copies @a n sorted keys from @a first into a new Eytzinger array,
+     * visiting the indices in order.
+     */
+    template <typename _InputIter>
+    void
+    _build(_InputIter first, size_type n)
+    {
+        if (n == 0)
+            return;
+
+        _Key *data = static_cast<_Key *>(::operator new(
+            (n + 1) * sizeof(_Key), std::align_val_t(_S_align)));
+        size_type built = 0;
+
+        try
+        {
+            size_type k = iterator::_S_first(n);
+            for (; k != 0; k = iterator::_S_next(k, n), ++first)
+            {
+                std::construct_at(data + k, *first);
+                built++;
+            }
+        }
+        catch (...)
+        {
+            // The keys are built in order, so the first ones are alive
+            size_type k = iterator::_S_first(n);
+            for (; built > 0; k = iterator::_S_next(k, n), built--)
+                std::destroy_at(data + k);
+            ::operator delete(data, std::align_val_t(_S_align));
+            throw;
+        }
+
+        _data = data;
+        _size = n;
+    }
+
+    void
+    _release() noexcept
+    {
+        if (_data == nullptr)
+            return;
+
+        for (size_type k = 1; k <= _size; k++)
+            std::destroy_at(_data + k);
+        ::operator delete(_data, std::align_val_t(_S_align));
+
+        _data = nullptr;
+        _size = 0;
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_STATIC_SEARCH_TREE_H */
@@ -0,0 +1,254 @@
+/**
+ * @file thread_pool.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A pool of worker threads for fork-join loops
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_THREAD_POOL_H
+#define __OPENDSA_THREAD_POOL_H 1
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace opendsa
+{
+
+/**
+ * @brief A fixed set of worker threads that run the iterations of loops.
+ *
+ * A loop posted by parallel_for() is shared by the workers and the calling
+ * thread, which all take iterations from a common counter until none is
+ * left, so the iterations are balanced whatever they cost. The calling
+ * thread always works on its own loop, so a loop completes even if every
+ * worker is busy, and an iteration may itself call parallel_for() on the
+ * same pool. The workers sleep when there is no loop to run.
+ *
+ * The pool may be used by several threads at once.
+ */
+class thread_pool
+{
+public:
+    using size_type = std::size_t;
+
+    /**
+     * @brief Creates a %thread_pool.
+     *
+     * @param threads Number of threads that run a loop, counting the thread
+     *                that calls parallel_for(), so @a threads - 1 workers are
+     *                started. Defaults to the number of hardware threads.
+     */
+    explicit thread_pool(size_type threads = _S_hardware_threads())
+    : _workers(), _count(0), _job(), _generation(0), _stop(false)
+    {
+        threads = std::max(threads, size_type(1));
+        _workers.reset(new std::thread[threads - 1]);
+        try
+        {
+            for (; _count < threads - 1; _count++)
+                _workers[_count] = std::thread([this] { _work(); });
+        }
+        catch (...)
+        {
+            _shutdown();
+            throw;
+        }
+    }
+
+    thread_pool(const thread_pool &) = delete;
+
+    thread_pool &
+    operator=(const thread_pool &) = delete;
+
+    /**
+     * @brief Stops the workers once they finish their current iterations.
+     */
+    ~thread_pool() { _shutdown(); }
+
+    /**
+     * @brief Returns the number of threads that run a loop, counting the
+     * calling one.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _count + 1;
+    }
+
+    /**
+     * @brief Calls fn(i) for every i in [0, n) on the threads of the pool,
+     * and returns when every call has returned.
+     *
+     * If a call throws, the iterations that did not start yet are skipped,
+     * and the first exception is rethrown to the caller.
+     */
+    template <typename _Fn>
+    void
+    parallel_for(size_type n, _Fn &&fn)
+    {
+        if (n == 0)
+            return;
+        if (n == 1 || _count == 0)
+        {
+            for (size_type i = 0; i < n; i++)
+                fn(i);
+            return;
+        }
+
+        auto job = std::make_shared<_Job<_Fn>>(n, fn);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = job;
+            _generation++;
+        }
+        _wake.notify_all();
+
+        job->run();
+        job->wait();
+    }
+
+private:
+    /**
+     * A loop shared by the threads. The counters are only touched through
+     * run(), so a worker that gets to a loop after its last iteration
+     * started takes none, and never calls a function that may be gone.
+     */
+    struct _Job_base
+    {
+        std::atomic<size_type> _next;
+        std::atomic<size_type> _done;
+        std::atomic<bool> _failed;
+        size_type _n;
+        std::exception_ptr _error; // Written by the first call that throws
+        std::mutex _mutex;
+        std::condition_variable _finished;
+
+        explicit _Job_base(size_type n)
+        : _next(0), _done(0), _failed(false), _n(n), _error()
+        { }
+
+        virtual ~_Job_base() = default;
+
+        virtual void
+        call(size_type i) = 0;
+
+        void
+        run()
+        {
+            for (size_type i = _next++; i < _n; i = _next++)
+            {
+                try
+                {
+                    if (!_failed.load(std::memory_order_relaxed))
+                        call(i);
+                }
+                catch (...)
+                {
+                    if (!_failed.exchange(true))
+                        _error = std::current_exception();
+                }
+
+                if (_done.fetch_add(1, std::memory_order_acq_rel) + 1 == _n)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _finished.notify_all();
+                }
+            }
+        }
+
+        void
+        wait()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finished.wait(lock, [this] { return _done.load() == _n; });
+            if (_error)
+                std::rethrow_exception(_error);
+        }
+    };
+
+    template <typename _Fn>
+    struct _Job : _Job_base
+    {
+        _Fn &_fn;
+
+        _Job(size_type n, _Fn &fn) : _Job_base(n), _fn(fn) { }
+
+        void
+        call(size_type i) override
+        {
+            _fn(i);
+        }
+    };
+
+    std::unique_ptr<std::thread[]> _workers;
+    size_type _count;
+    std::shared_ptr<_Job_base> _job; // Latest loop posted
+    std::uint64_t _generation;
+    bool _stop;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+
+    static size_type
+    _S_hardware_threads() noexcept
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    void
+    _work()
+    {
+        std::uint64_t seen = 0;
+        for (;;)
+        {
+            std::shared_ptr<_Job_base> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock,
+                           [&] { return _stop || _generation != seen; });
+                if (_stop)
+                    return;
+                seen = _generation;
+                job  = _job;
+            }
+            job->run();
+        }
+    }
+
+    void
+    _shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (size_type i = 0; i < _count; i++)
+            _workers[i].join();
+    }
+};
+
+/**
+ * @brief Returns a pool of one thread per hardware thread, started on first
+ * use, for the parallel algorithms called without a pool.
+ */
+inline thread_pool &
+default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_THREAD_POOL_H */
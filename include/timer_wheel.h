@@ -0,0 +1,402 @@
+/**
+ * @file timer_wheel.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief A hierarchical timer wheel with constant time insert and cancel
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_TIMER_WHEEL_H
+#define __OPENDSA_TIMER_WHEEL_H 1
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief An opaque reference to a timer scheduled in a %timer_wheel.
+ *
+ * A handle stays valid until its timer fires or is cancelled. After that, the
+ * slot may be reused by another timer, but the generation counter makes sure
+ * that a stale handle never cancels the new one.
+ */
+struct timer_handle
+{
+    std::uint32_t _index      = UINT32_MAX;
+    std::uint32_t _generation = 0;
+
+    friend bool
+    operator==(const timer_handle &lhs, const timer_handle &rhs) noexcept
+    {
+        return lhs._index == rhs._index && lhs._generation == rhs._generation;
+    }
+
+    friend bool
+    operator!=(const timer_handle &lhs, const timer_handle &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief A hierarchical timer wheel
+ *
+ * @tparam _Tp       Type of the payload attached to each timer.
+ * @tparam _SlotBits Each level has 2^_SlotBits slots.
+ * @tparam _Levels   Number of levels.
+ *
+ * Level 0 has one slot per tick, and each slot of level l covers
+ * 2^(_SlotBits * l) ticks. A timer is linked into the slot of the lowest level
+ * that can represent its distance from now, so schedule() and cancel() are
+ * O(1). When level 0 wraps around, the current slot of level 1 is cascaded,
+ * i.e. its timers are redistributed into level 0, and so on for the upper
+ * levels.
+ *
+ * Timers live in a single %vector and the slots are intrusive doubly-linked
+ * lists of indices into it. Fired and cancelled timers are recycled through a
+ * free list, so a steady state schedule/cancel workload does not allocate.
+ */
+template <typename _Tp, std::size_t _SlotBits = 8, std::size_t _Levels = 4>
+class timer_wheel
+{
+    static_assert(_SlotBits > 0 && _Levels > 0 && _SlotBits * _Levels <= 64,
+                  "timer_wheel must cover at most 64 bits of ticks");
+
+public:
+    using value_type = _Tp;
+    using size_type  = std::size_t;
+    using tick_type  = std::uint64_t;
+    using handle     = timer_handle;
+
+    /**
+     * @brief Creates an empty %timer_wheel.
+     *
+     * @param start The current tick.
+     */
+    explicit timer_wheel(tick_type start = 0)
+    : _nodes(), _free(_S_nil), _size(0), _now(start)
+    {
+        for (size_type i = 0; i < _S_num_heads; i++)
+            _heads[i] = _S_nil;
+    }
+
+    timer_wheel(const timer_wheel &other) = default;
+
+    /**
+     * @brief Returns the current tick.
+     */
+    tick_type
+    now() const noexcept
+    {
+        return _now;
+    }
+
+    /**
+     * @brief Returns the number of pending timers.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * @brief Returns true if there is no pending timer.
+     */
+    bool
+    empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Returns true if the timer referenced by @a h is still pending.
+     */
+    bool
+    pending(const handle &h) const noexcept
+    {
+        return h._index < _nodes.size() &&
+               _nodes[h._index]._generation == h._generation &&
+               _nodes[h._index]._value.has_value();
+    }
+
+    /**
+     * @brief Schedules a new timer.
+     *
+     * @param expires Tick at which the timer fires.
+     * @param value   Payload handed back when the timer fires.
+     *
+     * A timer that has already expired fires on the next call to advance().
+     */
+    handle
+    schedule(tick_type expires, const value_type &value)
+    {
+        return emplace(expires, value);
+    }
+
+    /**
+     * @brief Schedules a new timer with an rvalue payload.
+     *
+     * @param expires Tick at which the timer fires.
+     * @param value   Payload handed back when the timer fires.
+     */
+    handle
+    schedule(tick_type expires, value_type &&value)
+    {
+        return emplace(expires, std::move(value));
+    }
+
+    /**
+     * @brief Schedules a new timer and constructs its payload in place.
+     *
+     * @param expires Tick at which the timer fires.
+     * @param args    Argument list to create a payload of type _Tp.
+     */
+    template <typename... Args>
+    handle
+    emplace(tick_type expires, Args &&...args)
+    {
+        const std::uint32_t idx = _allocate_node();
+        _Timer_node &node       = _nodes[idx];
+
+        node._value.emplace(std::forward<Args>(args)...);
+        node._expires = (expires > _now) ? expires : _now + 1;
+        _place(idx);
+        ++_size;
+
+        return handle{idx, node._generation};
+    }
+
+    /**
+     * @brief Cancels a pending timer.
+     *
+     * @param h Handle returned by schedule().
+     *
+     * Returns false if the timer has already fired or been cancelled.
+     */
+    bool
+    cancel(const handle &h)
+    {
+        if (!pending(h))
+            return false;
+
+        _unlink(h._index);
+        _release_node(h._index);
+        --_size;
+
+        return true;
+    }
+
+    /**
+     * @brief Moves the wheel forward and fires every expired timer.
+     *
+     * @param now  The new current tick.
+     * @param fire Callable invoked with the payload of each expired timer.
+     *
+     * Returns the number of fired timers. @a fire may schedule and cancel
+     * timers. A timer it schedules expires one tick after the tick being
+     * processed at the earliest, so it fires in the same call if it expires
+     * by @a now. One scheduled while the tick @a now is processed is left
+     * for the next call, even if it was given an earlier tick.
+     */
+    template <typename _Fn>
+    size_type
+    advance(tick_type now, _Fn &&fire)
+    {
+        size_type fired = 0;
+
+        while (_now < now)
+        {
+            if (_size == 0)
+            {
+                _now = now;
+                break;
+            }
+
+            ++_now;
+            if ((_now & _S_slot_mask) == 0)
+                _cascade(1);
+
+            std::uint32_t &head = _heads[_now & _S_slot_mask];
+            while (head != _S_nil)
+            {
+                const std::uint32_t idx = head;
+                _unlink(idx);
+
+                value_type value = std::move(*_nodes[idx]._value);
+                _release_node(idx);
+                --_size;
+                ++fired;
+
+                fire(std::move(value));
+            }
+        }
+
+        return fired;
+    }
+
+    /**
+     * @brief Moves the wheel forward and collects every expired payload.
+     *
+     * @param now     The new current tick.
+     * @param expired Vector that receives the expired payloads in batch.
+     *
+     * Returns the number of fired timers.
+     */
+    size_type
+    advance(tick_type now, opendsa::vector<value_type> &expired)
+    {
+        return advance(now, [&expired](value_type &&value)
+                       { expired.push_back(std::move(value)); });
+    }
+
+    /**
+     * @brief Cancels every pending timer without firing them.
+     */
+    void
+    clear()
+    {
+        for (size_type i = 0; i < _S_num_heads; i++)
+        {
+            while (_heads[i] != _S_nil)
+            {
+                const std::uint32_t idx = _heads[i];
+                _unlink(idx);
+                _release_node(idx);
+            }
+        }
+
+        _size = 0;
+    }
+
+private:
+    constexpr static std::uint32_t _S_nil   = UINT32_MAX;
+    constexpr static size_type _S_num_slots = size_type(1) << _SlotBits;
+    constexpr static size_type _S_num_heads = _S_num_slots * _Levels;
+    constexpr static tick_type _S_slot_mask = _S_num_slots - 1;
+
+    struct _Timer_node
+    {
+        std::optional<value_type> _value;
+        tick_type _expires        = 0;
+        std::uint32_t _prev       = _S_nil;
+        std::uint32_t _next       = _S_nil;
+        std::uint32_t _head       = _S_nil; // Slot this timer is linked into
+        std::uint32_t _generation = 0;
+    };
+
+    opendsa::vector<_Timer_node> _nodes;
+    std::uint32_t _heads[_S_num_heads];
+    std::uint32_t _free; // Head of the free list, linked through _next
+    size_type _size;
+    tick_type _now;
+
+    std::uint32_t
+    _allocate_node()
+    {
+        if (_free != _S_nil)
+        {
+            const std::uint32_t idx = _free;
+            _free                   = _nodes[idx]._next;
+            return idx;
+        }
+
+        _nodes.push_back(_Timer_node());
+        return std::uint32_t(_nodes.size() - 1);
+    }
+
+    void
+    _release_node(std::uint32_t idx)
+    {
+        _Timer_node &node = _nodes[idx];
+
+        node._value.reset();
+        node._generation++;
+        node._next = _free;
+        _free      = idx;
+    }
+
+    /**
+     * Links a timer into the slot of the lowest level whose range covers the
+     * distance between now and its expiry. Timers beyond the range of the top
+     * level go to the top level and are re-placed every time they cascade.
+     */
+    void
+    _place(std::uint32_t idx)
+    {
+        _Timer_node &node     = _nodes[idx];
+        const tick_type delta = node._expires - _now;
+
+        size_type level = 0;
+        while (level + 1 < _Levels &&
+               (delta >> (_SlotBits * (level + 1))) != 0)
+            level++;
+
+        const size_type slot = (node._expires >> (_SlotBits * level)) &
+                               _S_slot_mask;
+        const std::uint32_t head = level * _S_num_slots + slot;
+
+        node._head = head;
+        node._prev = _S_nil;
+        node._next = _heads[head];
+        if (_heads[head] != _S_nil)
+            _nodes[_heads[head]]._prev = idx;
+        _heads[head] = idx;
+    }
+
+    void
+    _unlink(std::uint32_t idx)
+    {
+        _Timer_node &node = _nodes[idx];
+
+        if (node._prev != _S_nil)
+            _nodes[node._prev]._next = node._next;
+        else
+            _heads[node._head] = node._next;
+
+        if (node._next != _S_nil)
+            _nodes[node._next]._prev = node._prev;
+
+        node._head = _S_nil;
+    }
+
+    /**
+     * Redistributes the current slot of @a level into the lower levels. This
+     * is called whenever the level below wraps around, and recurses when this
+     * level wraps around as well.
+     */
+    void
+    _cascade(size_type level)
+    {
+        if (level >= _Levels)
+            return;
+
+        const size_type slot = (_now >> (_SlotBits * level)) & _S_slot_mask;
+        if (slot == 0)
+            _cascade(level + 1);
+
+        // Detach the whole list first: a timer beyond the range of the top
+        // level may be placed back into the very same slot.
+        std::uint32_t idx = _heads[level * _S_num_slots + slot];
+        _heads[level * _S_num_slots + slot] = _S_nil;
+
+        while (idx != _S_nil)
+        {
+            const std::uint32_t next = _nodes[idx]._next;
+            _place(idx);
+            idx = next;
+        }
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_TIMER_WHEEL_H */
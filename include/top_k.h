@@ -0,0 +1,271 @@
+/**
+ * @file top_k.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief Selection of the k first elements of a range or of a stream
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_TOP_K_H
+#define __OPENDSA_TOP_K_H 1
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief Keeps the k first elements of a stream in the order of a
+ * comparison, e.g. the k greatest with std::greater.
+ *
+ * @tparam _Tp      Type of the elements.
+ * @tparam _Compare Strict weak ordering, where the first elements are the
+ *                  ones kept.
+ *
+ * The elements kept are a binary heap whose root is the last of them, which
+ * is the threshold a new element has to beat. Once k elements are kept, an
+ * element that does not beat it costs a single comparison, and one that does
+ * replaces the root and sifts down in O(log k). Pushing n elements in random
+ * order thus takes O(n + k log k log(n / k)) time, and O(k) memory.
+ *
+ * Which of several equivalent elements are kept is unspecified.
+ */
+template <typename _Tp, typename _Compare = std::greater<>>
+class top_k_accumulator
+{
+public:
+    using value_type  = _Tp;
+    using size_type   = std::size_t;
+    using key_compare = _Compare;
+
+    /**
+     * @brief Creates an empty %top_k_accumulator.
+     *
+     * @param k    Number of elements to keep
+     * @param comp Comparison object
+     *
+     * Nothing is allocated up front, so that a large k only costs memory if
+     * as many elements are pushed. See reserve().
+     */
+    explicit top_k_accumulator(size_type k, const _Compare &comp = _Compare())
+    : _comp(comp), _k(k), _heap()
+    {
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _heap.size() == 0;
+    }
+
+    /**
+     * @brief Returns the number of elements kept, at most k.
+     */
+    size_type
+    size() const noexcept
+    {
+        return _heap.size();
+    }
+
+    size_type
+    k() const noexcept
+    {
+        return _k;
+    }
+
+    /**
+     * @brief Makes room for @a n elements, or k if it is less, e.g. the size
+     * of a stream known in advance.
+     */
+    void
+    reserve(size_type n)
+    {
+        _heap.reserve(std::min(n, _k));
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Offers an element, which is kept if it is among the k first
+     * elements offered so far.
+     */
+    void
+    push(const value_type &x)
+    {
+        if (_heap.size() < _k)
+        {
+            _heap.push_back(x);
+            _sift_up(_heap.size() - 1);
+        }
+        else if (_k > 0 && _comp(x, _heap[0]))
+        {
+            _heap[0] = x;
+            _sift_down(0);
+        }
+    }
+
+    /**
+     * @brief Offers a range of elements.
+     */
+    template <std::input_iterator _InputIter>
+    void
+    push(_InputIter first, _InputIter last)
+    {
+        if constexpr (std::sized_sentinel_for<_InputIter, _InputIter>)
+            reserve(_heap.size() + static_cast<size_type>(last - first));
+
+        for (; first != last; ++first)
+            push(*first);
+    }
+
+    /**
+     * @brief Offers the elements kept by @a other, e.g. the accumulator of
+     * another thread.
+     */
+    void
+    merge(const top_k_accumulator &other)
+    {
+        reserve(_heap.size() + other._heap.size());
+        for (size_type i = 0; i < other._heap.size(); i++)
+            push(other._heap[i]);
+    }
+
+    void
+    clear() noexcept
+    {
+        _heap.clear();
+    }
+
+    // Queries
+
+    /**
+     * @brief Returns the last element kept, which an element has to come
+     * before to be kept once k elements are.
+     */
+    const value_type &
+    threshold() const
+    {
+        M_Assert(!empty(), "The accumulator is empty");
+        return _heap[0];
+    }
+
+    /**
+     * @brief Returns the elements kept, in the order of the comparison.
+     */
+    vector<value_type>
+    sorted() const
+    {
+        vector<value_type> res(_heap);
+        std::sort(res.begin(), res.end(), _comp);
+        return res;
+    }
+
+private:
+    _Compare _comp;
+    size_type _k;
+    vector<value_type> _heap;
+
+    // The parent of a node never comes before its children
+    void
+    _sift_up(size_type i)
+    {
+        value_type x = std::move(_heap[i]);
+        while (i > 0)
+        {
+            const size_type parent = (i - 1) / 2;
+            if (!_comp(_heap[parent], x))
+                break;
+            _heap[i] = std::move(_heap[parent]);
+            i        = parent;
+        }
+        _heap[i] = std::move(x);
+    }
+
+    void
+    _sift_down(size_type i)
+    {
+        const size_type n = _heap.size();
+        value_type x      = std::move(_heap[i]);
+        for (size_type child = 2 * i + 1; child < n; child = 2 * i + 1)
+        {
+            if (child + 1 < n && _comp(_heap[child], _heap[child + 1]))
+                child++;
+            if (!_comp(x, _heap[child]))
+                break;
+            _heap[i] = std::move(_heap[child]);
+            i        = child;
+        }
+        _heap[i] = std::move(x);
+    }
+};
+
+/**
+ * @brief Returns the k first elements of a range in the order of a
+ * comparison, sorted, e.g. the k greatest with the default std::greater.
+ *
+ * @param range Input range
+ * @param k     Number of elements to select
+ * @param comp  Comparison object
+ *
+ * When k is small against the size n of the range, the elements go through
+ * a %top_k_accumulator, which reads the range once and keeps only k of them.
+ * Otherwise most elements would enter the heap, so a range of known size is
+ * copied and partitioned around its k-th element by introselect
+ * (std::nth_element) in O(n) time, and the first k are then sorted. A range
+ * whose size is not known always goes through the heap.
+ */
+template <std::ranges::input_range _Range, typename _Compare = std::greater<>>
+vector<std::ranges::range_value_t<_Range>>
+top_k(_Range &&range, std::size_t k, _Compare comp = _Compare())
+{
+    using value_type = std::ranges::range_value_t<_Range>;
+
+    // Below n / k = 32, enough elements beat the threshold of the heap to
+    // make introselect faster
+    constexpr std::size_t heap_ratio = 32;
+
+    if constexpr (std::ranges::sized_range<_Range>)
+    {
+        const std::size_t n = std::ranges::size(range);
+        if (k > n / heap_ratio)
+        {
+            vector<value_type> all;
+            all.reserve(n);
+            for (auto &&x : range)
+                all.push_back(x);
+
+            k = std::min(k, n);
+            std::nth_element(all.begin(), all.begin() + k, all.end(), comp);
+
+            vector<value_type> res;
+            res.reserve(k);
+            for (std::size_t i = 0; i < k; i++)
+                res.push_back(std::move(all[i]));
+            std::sort(res.begin(), res.end(), comp);
+            return res;
+        }
+    }
+
+    top_k_accumulator<value_type, _Compare> acc(k, comp);
+    if constexpr (std::ranges::sized_range<_Range>)
+        acc.reserve(static_cast<std::size_t>(std::ranges::size(range)));
+    for (auto &&x : range)
+        acc.push(x);
+    return acc.sorted();
+}
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_TOP_K_H */
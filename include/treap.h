@@ -0,0 +1,1196 @@
+/**
+ * @file treap.h
+ * @author Richard Nguyen (richard.ng0616@gmail.com)
+ * @brief An ordered set with fast split, join and bulk set operations
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2022
+ */
+
+#ifndef __OPENDSA_TREAP_H
+#define __OPENDSA_TREAP_H 1
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "helper.h"
+#include "vector.h"
+
+namespace opendsa
+{
+
+/**
+ * @brief A node of a treap.
+ *
+ * The priority is a hash of the address of the node, which is as good as a
+ * random number for the balance of the tree and needs no generator. It is
+ * stored, so that a copied node keeps the priority of the original.
+ */
+template <typename _Val>
+struct _Treap_node
+{
+    _Treap_node *_parent;
+    _Treap_node *_left;
+    _Treap_node *_right;
+    std::size_t _size;
+    std::uint64_t _priority;
+    _Val _value;
+
+    template <typename... Args>
+    _Treap_node(Args &&...args)
+    : _parent(nullptr), _left(nullptr), _right(nullptr), _size(1),
+      _priority(_S_hash(reinterpret_cast<std::uintptr_t>(this))),
+      _value(std::forward<Args>(args)...)
+    {
+    }
+
+    // The finalizer of splitmix64
+    static std::uint64_t
+    _S_hash(std::uint64_t x) noexcept
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+/**
+ * @brief Bidirectional iterator over a treap.
+ *
+ * The root has no parent, and the past-the-end position is the null node.
+ * A past-the-end iterator also keeps a node of its treap, the last element
+ * it pointed to or the root when it comes from end(), and is decremented by
+ * climbing to the root from there. It does not depend on the address of the
+ * set, so it follows the nodes through a swap or a move like the other
+ * iterators, but it can no longer be decremented once that node is erased,
+ * nor if the set was empty.
+ */
+template <typename _Val>
+struct _Treap_iterator
+{
+    using value_type        = _Val;
+    using reference         = const _Val &;
+    using pointer           = const _Val *;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type = _Treap_node<_Val>;
+
+    const node_type *_node;
+    const node_type *_anchor; // For a past-the-end iterator to climb from
+
+    _Treap_iterator() noexcept : _node(nullptr), _anchor(nullptr) { }
+
+    _Treap_iterator(const node_type *node, const node_type *anchor) noexcept
+    : _node(node), _anchor(anchor)
+    {
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return _node->_value;
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return &_node->_value;
+    }
+
+    _Treap_iterator &
+    operator++() noexcept
+    {
+        const node_type *x = _node;
+        if (x->_right != nullptr)
+        {
+            x = x->_right;
+            while (x->_left != nullptr)
+                x = x->_left;
+            _node = x;
+            return *this;
+        }
+
+        const node_type *y = x->_parent;
+        while (y != nullptr && x == y->_right)
+        {
+            x = y;
+            y = y->_parent;
+        }
+        if (y == nullptr)
+            _anchor = _node;
+        _node = y;
+        return *this;
+    }
+
+    _Treap_iterator
+    operator++(int) noexcept
+    {
+        _Treap_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    _Treap_iterator &
+    operator--() noexcept
+    {
+        const node_type *x = _node;
+        if (x == nullptr || x->_left != nullptr)
+        {
+            if (x == nullptr)
+            {
+                x = _anchor;
+                while (x->_parent != nullptr)
+                    x = x->_parent;
+            }
+            else
+                x = x->_left;
+
+            while (x->_right != nullptr)
+                x = x->_right;
+            _node = x;
+            return *this;
+        }
+
+        const node_type *y = x->_parent;
+        while (y != nullptr && x == y->_left)
+        {
+            x = y;
+            y = y->_parent;
+        }
+        _node = y;
+        return *this;
+    }
+
+    _Treap_iterator
+    operator--(int) noexcept
+    {
+        _Treap_iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Treap_iterator &lhs, const _Treap_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+};
+
+/**
+ * @brief An ordered set of unique keys based on a treap, with split and join
+ * in O(log n) and bulk set operations.
+ *
+ * @tparam _Key     Type of the keys.
+ * @tparam _Compare Strict weak ordering of the keys.
+ * @tparam _Alloc   User-defined allocator.
+ *
+ * A treap is a binary search tree whose nodes are also heap-ordered by random
+ * priorities, so it has the shape of a tree built by random insertions, of
+ * expected height O(log n). Its shape only depends on its keys, so splitting
+ * a treap at a key or joining two treaps are both a single descent.
+ *
+ * unite(), intersect() and subtract() are built on split and join: the set
+ * whose root has the higher priority keeps its root, the other set is split
+ * at the key of that root, and the two halves are combined recursively. They
+ * take O(m log(n / m + 1)) expected time for sets of m <= n keys, rather than
+ * the O(m + n) of a merge, i.e. O(m log n) to combine a small set with a large
+ * one and O(n) for sets of similar sizes. The two recursive calls work on
+ * disjoint subtrees, so above _S_parallel_cutoff keys they are forked to
+ * std::async, up to about twice as many tasks as there are hardware threads.
+ *
+ * The set operations consume their argument and relink its nodes into this
+ * set without any allocation, so both sets must use equal allocators. They
+ * deallocate the nodes of the removed keys once the threads are joined, and
+ * leave the sets in an unspecified state if the comparison object throws.
+ *
+ * Each node counts the nodes of its subtree, so size() is O(1) after a set
+ * operation.
+ */
+template <typename _Key, typename _Compare = std::less<_Key>,
+          typename _Alloc = std::allocator<_Key>>
+class treap_set
+{
+public:
+    using key_type        = _Key;
+    using value_type      = _Key;
+    using key_compare     = _Compare;
+    using value_compare   = _Compare;
+    using allocator_type  = _Alloc;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using const_iterator  = _Treap_iterator<value_type>;
+    using iterator        = const_iterator;
+
+private:
+    using _Node      = _Treap_node<value_type>;
+    using _Node_ptr  = _Node *;
+    using _Const_ptr = const _Node *;
+
+    using _Node_alloc_type =
+        typename std::allocator_traits<_Alloc>::template rebind_alloc<_Node>;
+    using _Node_alloc_traits = std::allocator_traits<_Node_alloc_type>;
+    using _Propagate_on_copy =
+        typename _Node_alloc_traits::propagate_on_container_copy_assignment;
+    using _Propagate_on_move =
+        typename _Node_alloc_traits::propagate_on_container_move_assignment;
+    using _Propagate_on_swap =
+        typename _Node_alloc_traits::propagate_on_container_swap;
+
+public:
+    /**
+     * @brief Minimum number of keys in the two operands of a set operation
+     * for its recursive calls to run in parallel.
+     */
+    constexpr static size_type _S_parallel_cutoff = size_type(1) << 16;
+
+    /**
+     * @brief Creates an empty %treap_set.
+     */
+    treap_set() : _comp(), _alloc(), _root(nullptr) { }
+
+    /**
+     * @brief Creates an empty %treap_set with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit treap_set(const _Compare &comp, const _Alloc &alloc = _Alloc())
+    : _comp(comp), _alloc(alloc), _root(nullptr)
+    {
+    }
+
+    /**
+     * @brief Creates a %treap_set from a range.
+     *
+     * @param first An input iterator to mark the range.
+     * @param last  An input iterator to mark the range.
+     */
+    template <std::input_iterator _InputIter>
+    treap_set(_InputIter first, _InputIter last,
+              const _Compare &comp = _Compare(),
+              const _Alloc &alloc  = _Alloc())
+    : treap_set(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    /**
+     * @brief Creates a %treap_set based on an initializer list.
+     *
+     * @param list An initializer list.
+     */
+    treap_set(std::initializer_list<value_type> list,
+              const _Compare &comp = _Compare(),
+              const _Alloc &alloc  = _Alloc())
+    : treap_set(list.begin(), list.end(), comp, alloc)
+    {
+    }
+
+    /**
+     * @brief Creates a %treap_set from a sorted range in linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The range must be sorted by @a comp and free of duplicates. The treap
+     * is built in one pass, as a Cartesian tree of the priorities.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static treap_set
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        treap_set res(comp, alloc);
+        res._root = res._build_sorted(first, last);
+        return res;
+    }
+
+    treap_set(const treap_set &other)
+    : _comp(other._comp),
+      _alloc(_Node_alloc_traits::select_on_container_copy_construction(
+          other._alloc)),
+      _root(nullptr)
+    {
+        _root = _copy(other._root, nullptr);
+    }
+
+    treap_set(treap_set &&other) noexcept
+    : _comp(other._comp), _alloc(std::move(other._alloc)), _root(other._root)
+    {
+        other._root = nullptr;
+    }
+
+    ~treap_set() { _erase_subtree(_root); }
+
+    /**
+     * @brief Copies another set into nodes from the allocator this set ends
+     * up with, i.e. the one of @a other if it propagates on copy assignment.
+     */
+    treap_set &
+    operator=(const treap_set &other)
+    {
+        if (&other == this)
+            return *this;
+
+        clear();
+        if constexpr (_Propagate_on_copy::value)
+            _alloc = other._alloc;
+        _comp = other._comp;
+        _root = _copy(other._root, nullptr);
+
+        return *this;
+    }
+
+    /**
+     * @brief Takes the nodes of another set if the allocator propagates on
+     * move assignment or the allocators are equal, otherwise moves its keys
+     * into nodes from the allocator of this set.
+     */
+    treap_set &
+    operator=(treap_set &&other) noexcept(
+        _Propagate_on_move::value || _Node_alloc_traits::is_always_equal::value)
+    {
+        if (&other == this)
+            return *this;
+
+        clear();
+        _comp = other._comp;
+
+        if (_Propagate_on_move::value || _alloc == other._alloc)
+        {
+            if constexpr (_Propagate_on_move::value)
+                _alloc = std::move(other._alloc);
+            _root       = other._root;
+            other._root = nullptr;
+        }
+        else
+        {
+            _root = _copy<true>(other._root, nullptr);
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _comp;
+    }
+
+    value_compare
+    value_comp() const
+    {
+        return _comp;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_alloc);
+    }
+
+    // Iterators
+
+    const_iterator
+    begin() const noexcept
+    {
+        _Const_ptr x = _root;
+        if (x != nullptr)
+            while (x->_left != nullptr)
+                x = x->_left;
+        return const_iterator(x, _root);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(nullptr, _root);
+    }
+
+    const_iterator
+    cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator
+    cend() const noexcept
+    {
+        return end();
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _root == nullptr;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _S_size(_root);
+    }
+
+    // Modifiers
+
+    std::pair<iterator, bool>
+    insert(const value_type &x)
+    {
+        const_iterator it = find(x);
+        if (it != end())
+            return {it, false};
+        return {_insert_node(_create_node(x)), true};
+    }
+
+    std::pair<iterator, bool>
+    insert(value_type &&x)
+    {
+        const_iterator it = find(x);
+        if (it != end())
+            return {it, false};
+        return {_insert_node(_create_node(std::move(x))), true};
+    }
+
+    template <std::input_iterator _InputIter>
+    void
+    insert(_InputIter first, _InputIter last)
+    {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> list)
+    {
+        insert(list.begin(), list.end());
+    }
+
+    /**
+     * @brief Inserts a sorted range of keys.
+     *
+     * The range must be sorted by @a comp and free of duplicates, but might
+     * contain keys of this set. It is built into a treap in linear time and
+     * then united with this set.
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        unite(from_sorted(first, last, _comp, allocator_type(_alloc)));
+    }
+
+    /**
+     * @brief Constructs a new key in place unless it already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    emplace(Args &&...args)
+    {
+        _Node_ptr z       = _create_node(std::forward<Args>(args)...);
+        const_iterator it = find(z->_value);
+        if (it != end())
+        {
+            _drop_node(z);
+            return {it, false};
+        }
+        return {_insert_node(z), true};
+    }
+
+    /**
+     * @brief Removes the key at @a pos and returns the iterator following
+     * it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        M_Assert(pos != end(), "Erasing the past-the-end iterator");
+        const_iterator next = std::next(pos);
+        _erase_node(const_cast<_Node_ptr>(pos._node));
+        return next;
+    }
+
+    /**
+     * @brief Removes the key @a k, if any, and returns the number of removed
+     * keys.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    void
+    clear() noexcept
+    {
+        _erase_subtree(_root);
+        _root = nullptr;
+    }
+
+    /**
+     * @brief Swaps the content of two sets in constant time. The allocators
+     * must be equal unless they propagate on swap.
+     */
+    void
+    swap(treap_set &other) noexcept
+    {
+        std::swap(_comp, other._comp);
+        if constexpr (_Propagate_on_swap::value)
+            std::swap(_alloc, other._alloc);
+        else
+            M_Assert(_alloc == other._alloc,
+                     "Swapping sets of unequal allocators");
+        std::swap(_root, other._root);
+    }
+
+    /**
+     * @brief Moves the keys that are not less than @a k to a new set, in
+     * O(log n).
+     */
+    treap_set
+    split(const key_type &k)
+    {
+        treap_set res(_comp, allocator_type(_alloc));
+        _Node_ptr left, right;
+        _Node_ptr found = _split(_root, k, left, right);
+        if (found != nullptr)
+            right = _S_join(found, right);
+
+        _root     = _S_detach(left);
+        res._root = _S_detach(right);
+        return res;
+    }
+
+    /**
+     * @brief Appends the keys of @a other, which must all be greater than the
+     * keys of this set, in O(log n).
+     */
+    void
+    join(treap_set &&other)
+    {
+        M_Assert(_alloc == other._alloc, "Joining sets of unequal allocators");
+        M_Assert(empty() || other.empty() ||
+                     _comp(*std::prev(end()), *other.begin()),
+                 "The joined keys must be greater than those of the set");
+        _root       = _S_detach(_S_join(_root, other._root));
+        other._root = nullptr;
+    }
+
+    /**
+     * @brief Adds the keys of @a other to this set.
+     *
+     * The nodes of @a other are moved into this set, and @a other is left
+     * empty. Takes O(m log(n / m + 1)) expected time for sets of m <= n keys,
+     * in parallel for large sets.
+     */
+    void
+    unite(treap_set &&other)
+    {
+        _Garbage garbage;
+        _root = _combine<_Union>(std::move(other), garbage);
+        _free(garbage);
+    }
+
+    /**
+     * @brief Adds a copy of the keys of @a other to this set.
+     *
+     * @a other is copied first, so this is better suited to a small @a other.
+     */
+    void
+    unite(const treap_set &other)
+    {
+        unite(treap_set(other));
+    }
+
+    /**
+     * @brief Removes the keys that are not in @a other from this set.
+     *
+     * @a other is left empty. Takes O(m log(n / m + 1)) expected time for sets
+     * of m <= n keys, in parallel for large sets.
+     */
+    void
+    intersect(treap_set &&other)
+    {
+        _Garbage garbage;
+        _root = _combine<_Intersection>(std::move(other), garbage);
+        _free(garbage);
+    }
+
+    void
+    intersect(const treap_set &other)
+    {
+        intersect(treap_set(other));
+    }
+
+    /**
+     * @brief Removes the keys of @a other from this set.
+     *
+     * @a other is left empty. Takes O(m log(n / m + 1)) expected time for sets
+     * of m <= n keys, in parallel for large sets.
+     */
+    void
+    subtract(treap_set &&other)
+    {
+        _Garbage garbage;
+        _root = _combine<_Difference>(std::move(other), garbage);
+        _free(garbage);
+    }
+
+    void
+    subtract(const treap_set &other)
+    {
+        subtract(treap_set(other));
+    }
+
+    // Lookup
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        _Const_ptr x = _root;
+        while (x != nullptr)
+        {
+            if (_comp(k, x->_value))
+                x = x->_left;
+            else if (_comp(x->_value, k))
+                x = x->_right;
+            else
+                break;
+        }
+        return const_iterator(x, _root);
+    }
+
+    bool
+    contains(const key_type &k) const
+    {
+        return find(k) != end();
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        return contains(k) ? 1 : 0;
+    }
+
+    /**
+     * @brief Returns the first key that is not less than @a k.
+     */
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        _Const_ptr res = nullptr;
+        for (_Const_ptr x = _root; x != nullptr;)
+        {
+            if (!_comp(x->_value, k))
+            {
+                res = x;
+                x   = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+        return const_iterator(res, _root);
+    }
+
+    /**
+     * @brief Returns the first key that is greater than @a k.
+     */
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        _Const_ptr res = nullptr;
+        for (_Const_ptr x = _root; x != nullptr;)
+        {
+            if (_comp(k, x->_value))
+            {
+                res = x;
+                x   = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+        return const_iterator(res, _root);
+    }
+
+private:
+    enum _Set_operation
+    {
+        _Union,
+        _Intersection,
+        _Difference
+    };
+
+    /**
+     * The subtrees removed by a set operation, chained through the parent
+     * pointers of their roots. They are freed by the calling thread, so the
+     * allocator is never used concurrently.
+     */
+    struct _Garbage
+    {
+        _Node_ptr _head = nullptr;
+        _Node_ptr _tail = nullptr;
+
+        void
+        push(_Node_ptr x) noexcept
+        {
+            if (x == nullptr)
+                return;
+
+            x->_parent = nullptr;
+            if (_tail == nullptr)
+                _head = x;
+            else
+                _tail->_parent = x;
+            _tail = x;
+        }
+
+        void
+        splice(_Garbage &other) noexcept
+        {
+            if (other._head == nullptr)
+                return;
+
+            if (_tail == nullptr)
+                _head = other._head;
+            else
+                _tail->_parent = other._head;
+            _tail = other._tail;
+        }
+    };
+
+    _Compare _comp;
+    _Node_alloc_type _alloc;
+    _Node_ptr _root;
+
+    static size_type
+    _S_size(_Const_ptr x) noexcept
+    {
+        return x == nullptr ? 0 : x->_size;
+    }
+
+    /**
+     * Recomputes the size of @a x and links its children back to it.
+     */
+    static void
+    _S_pull(_Node_ptr x) noexcept
+    {
+        x->_size = 1 + _S_size(x->_left) + _S_size(x->_right);
+        if (x->_left != nullptr)
+            x->_left->_parent = x;
+        if (x->_right != nullptr)
+            x->_right->_parent = x;
+    }
+
+    /**
+     * Makes @a x the root of a tree.
+     */
+    static _Node_ptr
+    _S_detach(_Node_ptr x) noexcept
+    {
+        if (x != nullptr)
+            x->_parent = nullptr;
+        return x;
+    }
+
+    /**
+     * Joins the treaps @a l and @a r, where the keys of @a l are less than
+     * those of @a r, by merging their facing spines by priority.
+     */
+    static _Node_ptr
+    _S_join(_Node_ptr l, _Node_ptr r) noexcept
+    {
+        if (l == nullptr)
+            return r;
+        if (r == nullptr)
+            return l;
+
+        if (l->_priority > r->_priority)
+        {
+            l->_right = _S_join(l->_right, r);
+            _S_pull(l);
+            return l;
+        }
+
+        r->_left = _S_join(l, r->_left);
+        _S_pull(r);
+        return r;
+    }
+
+    /**
+     * Splits the treap @a x into the keys less than @a k, in @a l, and the
+     * keys greater than @a k, in @a r. Returns the detached node of key
+     * @a k, or null if there is none. The parent pointers of the new roots
+     * are left stale.
+     */
+    _Node_ptr
+    _split(_Node_ptr x, const key_type &k, _Node_ptr &l, _Node_ptr &r) const
+    {
+        if (x == nullptr)
+        {
+            l = r = nullptr;
+            return nullptr;
+        }
+
+        _Node_ptr found;
+        if (_comp(x->_value, k))
+        {
+            found = _split(x->_right, k, x->_right, r);
+            l     = x;
+        }
+        else if (_comp(k, x->_value))
+        {
+            found = _split(x->_left, k, l, x->_left);
+            r     = x;
+        }
+        else
+        {
+            l         = x->_left;
+            r         = x->_right;
+            x->_left  = nullptr;
+            x->_right = nullptr;
+            x->_size  = 1;
+            return x;
+        }
+
+        _S_pull(x);
+        return found;
+    }
+
+    template <_Set_operation _Op>
+    _Node_ptr
+    _combine(treap_set &&other, _Garbage &garbage)
+    {
+        M_Assert(_alloc == other._alloc,
+                 "Combining sets of unequal allocators");
+        if (&other == this)
+        {
+            if (_Op == _Difference)
+                clear();
+            return _root;
+        }
+
+        const unsigned threads = std::thread::hardware_concurrency();
+        const int depth        = threads > 1 ? std::bit_width(threads) : 0;
+
+        _Node_ptr a = _root;
+        _Node_ptr b = other._root;
+        _root       = nullptr;
+        other._root = nullptr;
+        return _S_detach(_combine<_Op>(a, b, garbage, depth));
+    }
+
+    /**
+     * Combines the treaps @a a and @a b. The removed nodes are pushed to
+     * @a garbage. The two halves are combined by parallel tasks while
+     * @a depth is positive and they are large enough.
+     */
+    template <_Set_operation _Op>
+    _Node_ptr
+    _combine(_Node_ptr a, _Node_ptr b, _Garbage &garbage, int depth) const
+    {
+        if (a == nullptr || b == nullptr)
+        {
+            if (_Op == _Union)
+                return a == nullptr ? b : a;
+            if (_Op == _Difference)
+            {
+                garbage.push(b);
+                return a;
+            }
+            garbage.push(a);
+            garbage.push(b);
+            return nullptr;
+        }
+
+        // The root of higher priority stays above the other tree. The
+        // difference is not symmetric, so it keeps the roles of a and b. A
+        // common key keeps its value from this set.
+        bool swapped = false;
+        if (_Op != _Difference && a->_priority < b->_priority)
+        {
+            std::swap(a, b);
+            swapped = true;
+        }
+
+        _Node_ptr bl, br;
+        _Node_ptr found = _split(b, a->_value, bl, br);
+        _Node_ptr al    = a->_left;
+        _Node_ptr ar    = a->_right;
+
+        _Garbage right_garbage;
+        auto left  = [&] { al = _combine<_Op>(al, bl, garbage, depth - 1); };
+        auto right = [&]
+        { ar = _combine<_Op>(ar, br, right_garbage, depth - 1); };
+
+        const size_type n = _S_size(a) + _S_size(b);
+        if (depth > 0 && n >= _S_parallel_cutoff)
+            _S_fork(left, right);
+        else
+        {
+            left();
+            right();
+        }
+        garbage.splice(right_garbage);
+
+        // The union keeps a single copy of the common keys, the intersection
+        // only the common ones and the difference the others
+        const bool keep = _Op == _Union ||
+                          (_Op == _Intersection) == (found != nullptr);
+        if (found != nullptr && swapped)
+            std::swap(a->_value, found->_value);
+        garbage.push(found);
+
+        if (!keep)
+        {
+            a->_left  = nullptr;
+            a->_right = nullptr;
+            a->_size  = 1;
+            garbage.push(a);
+            return _S_join(al, ar);
+        }
+
+        a->_left  = al;
+        a->_right = ar;
+        _S_pull(a);
+        return a;
+    }
+
+    /**
+     * Runs @a left in a new thread and @a right in this one, or both in this
+     * thread if no thread can be started.
+     */
+    template <typename _Left, typename _Right>
+    static void
+    _S_fork(_Left &left, _Right &right)
+    {
+        std::future<void> task;
+        try
+        {
+            task = std::async(std::launch::async, [&left] { left(); });
+        }
+        catch (const std::system_error &)
+        {
+            left();
+            right();
+            return;
+        }
+
+        right();
+        task.get();
+    }
+
+    template <typename... Args>
+    _Node_ptr
+    _create_node(Args &&...args)
+    {
+        _Node_ptr z = _Node_alloc_traits::allocate(_alloc, 1);
+
+        try
+        {
+            _Node_alloc_traits::construct(_alloc, z,
+                                          std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            _Node_alloc_traits::deallocate(_alloc, z, 1);
+            throw;
+        }
+
+        return z;
+    }
+
+    void
+    _drop_node(_Node_ptr x) noexcept
+    {
+        _Node_alloc_traits::destroy(_alloc, x);
+        _Node_alloc_traits::deallocate(_alloc, x, 1);
+    }
+
+    void
+    _erase_subtree(_Node_ptr x) noexcept
+    {
+        while (x != nullptr)
+        {
+            _erase_subtree(x->_right);
+            _Node_ptr left = x->_left;
+            _drop_node(x);
+            x = left;
+        }
+    }
+
+    void
+    _free(_Garbage &garbage) noexcept
+    {
+        for (_Node_ptr x = garbage._head; x != nullptr;)
+        {
+            _Node_ptr next = x->_parent;
+            _erase_subtree(x);
+            x = next;
+        }
+    }
+
+    /**
+     * Copies the subtree of @a x, priorities included, under @a parent. The
+     * keys are moved out of it if @a _Move.
+     */
+    template <bool _Move = false>
+    _Node_ptr
+    _copy(_Const_ptr x, _Node_ptr parent)
+    {
+        if (x == nullptr)
+            return nullptr;
+
+        _Node_ptr y;
+        if constexpr (_Move)
+            y = _create_node(std::move(const_cast<_Node_ptr>(x)->_value));
+        else
+            y = _create_node(x->_value);
+        y->_priority = x->_priority;
+        y->_size     = x->_size;
+        y->_parent   = parent;
+
+        try
+        {
+            y->_left  = _copy<_Move>(x->_left, y);
+            y->_right = _copy<_Move>(x->_right, y);
+        }
+        catch (...)
+        {
+            _erase_subtree(y);
+            throw;
+        }
+
+        return y;
+    }
+
+    /**
+     * Builds a treap from a sorted range with the stack of its right spine:
+     * each new key pops the nodes of lower priority, which become its left
+     * subtree, and is pushed as the right child of the remaining top.
+     */
+    template <typename _ForwardIter>
+    _Node_ptr
+    _build_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        M_Assert(std::adjacent_find(first, last,
+                                    [this](const value_type &a,
+                                           const value_type &b)
+                                    { return !_comp(a, b); }) == last,
+                 "The keys must be sorted and unique");
+
+        vector<_Node_ptr> spine;
+        auto pop = [&spine](_Node_ptr below)
+        {
+            _Node_ptr x = spine.back();
+            spine.pop_back();
+            x->_right = below;
+            _S_pull(x);
+            return x;
+        };
+
+        try
+        {
+            for (; first != last; ++first)
+            {
+                _Node_ptr z     = _create_node(*first);
+                _Node_ptr below = nullptr;
+                while (!spine.empty() &&
+                       spine.back()->_priority < z->_priority)
+                    below = pop(below);
+                z->_left = below;
+                spine.push_back(z);
+            }
+        }
+        catch (...)
+        {
+            _Node_ptr x = nullptr;
+            while (!spine.empty())
+                x = pop(x);
+            _erase_subtree(x);
+            throw;
+        }
+
+        _Node_ptr x = nullptr;
+        while (!spine.empty())
+            x = pop(x);
+        return _S_detach(x);
+    }
+
+    /**
+     * Links the new node @a z, whose key is not in the set, where its
+     * priority puts it on the search path, and splits the subtree it
+     * replaces at its key.
+     */
+    const_iterator
+    _insert_node(_Node_ptr z) noexcept
+    {
+        _Node_ptr *slot  = &_root;
+        _Node_ptr parent = nullptr;
+
+        while (*slot != nullptr && (*slot)->_priority > z->_priority)
+        {
+            parent = *slot;
+            parent->_size++;
+            slot = _comp(z->_value, parent->_value) ? &parent->_left
+                                                    : &parent->_right;
+        }
+
+        _split(*slot, z->_value, z->_left, z->_right);
+        _S_pull(z);
+        z->_parent = parent;
+        *slot      = z;
+        return const_iterator(z, _root);
+    }
+
+    /**
+     * Replaces @a x by the join of its subtrees and frees it.
+     */
+    void
+    _erase_node(_Node_ptr x) noexcept
+    {
+        _Node_ptr p = x->_parent;
+        _Node_ptr y = _S_join(x->_left, x->_right);
+        if (y != nullptr)
+            y->_parent = p;
+
+        if (p == nullptr)
+            _root = y;
+        else if (p->_left == x)
+            p->_left = y;
+        else
+            p->_right = y;
+
+        for (; p != nullptr; p = p->_parent)
+            p->_size--;
+        _drop_node(x);
+    }
+};
+
+} // namespace opendsa
+
+#endif /* __OPENDSA_TREAP_H */
@@ -11,8 +11,20 @@
 #ifndef __OPENDSA_TREE_H
 #define __OPENDSA_TREE_H 1
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
 #include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "helper.h"
+#include "pool.h"
 
 namespace opendsa
 {
@@ -23,6 +35,10 @@ namespace opendsa
  * The purpose of this base struct is to provide basic methods t work with this
  * tree regardless of the type. _tree_node_base doesn't have any restriction and
  * all of the methods are public.
+ *
+ * The value is kept in raw storage and is constructed and destroyed by the tree
+ * that owns the node. That way, the header sentinel of a tree is a node as well
+ * but never holds a value.
  */
 template <typename _Tp>
 struct _Bi_tree_node_base
@@ -30,10 +46,18 @@ struct _Bi_tree_node_base
     using base_ptr       = _Bi_tree_node_base<_Tp> *;
     using const_base_ptr = const _Bi_tree_node_base<_Tp> *;
 
+    // Tag of the header sentinel, which no balancing scheme uses.
+    constexpr static unsigned char _S_header_tag = 0xff;
+
     base_ptr _parent;
     base_ptr _left;
     base_ptr _right;
-    _Tp _val;
+
+    // Balancing information of the concrete tree, e.g. the color of a
+    // red-black tree node.
+    unsigned char _tag;
+
+    alignas(_Tp) unsigned char _storage[sizeof(_Tp)];
 
     /**
      * @brief Returns the leftmost child node of the given tree.
@@ -78,13 +102,13 @@ struct _Bi_tree_node_base
     _Tp *
     _valptr()
     {
-        return std::addressof(_val);
+        return std::launder(reinterpret_cast<_Tp *>(_storage));
     }
 
     const _Tp *
     _valptr() const
     {
-        return std::addressof(_val);
+        return std::launder(reinterpret_cast<const _Tp *>(_storage));
     }
 };
 
@@ -121,14 +145,70 @@ struct _Bi_tree_iterator
     }
 };
 
+/**
+ * @brief In-order iterator over a tree whose header sentinel is tagged with
+ * _S_header_tag.
+ *
+ * The header's parent is the root, its left child is the leftmost node and its
+ * right child is the rightmost node, and the root's parent is the header. The
+ * header is the past-the-end node.
+ */
 template <typename _Tp>
 struct _Bi_tree_inorder_iterator : public _Bi_tree_iterator<_Tp>
 {
     using base_ptr  = _Bi_tree_iterator<_Tp>::base_ptr;
     using node_type = _Bi_tree_iterator<_Tp>::node_type;
 
-private:
-    base_ptr
+    using _Bi_tree_iterator<_Tp>::_Bi_tree_iterator;
+
+    _Bi_tree_inorder_iterator &
+    operator++() noexcept
+    {
+        this->_node = _increment(this->_node);
+        return *this;
+    }
+
+    _Bi_tree_inorder_iterator
+    operator++(int) noexcept
+    {
+        _Bi_tree_inorder_iterator tmp = *this;
+        this->_node                   = _increment(this->_node);
+        return tmp;
+    }
+
+    _Bi_tree_inorder_iterator &
+    operator--() noexcept
+    {
+        this->_node = _decrement(this->_node);
+        return *this;
+    }
+
+    _Bi_tree_inorder_iterator
+    operator--(int) noexcept
+    {
+        _Bi_tree_inorder_iterator tmp = *this;
+        this->_node                   = _decrement(this->_node);
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Bi_tree_inorder_iterator &lhs,
+               const _Bi_tree_inorder_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+
+    friend bool
+    operator!=(const _Bi_tree_inorder_iterator &lhs,
+               const _Bi_tree_inorder_iterator &rhs) noexcept
+    {
+        return lhs._node != rhs._node;
+    }
+
+    /**
+     * @brief Returns the in-order successor of a node.
+     */
+    static base_ptr
     _increment(base_ptr _x) noexcept
     {
         if (_x->_right != nullptr)
@@ -151,6 +231,2241 @@ private:
 
         return _x;
     }
+
+    /**
+     * @brief Returns the in-order predecessor of a node. The predecessor of
+     * the header is the rightmost node.
+     */
+    static base_ptr
+    _decrement(base_ptr _x) noexcept
+    {
+        if (_x->_tag == node_type::_S_header_tag)
+            return _x->_right;
+
+        if (_x->_left != nullptr)
+            return node_type::_rightmost(_x->_left);
+
+        base_ptr _x_parent = _x->_parent;
+        while (_x == _x_parent->_left)
+        {
+            _x        = _x_parent;
+            _x_parent = _x_parent->_parent;
+        }
+
+        return _x_parent;
+    }
+};
+
+/**
+ * @brief Readonly version of _Bi_tree_inorder_iterator.
+ */
+template <typename _Tp>
+struct _Bi_tree_const_inorder_iterator
+{
+    using value_type = _Tp;
+    using reference  = const _Tp &;
+    using pointer    = const _Tp *;
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+
+    using node_type      = _Bi_tree_node_base<_Tp>;
+    using base_ptr       = node_type::base_ptr;
+    using const_base_ptr = node_type::const_base_ptr;
+    using iterator       = _Bi_tree_inorder_iterator<_Tp>;
+
+    const_base_ptr _node;
+
+    _Bi_tree_const_inorder_iterator() noexcept : _node() { }
+
+    explicit _Bi_tree_const_inorder_iterator(const_base_ptr _x) noexcept
+    : _node(_x)
+    {
+    }
+
+    _Bi_tree_const_inorder_iterator(const iterator &it) noexcept
+    : _node(it._node)
+    {
+    }
+
+    /**
+     * @brief Converts back to a mutable iterator, e.g. for erase().
+     */
+    iterator
+    _const_cast() const noexcept
+    {
+        return iterator(const_cast<base_ptr>(_node));
+    }
+
+    reference
+    operator*() const noexcept
+    {
+        return *(_node->_valptr());
+    }
+
+    pointer
+    operator->() const noexcept
+    {
+        return _node->_valptr();
+    }
+
+    _Bi_tree_const_inorder_iterator &
+    operator++() noexcept
+    {
+        _node = iterator::_increment(const_cast<base_ptr>(_node));
+        return *this;
+    }
+
+    _Bi_tree_const_inorder_iterator
+    operator++(int) noexcept
+    {
+        _Bi_tree_const_inorder_iterator tmp = *this;
+        _node = iterator::_increment(const_cast<base_ptr>(_node));
+        return tmp;
+    }
+
+    _Bi_tree_const_inorder_iterator &
+    operator--() noexcept
+    {
+        _node = iterator::_decrement(const_cast<base_ptr>(_node));
+        return *this;
+    }
+
+    _Bi_tree_const_inorder_iterator
+    operator--(int) noexcept
+    {
+        _Bi_tree_const_inorder_iterator tmp = *this;
+        _node = iterator::_decrement(const_cast<base_ptr>(_node));
+        return tmp;
+    }
+
+    friend bool
+    operator==(const _Bi_tree_const_inorder_iterator &lhs,
+               const _Bi_tree_const_inorder_iterator &rhs) noexcept
+    {
+        return lhs._node == rhs._node;
+    }
+
+    friend bool
+    operator!=(const _Bi_tree_const_inorder_iterator &lhs,
+               const _Bi_tree_const_inorder_iterator &rhs) noexcept
+    {
+        return lhs._node != rhs._node;
+    }
+};
+
+/**
+ * @brief A tree node that also holds the augmented data of its subtree.
+ *
+ * The tree and its iterators only deal with _Bi_tree_node_base pointers. The
+ * tree that allocated the node casts them back to reach @a _aug.
+ */
+template <typename _Tp, typename _Data>
+struct _Bi_tree_aug_node : public _Bi_tree_node_base<_Tp>
+{
+    _Data _aug;
+};
+
+/**
+ * @brief Node update of a tree without augmentation, which does nothing.
+ */
+struct _Bi_tree_no_update
+{
+    template <typename _Tp>
+    void
+    operator()(_Bi_tree_node_base<_Tp> *) const noexcept
+    {
+    }
+};
+
+/**
+ * @brief Operations shared by the balancing schemes of _Bi_search_tree.
+ *
+ * A balancing scheme links and unlinks nodes the same way as a plain binary
+ * search tree, then restores its own invariant with rotations.
+ *
+ * Every rotation calls @a update on the two rotated nodes, the lower one
+ * first, so that an augmented tree can recompute their data from their new
+ * children. The tree is then responsible for updating the ancestors of the
+ * linked or unlinked position.
+ */
+struct _Bi_tree_balance_base
+{
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static void
+    _rotate_left(_Bi_tree_node_base<_Tp> *x, _Bi_tree_node_base<_Tp> *&root,
+                 _Update update = _Update()) noexcept
+    {
+        _Bi_tree_node_base<_Tp> *y = x->_right;
+
+        x->_right = y->_left;
+        if (y->_left != nullptr)
+            y->_left->_parent = x;
+        y->_parent = x->_parent;
+
+        if (x == root)
+            root = y;
+        else if (x == x->_parent->_left)
+            x->_parent->_left = y;
+        else
+            x->_parent->_right = y;
+
+        y->_left   = x;
+        x->_parent = y;
+
+        update(x);
+        update(y);
+    }
+
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static void
+    _rotate_right(_Bi_tree_node_base<_Tp> *x, _Bi_tree_node_base<_Tp> *&root,
+                  _Update update = _Update()) noexcept
+    {
+        _Bi_tree_node_base<_Tp> *y = x->_left;
+
+        x->_left = y->_right;
+        if (y->_right != nullptr)
+            y->_right->_parent = x;
+        y->_parent = x->_parent;
+
+        if (x == root)
+            root = y;
+        else if (x == x->_parent->_right)
+            x->_parent->_right = y;
+        else
+            x->_parent->_left = y;
+
+        y->_right  = x;
+        x->_parent = y;
+
+        update(x);
+        update(y);
+    }
+
+    /**
+     * @brief Links @a x as a child of @a p, and keeps the header's links to
+     * the root, the leftmost and the rightmost nodes up to date.
+     *
+     * @param insert_left Whether @a x becomes the left child of @a p.
+     * @param x           New node.
+     * @param p           Parent of the new node, or the header if the tree is
+     *                    empty.
+     * @param header      Header sentinel of the tree.
+     */
+    template <typename _Tp>
+    static void
+    _link_node(bool insert_left, _Bi_tree_node_base<_Tp> *x,
+               _Bi_tree_node_base<_Tp> *p,
+               _Bi_tree_node_base<_Tp> &header) noexcept
+    {
+        x->_parent = p;
+        x->_left   = nullptr;
+        x->_right  = nullptr;
+
+        if (insert_left)
+        {
+            p->_left = x;
+            if (p == &header)
+            {
+                header._parent = x;
+                header._right  = x;
+            }
+            else if (p == header._left)
+                header._left = x;
+        }
+        else
+        {
+            p->_right = x;
+            if (p == header._right)
+                header._right = x;
+        }
+    }
+
+    /**
+     * @brief Unlinks @a z from the tree.
+     *
+     * @param z        Node to be removed.
+     * @param header   Header sentinel of the tree.
+     * @param x        Set to the node that took the removed position, which
+     *                 might be null.
+     * @param x_parent Set to the parent of that position.
+     *
+     * A node with two children is replaced by its successor, which takes
+     * over its tag. @a z then holds the tag of the successor, i.e. of the
+     * position that was actually removed.
+     */
+    template <typename _Tp>
+    static void
+    _unlink_node(_Bi_tree_node_base<_Tp> *z, _Bi_tree_node_base<_Tp> &header,
+                 _Bi_tree_node_base<_Tp> *&x,
+                 _Bi_tree_node_base<_Tp> *&x_parent) noexcept
+    {
+        using node_type = _Bi_tree_node_base<_Tp>;
+        using base_ptr  = node_type::base_ptr;
+
+        base_ptr &root      = header._parent;
+        base_ptr &leftmost  = header._left;
+        base_ptr &rightmost = header._right;
+
+        base_ptr y = z;
+        x          = nullptr;
+        x_parent   = nullptr;
+
+        if (y->_left == nullptr)
+            x = y->_right; // x might be null
+        else if (y->_right == nullptr)
+            x = y->_left; // x is not null
+        else
+        {
+            // z has two children: y becomes its successor and x might be
+            // null
+            y = node_type::_leftmost(y->_right);
+            x = y->_right;
+        }
+
+        if (y != z)
+        {
+            // Relink y in place of z
+            z->_left->_parent = y;
+            y->_left          = z->_left;
+
+            if (y != z->_right)
+            {
+                x_parent = y->_parent;
+                if (x != nullptr)
+                    x->_parent = y->_parent;
+                y->_parent->_left  = x; // y must be a left child
+                y->_right          = z->_right;
+                z->_right->_parent = y;
+            }
+            else
+                x_parent = y;
+
+            if (root == z)
+                root = y;
+            else if (z->_parent->_left == z)
+                z->_parent->_left = y;
+            else
+                z->_parent->_right = y;
+
+            y->_parent = z->_parent;
+            std::swap(y->_tag, z->_tag);
+        }
+        else
+        {
+            x_parent = y->_parent;
+            if (x != nullptr)
+                x->_parent = y->_parent;
+
+            if (root == z)
+                root = x;
+            else if (z->_parent->_left == z)
+                z->_parent->_left = x;
+            else
+                z->_parent->_right = x;
+
+            if (leftmost == z)
+                leftmost = (z->_right == nullptr) ? z->_parent
+                                                  : node_type::_leftmost(x);
+
+            if (rightmost == z)
+                rightmost = (z->_left == nullptr) ? z->_parent
+                                                  : node_type::_rightmost(x);
+        }
+    }
+};
+
+/**
+ * @brief Red-black balancing scheme for _Bi_search_tree.
+ *
+ * Every node is either red or black, a red node has no red child, and every
+ * path from a node down to a null child goes through the same number of black
+ * nodes. The color is kept in the _tag of each node.
+ */
+struct _Rb_tree_balance : public _Bi_tree_balance_base
+{
+    constexpr static unsigned char _S_red   = 0;
+    constexpr static unsigned char _S_black = 1;
+
+    /**
+     * @brief Links @a x as a child of @a p and restores the red-black
+     * properties.
+     *
+     * @param insert_left Whether @a x becomes the left child of @a p.
+     * @param x           New node.
+     * @param p           Parent of the new node, or the header if the tree is
+     *                    empty.
+     * @param header      Header sentinel of the tree.
+     * @param update      Called on every rotated node.
+     */
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static void
+    _insert_and_rebalance(bool insert_left, _Bi_tree_node_base<_Tp> *x,
+                          _Bi_tree_node_base<_Tp> *p,
+                          _Bi_tree_node_base<_Tp> &header,
+                          _Update update = _Update()) noexcept
+    {
+        using base_ptr = _Bi_tree_node_base<_Tp> *;
+        base_ptr &root = header._parent;
+
+        _link_node(insert_left, x, p, header);
+        x->_tag = _S_red;
+
+        while (x != root && x->_parent->_tag == _S_red)
+        {
+            base_ptr xpp = x->_parent->_parent;
+
+            if (x->_parent == xpp->_left)
+            {
+                base_ptr y = xpp->_right;
+                if (y != nullptr && y->_tag == _S_red)
+                {
+                    x->_parent->_tag = _S_black;
+                    y->_tag          = _S_black;
+                    xpp->_tag        = _S_red;
+                    x                = xpp;
+                }
+                else
+                {
+                    if (x == x->_parent->_right)
+                    {
+                        x = x->_parent;
+                        _rotate_left(x, root, update);
+                    }
+                    x->_parent->_tag = _S_black;
+                    xpp->_tag        = _S_red;
+                    _rotate_right(xpp, root, update);
+                }
+            }
+            else
+            {
+                base_ptr y = xpp->_left;
+                if (y != nullptr && y->_tag == _S_red)
+                {
+                    x->_parent->_tag = _S_black;
+                    y->_tag          = _S_black;
+                    xpp->_tag        = _S_red;
+                    x                = xpp;
+                }
+                else
+                {
+                    if (x == x->_parent->_left)
+                    {
+                        x = x->_parent;
+                        _rotate_right(x, root, update);
+                    }
+                    x->_parent->_tag = _S_black;
+                    xpp->_tag        = _S_red;
+                    _rotate_left(xpp, root, update);
+                }
+            }
+        }
+
+        root->_tag = _S_black;
+    }
+
+    /**
+     * @brief Unlinks @a z from the tree and restores the red-black
+     * properties.
+     *
+     * @param z      Node to be removed.
+     * @param header Header sentinel of the tree.
+     * @param update Called on every rotated node.
+     *
+     * Returns @a z, which is no longer reachable from the header but still
+     * holds its value.
+     */
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static _Bi_tree_node_base<_Tp> *
+    _rebalance_for_erase(_Bi_tree_node_base<_Tp> *z,
+                         _Bi_tree_node_base<_Tp> &header,
+                         _Update update = _Update()) noexcept
+    {
+        using base_ptr = _Bi_tree_node_base<_Tp> *;
+
+        base_ptr &root    = header._parent;
+        base_ptr x        = nullptr;
+        base_ptr x_parent = nullptr;
+
+        _unlink_node(z, header, x, x_parent);
+
+        if (z->_tag != _S_red)
+        {
+            while (x != root && (x == nullptr || x->_tag == _S_black))
+            {
+                if (x == x_parent->_left)
+                {
+                    base_ptr w = x_parent->_right;
+                    if (w->_tag == _S_red)
+                    {
+                        w->_tag        = _S_black;
+                        x_parent->_tag = _S_red;
+                        _rotate_left(x_parent, root, update);
+                        w = x_parent->_right;
+                    }
+
+                    if ((w->_left == nullptr || w->_left->_tag == _S_black) &&
+                        (w->_right == nullptr || w->_right->_tag == _S_black))
+                    {
+                        w->_tag  = _S_red;
+                        x        = x_parent;
+                        x_parent = x_parent->_parent;
+                    }
+                    else
+                    {
+                        if (w->_right == nullptr || w->_right->_tag == _S_black)
+                        {
+                            w->_left->_tag = _S_black;
+                            w->_tag        = _S_red;
+                            _rotate_right(w, root, update);
+                            w = x_parent->_right;
+                        }
+
+                        w->_tag        = x_parent->_tag;
+                        x_parent->_tag = _S_black;
+                        if (w->_right != nullptr)
+                            w->_right->_tag = _S_black;
+                        _rotate_left(x_parent, root, update);
+                        break;
+                    }
+                }
+                else
+                {
+                    base_ptr w = x_parent->_left;
+                    if (w->_tag == _S_red)
+                    {
+                        w->_tag        = _S_black;
+                        x_parent->_tag = _S_red;
+                        _rotate_right(x_parent, root, update);
+                        w = x_parent->_left;
+                    }
+
+                    if ((w->_right == nullptr || w->_right->_tag == _S_black) &&
+                        (w->_left == nullptr || w->_left->_tag == _S_black))
+                    {
+                        w->_tag  = _S_red;
+                        x        = x_parent;
+                        x_parent = x_parent->_parent;
+                    }
+                    else
+                    {
+                        if (w->_left == nullptr || w->_left->_tag == _S_black)
+                        {
+                            w->_right->_tag = _S_black;
+                            w->_tag         = _S_red;
+                            _rotate_left(w, root, update);
+                            w = x_parent->_left;
+                        }
+
+                        w->_tag        = x_parent->_tag;
+                        x_parent->_tag = _S_black;
+                        if (w->_left != nullptr)
+                            w->_left->_tag = _S_black;
+                        _rotate_right(x_parent, root, update);
+                        break;
+                    }
+                }
+            }
+
+            if (x != nullptr)
+                x->_tag = _S_black;
+        }
+
+        return z;
+    }
+
+    /**
+     * @brief Returns the tag of a node in a tree built from sorted input.
+     *
+     * @param depth Depth of the node, the root being at depth 0.
+     * @param full  Number of complete levels of the tree.
+     * @param size  Number of nodes in the subtree of the node.
+     *
+     * Every path from the root to a null child goes through the @a full
+     * complete levels, which are black. The nodes of the last incomplete
+     * level have black parents and no child, so they can be red.
+     */
+    static unsigned char
+    _balanced_tag(std::size_t depth, std::size_t full, std::size_t size)
+    {
+        (void)size;
+        return depth < full ? _S_black : _S_red;
+    }
+};
+
+/**
+ * @brief AVL balancing scheme for _Bi_search_tree.
+ *
+ * The heights of the two subtrees of every node differ by at most one. The
+ * _tag of a node holds the height of its subtree, a null child having height
+ * 0. An AVL tree is at most about 1.44 log2(n) high against 2 log2(n) for a
+ * red-black tree, so lookups visit fewer nodes, at the cost of more rotations
+ * when the tree is modified.
+ */
+struct _Avl_tree_balance : public _Bi_tree_balance_base
+{
+    template <typename _Tp>
+    static unsigned char
+    _height(const _Bi_tree_node_base<_Tp> *x) noexcept
+    {
+        return x == nullptr ? 0 : x->_tag;
+    }
+
+    template <typename _Tp>
+    static void
+    _update_height(_Bi_tree_node_base<_Tp> *x) noexcept
+    {
+        x->_tag = 1 + std::max(_height(x->_left), _height(x->_right));
+    }
+
+    /**
+     * Recomputes the height of @a x, rotating its subtree if the heights of
+     * its children differ by two. Returns the new root of the subtree.
+     */
+    template <typename _Tp, typename _Update>
+    static _Bi_tree_node_base<_Tp> *
+    _rebalance_node(_Bi_tree_node_base<_Tp> *x, _Bi_tree_node_base<_Tp> *&root,
+                    _Update &update) noexcept
+    {
+        using base_ptr = _Bi_tree_node_base<_Tp> *;
+
+        const int balance = _height(x->_left) - _height(x->_right);
+
+        if (balance > 1)
+        {
+            base_ptr l = x->_left;
+            if (_height(l->_left) < _height(l->_right))
+            {
+                _rotate_left(l, root, update);
+                _update_height(l);
+            }
+            _rotate_right(x, root, update);
+        }
+        else if (balance < -1)
+        {
+            base_ptr r = x->_right;
+            if (_height(r->_right) < _height(r->_left))
+            {
+                _rotate_right(r, root, update);
+                _update_height(r);
+            }
+            _rotate_left(x, root, update);
+        }
+        else
+        {
+            _update_height(x);
+            return x;
+        }
+
+        // x is now a child of the new root of the subtree
+        _update_height(x);
+        _update_height(x->_parent);
+        return x->_parent;
+    }
+
+    /**
+     * @brief Links @a x as a child of @a p and restores the AVL property.
+     *
+     * @param insert_left Whether @a x becomes the left child of @a p.
+     * @param x           New node.
+     * @param p           Parent of the new node, or the header if the tree is
+     *                    empty.
+     * @param header      Header sentinel of the tree.
+     * @param update      Called on every rotated node.
+     *
+     * At most one single or double rotation is needed.
+     */
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static void
+    _insert_and_rebalance(bool insert_left, _Bi_tree_node_base<_Tp> *x,
+                          _Bi_tree_node_base<_Tp> *p,
+                          _Bi_tree_node_base<_Tp> &header,
+                          _Update update = _Update()) noexcept
+    {
+        _link_node(insert_left, x, p, header);
+        x->_tag = 1;
+        _retrace(p, header, update);
+    }
+
+    /**
+     * @brief Unlinks @a z from the tree and restores the AVL property.
+     *
+     * @param z      Node to be removed.
+     * @param header Header sentinel of the tree.
+     * @param update Called on every rotated node.
+     *
+     * Returns @a z, which is no longer reachable from the header but still
+     * holds its value.
+     */
+    template <typename _Tp, typename _Update = _Bi_tree_no_update>
+    static _Bi_tree_node_base<_Tp> *
+    _rebalance_for_erase(_Bi_tree_node_base<_Tp> *z,
+                         _Bi_tree_node_base<_Tp> &header,
+                         _Update update = _Update()) noexcept
+    {
+        _Bi_tree_node_base<_Tp> *x        = nullptr;
+        _Bi_tree_node_base<_Tp> *x_parent = nullptr;
+
+        _unlink_node(z, header, x, x_parent);
+        _retrace(x_parent, header, update);
+        return z;
+    }
+
+    /**
+     * @brief Returns the tag of a node in a tree built from sorted input.
+     *
+     * @param depth Depth of the node, the root being at depth 0.
+     * @param full  Number of complete levels of the tree.
+     * @param size  Number of nodes in the subtree of the node.
+     *
+     * Splitting a sorted range at its middle yields subtrees whose sizes
+     * differ by at most one, and a subtree of @a size nodes is
+     * bit_width(size) high.
+     */
+    static unsigned char
+    _balanced_tag(std::size_t depth, std::size_t full, std::size_t size)
+    {
+        (void)depth;
+        (void)full;
+        return static_cast<unsigned char>(std::bit_width(size));
+    }
+
+private:
+    /**
+     * Walks up from @a x to the root, fixing the heights and rotating the
+     * unbalanced subtrees. The heights above a subtree whose height did not
+     * change are still valid, so the walk stops there.
+     */
+    template <typename _Tp, typename _Update>
+    static void
+    _retrace(_Bi_tree_node_base<_Tp> *x, _Bi_tree_node_base<_Tp> &header,
+             _Update &update) noexcept
+    {
+        while (x != &header)
+        {
+            const unsigned char old_height = x->_tag;
+
+            x = _rebalance_node(x, header._parent, update);
+            if (x->_tag == old_height)
+                break;
+
+            x = x->_parent;
+        }
+    }
+};
+
+/**
+ * @brief Augmentation that counts the values of every subtree.
+ *
+ * An augmentation of _Bi_search_tree folds the values of each subtree with a
+ * monoid and keeps the result in the root of the subtree, where it is
+ * maintained in O(log n) per insertion or removal. An augmentation is a
+ * stateless function object providing:
+ *
+ * - value_type, the type of the folded data;
+ * - identity(), the data of an empty range;
+ * - operator()(const _Val &), the data of a single value;
+ * - operator()(const value_type &, const value_type &), which combines the
+ *   data of two adjacent ranges, the leftmost one first. It must be
+ *   associative, but needs not be commutative.
+ *
+ * None of them may throw. If the augmentation also provides size(), which
+ * returns the number of values folded into some data, the tree supports
+ * select() and rank() in O(log n).
+ */
+struct subtree_size
+{
+    using value_type = std::size_t;
+
+    static constexpr value_type
+    identity() noexcept
+    {
+        return 0;
+    }
+
+    template <typename _Val>
+    constexpr value_type
+    operator()(const _Val &) const noexcept
+    {
+        return 1;
+    }
+
+    constexpr value_type
+    operator()(value_type lhs, value_type rhs) const noexcept
+    {
+        return lhs + rhs;
+    }
+
+    static constexpr std::size_t
+    size(value_type data) noexcept
+    {
+        return data;
+    }
+};
+
+/**
+ * @brief An augmentation of _Bi_search_tree, see subtree_size.
+ */
+template <typename _Aug, typename _Val>
+concept _Tree_augment = requires(const _Aug aug, const _Val &v,
+                                 const typename _Aug::value_type &d) {
+    { _Aug::identity() } -> std::convertible_to<typename _Aug::value_type>;
+    { aug(v) } -> std::convertible_to<typename _Aug::value_type>;
+    { aug(d, d) } -> std::convertible_to<typename _Aug::value_type>;
+};
+
+/**
+ * @brief An augmentation that counts the values, which enables the order
+ * statistics of _Bi_search_tree.
+ */
+template <typename _Aug, typename _Val>
+concept _Counting_augment =
+    _Tree_augment<_Aug, _Val> &&
+    requires(const _Aug aug, const typename _Aug::value_type &d) {
+        { aug.size(d) } -> std::convertible_to<std::size_t>;
+    };
+
+/**
+ * @brief Type of the nodes allocated by a tree with a given augmentation.
+ */
+template <typename _Val, typename _Augment>
+struct _Bi_tree_node_type
+{
+    using type = _Bi_tree_aug_node<_Val, typename _Augment::value_type>;
+};
+
+template <typename _Val>
+struct _Bi_tree_node_type<_Val, void>
+{
+    using type = _Bi_tree_node_base<_Val>;
+};
+
+/**
+ * @brief A balanced binary search tree
+ *
+ * @tparam _Key        Type of the keys.
+ * @tparam _Val        Type of the stored values.
+ * @tparam _KeyOfValue Function object extracting the key from a value.
+ * @tparam _Compare    Strict weak ordering of the keys.
+ * @tparam _Alloc      User-defined allocator for the blocks of nodes.
+ * @tparam _Balance    Balancing scheme, either _Rb_tree_balance (the default)
+ *                     or _Avl_tree_balance.
+ * @tparam _Augment    Data folded over every subtree, see subtree_size, or
+ *                     void for none.
+ *
+ * This is the common implementation behind the ordered containers such as
+ * opendsa::map and opendsa::set. The tree holds a header sentinel whose parent
+ * is the root and whose left and right children are the leftmost and
+ * rightmost nodes, so that begin() is O(1) and end() can be decremented. The
+ * balancing scheme only decides how nodes are tagged and rotated when a node
+ * is linked or unlinked.
+ *
+ * Nodes come from a %node_pool owned by the tree rather than from one
+ * allocation each, so they are packed in a few blocks and a traversal touches
+ * far fewer cache lines and pages. Clearing or destroying the tree frees the
+ * blocks directly, without visiting the nodes at all when the values are
+ * trivially destructible.
+ *
+ * An augmented tree keeps the fold of every subtree in its root. The data of
+ * the rotated nodes is recomputed by the balancing scheme, then the tree walks
+ * up from the linked or unlinked position to the root. Range folds, and with
+ * subtree_size the order statistics, only follow one or two paths from the
+ * root.
+ */
+template <typename _Key, typename _Val, typename _KeyOfValue, typename _Compare,
+          typename _Alloc = std::allocator<_Val>,
+          typename _Balance = _Rb_tree_balance, typename _Augment = void>
+    requires std::is_void_v<_Augment> || _Tree_augment<_Augment, _Val>
+class _Bi_search_tree
+{
+private:
+    using _Node      = _Bi_tree_node_base<_Val>;
+    using _Node_ptr  = _Node *;
+    using _Const_ptr = const _Node *;
+
+    // Nodes are allocated with the augmented data, if any, but linked and
+    // iterated as plain _Node.
+    using _Alloc_node = typename _Bi_tree_node_type<_Val, _Augment>::type;
+
+    using _Node_alloc_type =
+        typename std::allocator_traits<_Alloc>::rebind_alloc<_Alloc_node>;
+    using _Node_alloc_traits = std::allocator_traits<_Node_alloc_type>;
+    using _Node_pool_type    = node_pool<_Alloc_node, _Node_alloc_type>;
+    using _Propagate_on_copy =
+        typename _Node_alloc_traits::propagate_on_container_copy_assignment;
+    using _Propagate_on_move =
+        typename _Node_alloc_traits::propagate_on_container_move_assignment;
+
+    constexpr static bool _S_augmented = !std::is_void_v<_Augment>;
+
+public:
+    using key_type               = _Key;
+    using value_type             = _Val;
+    using key_compare            = _Compare;
+    using allocator_type         = _Alloc;
+    using reference              = value_type &;
+    using const_reference        = const value_type &;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using iterator               = _Bi_tree_inorder_iterator<_Val>;
+    using const_iterator         = _Bi_tree_const_inorder_iterator<_Val>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief Creates an empty tree.
+     */
+    _Bi_search_tree() : _comp(), _count(0), _pool() { _reset(); }
+
+    /**
+     * @brief Creates an empty tree with a given comparison object.
+     *
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     */
+    explicit _Bi_search_tree(const _Compare &comp,
+                             const _Alloc &alloc = _Alloc())
+    : _comp(comp), _count(0), _pool(_Node_alloc_type(alloc))
+    {
+        _reset();
+    }
+
+    /**
+     * @brief Creates a tree by deep copying another one.
+     *
+     * The copy has the same shape and balancing information as @a other, so
+     * no comparison nor rebalancing happens.
+     */
+    _Bi_search_tree(const _Bi_search_tree &other)
+    : _comp(other._comp), _count(0),
+      _pool(_Node_alloc_traits::select_on_container_copy_construction(
+          other._pool.get_allocator()))
+    {
+        _reset();
+        _clone(other);
+    }
+
+    /**
+     * @brief Creates a tree by stealing the nodes of another one.
+     */
+    _Bi_search_tree(_Bi_search_tree &&other) noexcept
+    : _comp(other._comp), _count(0), _pool(std::move(other._pool))
+    {
+        _reset();
+        _steal(other);
+    }
+
+    ~_Bi_search_tree() { _destroy_values(_root()); }
+
+    /**
+     * @brief Deep copies another tree into nodes from the allocator this
+     * tree ends up with, i.e. the one of @a other if it propagates on copy
+     * assignment.
+     */
+    _Bi_search_tree &
+    operator=(const _Bi_search_tree &other)
+    {
+        if (&other == this)
+            return *this;
+
+        clear();
+        if constexpr (_Propagate_on_copy::value)
+            _pool.release(other._pool.get_allocator());
+        _comp = other._comp;
+        _clone(other);
+
+        return *this;
+    }
+
+    /**
+     * @brief Takes the nodes of another tree if the allocator propagates on
+     * move assignment or the allocators are equal, otherwise moves its
+     * values into nodes from the allocator of this tree.
+     */
+    _Bi_search_tree &
+    operator=(_Bi_search_tree &&other) noexcept(
+        _Propagate_on_move::value || _Node_alloc_traits::is_always_equal::value)
+    {
+        if (&other == this)
+            return *this;
+
+        clear();
+        _comp = other._comp;
+
+        if (_Propagate_on_move::value ||
+            _pool.get_allocator() == other._pool.get_allocator())
+        {
+            _pool = std::move(other._pool);
+            _steal(other);
+        }
+        else
+        {
+            _clone<true>(other);
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    // Observers
+
+    key_compare
+    key_comp() const
+    {
+        return _comp;
+    }
+
+    allocator_type
+    get_allocator() const noexcept
+    {
+        return allocator_type(_pool.get_allocator());
+    }
+
+    // Iterators
+
+    iterator
+    begin() noexcept
+    {
+        return iterator(_header._left);
+    }
+
+    const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(_header._left);
+    }
+
+    iterator
+    end() noexcept
+    {
+        return iterator(&_header);
+    }
+
+    const_iterator
+    end() const noexcept
+    {
+        return const_iterator(&_header);
+    }
+
+    reverse_iterator
+    rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator
+    rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator
+    rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator
+    rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    // Capacity
+
+    bool
+    empty() const noexcept
+    {
+        return _count == 0;
+    }
+
+    size_type
+    size() const noexcept
+    {
+        return _count;
+    }
+
+    size_type
+    max_size() const noexcept
+    {
+        return _Node_alloc_traits::max_size(_pool.get_allocator());
+    }
+
+    // Modifiers
+
+    /**
+     * @brief Inserts @a v unless an equivalent key already exists.
+     *
+     * Returns an iterator to the element with the key of @a v, and whether
+     * the insertion took place.
+     */
+    template <typename _Arg>
+    std::pair<iterator, bool>
+    _insert_unique(_Arg &&v)
+    {
+        std::pair<_Node_ptr, _Node_ptr> pos =
+            _get_insert_unique_pos(_KeyOfValue()(v));
+
+        if (pos.second == nullptr)
+            return {iterator(pos.first), false};
+
+        _Node_ptr z = _create_node(std::forward<_Arg>(v));
+        return {_insert_node(pos.first, pos.second, z), true};
+    }
+
+    /**
+     * @brief Inserts @a v using @a hint as a suggestion of where it goes.
+     *
+     * The insertion is amortized O(1) if @a v belongs right before @a hint.
+     */
+    template <typename _Arg>
+    iterator
+    _insert_hint_unique(const_iterator hint, _Arg &&v)
+    {
+        std::pair<_Node_ptr, _Node_ptr> pos =
+            _get_insert_hint_unique_pos(hint, _KeyOfValue()(v));
+
+        if (pos.second == nullptr)
+            return iterator(pos.first);
+
+        _Node_ptr z = _create_node(std::forward<_Arg>(v));
+        return _insert_node(pos.first, pos.second, z);
+    }
+
+    /**
+     * @brief Constructs a new element in place unless an equivalent key
+     * already exists.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool>
+    _emplace_unique(Args &&...args)
+    {
+        _Node_ptr z = _create_node(std::forward<Args>(args)...);
+
+        try
+        {
+            std::pair<_Node_ptr, _Node_ptr> pos =
+                _get_insert_unique_pos(_S_key(z));
+
+            if (pos.second == nullptr)
+            {
+                _drop_node(z);
+                return {iterator(pos.first), false};
+            }
+
+            return {_insert_node(pos.first, pos.second, z), true};
+        }
+        catch (...)
+        {
+            _drop_node(z);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Constructs a new element in place using @a hint as a suggestion
+     * of where it goes.
+     */
+    template <typename... Args>
+    iterator
+    _emplace_hint_unique(const_iterator hint, Args &&...args)
+    {
+        _Node_ptr z = _create_node(std::forward<Args>(args)...);
+
+        try
+        {
+            std::pair<_Node_ptr, _Node_ptr> pos =
+                _get_insert_hint_unique_pos(hint, _S_key(z));
+
+            if (pos.second == nullptr)
+            {
+                _drop_node(z);
+                return iterator(pos.first);
+            }
+
+            return _insert_node(pos.first, pos.second, z);
+        }
+        catch (...)
+        {
+            _drop_node(z);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Inserts @a v after the elements with an equivalent key, if any.
+     */
+    template <typename _Arg>
+    iterator
+    _insert_equal(_Arg &&v)
+    {
+        _Node_ptr p = _get_insert_equal_pos(_KeyOfValue()(v));
+        _Node_ptr z = _create_node(std::forward<_Arg>(v));
+        return _insert_node(nullptr, p, z);
+    }
+
+    /**
+     * @brief Constructs a new element in place, after the elements with an
+     * equivalent key, if any.
+     */
+    template <typename... Args>
+    iterator
+    _emplace_equal(Args &&...args)
+    {
+        _Node_ptr z = _create_node(std::forward<Args>(args)...);
+
+        try
+        {
+            return _insert_node(nullptr, _get_insert_equal_pos(_S_key(z)), z);
+        }
+        catch (...)
+        {
+            _drop_node(z);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Removes the element at @a pos and returns the iterator following
+     * it.
+     */
+    iterator
+    erase(const_iterator pos)
+    {
+        iterator next = pos._const_cast();
+        ++next;
+
+        _Node_ptr z = const_cast<_Node_ptr>(pos._node);
+        _Node_ptr lowest =
+            _S_augmented ? _lowest_changed_on_erase(z) : nullptr;
+
+        _Node_ptr y =
+            _Balance::_rebalance_for_erase(z, _header, _Node_update());
+        _update_path(lowest);
+        _drop_node(y);
+        --_count;
+
+        return next;
+    }
+
+    /**
+     * @brief Removes the elements in [first, last).
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        if (first == begin() && last == end())
+        {
+            clear();
+            return end();
+        }
+
+        while (first != last)
+            first = erase(first);
+
+        return last._const_cast();
+    }
+
+    /**
+     * @brief Removes the elements whose key is equivalent to @a k.
+     *
+     * Returns the number of removed elements.
+     */
+    size_type
+    erase(const key_type &k)
+    {
+        std::pair<iterator, iterator> range = equal_range(k);
+        const size_type old_size            = size();
+
+        erase(range.first, range.second);
+
+        return old_size - size();
+    }
+
+    /**
+     * @brief Removes every element and frees the blocks of nodes.
+     */
+    void
+    clear() noexcept
+    {
+        _destroy_values(_root());
+        _pool.release();
+        _reset();
+    }
+
+    /**
+     * @brief Swaps the content of two trees in constant time.
+     *
+     * The node pools are swapped along with the nodes they own, so the
+     * allocators must be equal unless they propagate on swap.
+     */
+    void
+    swap(_Bi_search_tree &other) noexcept
+    {
+        if (_root() == nullptr)
+        {
+            if (other._root() != nullptr)
+                _steal(other);
+        }
+        else if (other._root() == nullptr)
+            other._steal(*this);
+        else
+        {
+            std::swap(_root(), other._root());
+            std::swap(_header._left, other._header._left);
+            std::swap(_header._right, other._header._right);
+
+            _root()->_parent       = &_header;
+            other._root()->_parent = &other._header;
+            std::swap(_count, other._count);
+        }
+
+        std::swap(_comp, other._comp);
+        _pool.swap(other._pool);
+    }
+
+    // Lookup
+
+    iterator
+    find(const key_type &k)
+    {
+        iterator j = lower_bound(k);
+        return (j == end() || _comp(k, _S_key(j._node))) ? end() : j;
+    }
+
+    const_iterator
+    find(const key_type &k) const
+    {
+        const_iterator j = lower_bound(k);
+        return (j == end() || _comp(k, _S_key(j._node))) ? end() : j;
+    }
+
+    size_type
+    count(const key_type &k) const
+    {
+        std::pair<const_iterator, const_iterator> range = equal_range(k);
+        return size_type(std::distance(range.first, range.second));
+    }
+
+    /**
+     * @brief Returns the first element whose key is not less than @a k.
+     */
+    iterator
+    lower_bound(const key_type &k)
+    {
+        return const_cast<const _Bi_search_tree *>(this)
+            ->lower_bound(k)
+            ._const_cast();
+    }
+
+    const_iterator
+    lower_bound(const key_type &k) const
+    {
+        return const_iterator(_lower_bound(_root(), &_header, k));
+    }
+
+    /**
+     * @brief Returns the first element whose key is greater than @a k.
+     */
+    iterator
+    upper_bound(const key_type &k)
+    {
+        return const_cast<const _Bi_search_tree *>(this)
+            ->upper_bound(k)
+            ._const_cast();
+    }
+
+    const_iterator
+    upper_bound(const key_type &k) const
+    {
+        return const_iterator(_upper_bound(_root(), &_header, k));
+    }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type &k)
+    {
+        return {lower_bound(k), upper_bound(k)};
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type &k) const
+    {
+        return {lower_bound(k), upper_bound(k)};
+    }
+
+    // Order statistics
+
+    /**
+     * @brief Returns the element at position @a k in ascending order, or
+     * end() if the tree holds @a k elements or less.
+     */
+    iterator
+    select(size_type k)
+        requires _Counting_augment<_Augment, _Val>
+    {
+        return iterator(const_cast<_Node_ptr>(_select(k)));
+    }
+
+    const_iterator
+    select(size_type k) const
+        requires _Counting_augment<_Augment, _Val>
+    {
+        return const_iterator(_select(k));
+    }
+
+    /**
+     * @brief Returns the number of elements whose key is less than @a k,
+     * i.e. the position of lower_bound(k).
+     */
+    size_type
+    rank(const key_type &k) const
+        requires _Counting_augment<_Augment, _Val>
+    {
+        const _Augment aug{};
+        size_type res = 0;
+        _Const_ptr x  = _root();
+
+        while (x != nullptr)
+        {
+            if (_comp(_S_key(x), k))
+            {
+                res += aug.size(_S_aug(x->_left)) + 1;
+                x = x->_right;
+            }
+            else
+                x = x->_left;
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Returns the number of elements whose key is in [lo, hi).
+     */
+    size_type
+    count_range(const key_type &lo, const key_type &hi) const
+        requires _Counting_augment<_Augment, _Val>
+    {
+        if (!_comp(lo, hi))
+            return 0;
+        return rank(hi) - rank(lo);
+    }
+
+    /**
+     * @brief Returns the augmented data folded over the elements whose key is
+     * in [lo, hi), in ascending order.
+     *
+     * Only the paths from the root to @a lo and to @a hi are visited.
+     */
+    auto
+    fold(const key_type &lo, const key_type &hi) const
+        requires _S_augmented
+    {
+        using _Data = typename _Augment::value_type;
+        const _Augment aug{};
+
+        // Look for the highest node in the range. The nodes in the range are
+        // the ones of its left subtree not less than lo, itself, and the ones
+        // of its right subtree less than hi.
+        _Const_ptr x = _root();
+        while (x != nullptr)
+        {
+            if (_comp(_S_key(x), lo))
+                x = x->_right;
+            else if (!_comp(_S_key(x), hi))
+                x = x->_left;
+            else
+                break;
+        }
+
+        if (x == nullptr)
+            return _Data(_Augment::identity());
+
+        _Data left = _Augment::identity();
+        for (_Const_ptr y = x->_left; y != nullptr;)
+        {
+            if (!_comp(_S_key(y), lo))
+            {
+                left = aug(aug(aug(*y->_valptr()), _S_aug(y->_right)), left);
+                y    = y->_left;
+            }
+            else
+                y = y->_right;
+        }
+
+        _Data right = _Augment::identity();
+        for (_Const_ptr y = x->_right; y != nullptr;)
+        {
+            if (_comp(_S_key(y), hi))
+            {
+                right = aug(right, aug(_S_aug(y->_left), aug(*y->_valptr())));
+                y     = y->_right;
+            }
+            else
+                y = y->_left;
+        }
+
+        return _Data(aug(aug(left, aug(*x->_valptr())), right));
+    }
+
+    // Traversal
+
+    /**
+     * @brief Calls @a fn on every element in ascending order.
+     *
+     * This is faster than a loop over the iterators for a full scan.
+     * Incrementing an iterator past a subtree climbs the parent pointers back
+     * up, one dependent load per level. Here the path to the current node is
+     * kept on a stack instead, so each node is loaded once, and the right
+     * child of a node is prefetched as soon as the node is pushed. The nodes
+     * are gathered by batches before @a fn is called on them, so that the
+     * loads of the walk are not interleaved with the work of @a fn.
+     *
+     * @a fn must not insert nor remove elements.
+     */
+    template <typename _Fn>
+    void
+    for_each_inorder(_Fn fn)
+    {
+        _for_each_inorder([&fn](_Node_ptr x) { fn(*x->_valptr()); });
+    }
+
+    template <typename _Fn>
+    void
+    for_each_inorder(_Fn fn) const
+    {
+        _for_each_inorder([&fn](_Const_ptr x) { fn(*x->_valptr()); });
+    }
+
+    // Bulk loading
+
+    /**
+     * @brief Creates a tree from a sorted range in linear time.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     * @param comp  Comparison object.
+     * @param alloc Allocator object.
+     *
+     * The range must be sorted by @a comp. Only the first of equivalent keys
+     * is kept. The nodes are linked into a perfectly balanced tree directly,
+     * so there is no comparison against the tree and no rebalancing.
+     */
+    template <std::forward_iterator _ForwardIter>
+    static _Bi_search_tree
+    from_sorted(_ForwardIter first, _ForwardIter last,
+                const _Compare &comp = _Compare(),
+                const _Alloc &alloc  = _Alloc())
+    {
+        _Bi_search_tree tree(comp, alloc);
+        tree.insert_sorted(first, last);
+        return tree;
+    }
+
+    /**
+     * @brief Inserts a sorted range of values.
+     *
+     * @param first A forward iterator to mark the range.
+     * @param last  A forward iterator to mark the range.
+     *
+     * The range must be sorted by the comparison object of the tree. Keys
+     * that already exist are not inserted. A batch of k values is merged with
+     * the n nodes of the tree and the result is rebuilt into a perfectly
+     * balanced tree in O(n + k), reusing the existing nodes. When the batch is
+     * too small for that to pay off, i.e. k log n < n, the values are
+     * inserted one by one, each using the previous one as a hint.
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        _insert_sorted<true>(first, last);
+    }
+
+    /**
+     * @brief Inserts a sorted range of values, keeping equivalent keys.
+     *
+     * Same as insert_sorted(), but every value is inserted. The values of the
+     * range go after the elements of the tree with an equivalent key, and
+     * keep their relative order.
+     */
+    template <std::forward_iterator _ForwardIter>
+    void
+    insert_sorted_equal(_ForwardIter first, _ForwardIter last)
+    {
+        _insert_sorted<false>(first, last);
+    }
+
+private:
+    _Compare _comp;
+    _Node _header;
+    size_type _count;
+    _Node_pool_type _pool;
+
+    /**
+     * Implements insert_sorted() and insert_sorted_equal().
+     */
+    template <bool _Unique, typename _ForwardIter>
+    void
+    _insert_sorted(_ForwardIter first, _ForwardIter last)
+    {
+        const size_type batch = size_type(std::distance(first, last));
+        if (batch == 0)
+            return;
+
+        if (batch * size_type(std::bit_width(_count)) < _count)
+        {
+            const_iterator hint = end();
+            for (; first != last; ++first)
+            {
+                if constexpr (_Unique)
+                    hint = std::next(
+                        const_iterator(_insert_hint_unique(hint, *first)));
+                else
+                    _insert_equal(*first);
+            }
+            return;
+        }
+
+        _Node_ptr old  = _flatten();
+        _Node_ptr head = nullptr;
+        _Node_ptr tail = nullptr;
+        size_type n    = 0;
+
+        auto append = [&](_Node_ptr x)
+        {
+            if (tail == nullptr)
+                head = x;
+            else
+                tail->_right = x;
+            tail = x;
+            n++;
+        };
+
+        try
+        {
+            while (first != last)
+            {
+                const key_type &k = _KeyOfValue()(*first);
+                M_Assert(tail == nullptr || !_comp(k, _S_key(tail)),
+                         "insert_sorted() requires a sorted range");
+
+                if (_Unique && tail != nullptr && !_comp(_S_key(tail), k))
+                    ++first;
+                else if (old != nullptr && !_comp(k, _S_key(old)))
+                {
+                    append(old);
+                    old = old->_left;
+                }
+                else
+                {
+                    append(_create_node(*first));
+                    ++first;
+                }
+            }
+        }
+        catch (...)
+        {
+            // Every node left in the old tree is greater than the merged
+            // ones, so the tree can be rebuilt with what is already there.
+            for (; old != nullptr; old = old->_left)
+                append(old);
+            _link_sorted(head, n);
+            throw;
+        }
+
+        for (; old != nullptr; old = old->_left)
+            append(old);
+        _link_sorted(head, n);
+    }
+
+    _Node_ptr &
+    _root() noexcept
+    {
+        return _header._parent;
+    }
+
+    _Const_ptr
+    _root() const noexcept
+    {
+        return _header._parent;
+    }
+
+    static const key_type &
+    _S_key(_Const_ptr x)
+    {
+        return _KeyOfValue()(*x->_valptr());
+    }
+
+    /**
+     * Returns the augmented data of the subtree rooted at @a x, which might
+     * be null.
+     */
+    static auto
+    _S_aug(_Const_ptr x) noexcept
+    {
+        using _Data = typename _Augment::value_type;
+
+        if (x == nullptr)
+            return _Data(_Augment::identity());
+        return static_cast<const _Alloc_node *>(x)->_aug;
+    }
+
+    /**
+     * Recomputes the augmented data of @a x from its value and its children.
+     */
+    static void
+    _S_update(_Node_ptr x) noexcept
+    {
+        if constexpr (_S_augmented)
+        {
+            const _Augment aug{};
+            static_cast<_Alloc_node *>(x)->_aug = aug(
+                aug(_S_aug(x->_left), aug(*x->_valptr())), _S_aug(x->_right));
+        }
+    }
+
+    struct _Node_update
+    {
+        void
+        operator()(_Node_ptr x) const noexcept
+        {
+            _S_update(x);
+        }
+    };
+
+    /**
+     * Recomputes the augmented data of @a x and of all its ancestors.
+     */
+    void
+    _update_path(_Node_ptr x) noexcept
+    {
+        if constexpr (_S_augmented)
+        {
+            for (; x != &_header; x = x->_parent)
+                _S_update(x);
+        }
+    }
+
+    /**
+     * Returns the lowest node whose subtree loses a node when @a z is
+     * unlinked. That is the parent of @a z, unless @a z has two children
+     * and is replaced by its successor, whose former position is the one
+     * actually removed.
+     */
+    _Node_ptr
+    _lowest_changed_on_erase(_Node_ptr z) noexcept
+    {
+        if (z->_left == nullptr || z->_right == nullptr)
+            return z->_parent;
+
+        _Node_ptr y = _Node::_leftmost(z->_right);
+        return y == z->_right ? y : y->_parent;
+    }
+
+    // Bound on the height of the tree, which for a red-black tree is at most
+    // twice the number of bits of its size.
+    constexpr static size_type _S_max_height =
+        2 * std::numeric_limits<size_type>::digits;
+
+    constexpr static size_type _S_batch_size = 32;
+
+    /**
+     * Walks the tree in order with an explicit stack and calls @a visit on
+     * batches of nodes. See for_each_inorder().
+     */
+    template <typename _Visit>
+    void
+    _for_each_inorder(_Visit visit) const
+    {
+        _Node_ptr stack[_S_max_height];
+        _Node_ptr batch[_S_batch_size];
+        size_type depth = 0;
+        size_type count = 0;
+        _Node_ptr x     = const_cast<_Node_ptr>(_root());
+
+        while (true)
+        {
+            for (; x != nullptr; x = x->_left)
+            {
+                M_Assert(depth < _S_max_height, "Tree is too high");
+                __builtin_prefetch(x->_right);
+                stack[depth++] = x;
+            }
+
+            if (depth == 0)
+                break;
+
+            x              = stack[--depth];
+            batch[count++] = x;
+            if (count == _S_batch_size)
+            {
+                for (size_type i = 0; i < count; i++)
+                    visit(batch[i]);
+                count = 0;
+            }
+
+            x = x->_right;
+        }
+
+        for (size_type i = 0; i < count; i++)
+            visit(batch[i]);
+    }
+
+    _Const_ptr
+    _select(size_type k) const noexcept
+    {
+        const _Augment aug{};
+        _Const_ptr x = _root();
+
+        while (x != nullptr)
+        {
+            const size_type n_left = aug.size(_S_aug(x->_left));
+
+            if (k < n_left)
+                x = x->_left;
+            else if (k == n_left)
+                return x;
+            else
+            {
+                k -= n_left + 1;
+                x = x->_right;
+            }
+        }
+
+        return &_header;
+    }
+
+    /**
+     * Resets the header to the empty state: no root, and the leftmost and
+     * rightmost nodes are the header itself so that begin() == end().
+     */
+    void
+    _reset() noexcept
+    {
+        _header._parent = nullptr;
+        _header._left   = &_header;
+        _header._right  = &_header;
+        _header._tag    = _Node::_S_header_tag;
+        _count          = 0;
+    }
+
+    /**
+     * Takes over the nodes of @a other and leaves it empty. This tree must be
+     * empty.
+     */
+    void
+    _steal(_Bi_search_tree &other) noexcept
+    {
+        if (other._root() != nullptr)
+        {
+            _root()          = other._root();
+            _header._left    = other._header._left;
+            _header._right   = other._header._right;
+            _root()->_parent = &_header;
+            _count           = other._count;
+
+            other._reset();
+        }
+    }
+
+    template <typename... Args>
+    _Node_ptr
+    _create_node(Args &&...args)
+    {
+        _Alloc_node *z = _pool.allocate();
+        ::new (static_cast<void *>(z)) _Alloc_node;
+
+        try
+        {
+            std::construct_at(z->_valptr(), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::destroy_at(z);
+            _pool.deallocate(z);
+            throw;
+        }
+
+        return z;
+    }
+
+    /**
+     * Destroys the value of @a z, then the node itself, which holds the
+     * augmented data if any, but keeps its memory.
+     */
+    static void
+    _destroy_node(_Node_ptr z) noexcept
+    {
+        _Alloc_node *node = static_cast<_Alloc_node *>(z);
+        std::destroy_at(node->_valptr());
+        std::destroy_at(node);
+    }
+
+    void
+    _drop_node(_Node_ptr z) noexcept
+    {
+        _destroy_node(z);
+        _pool.deallocate(static_cast<_Alloc_node *>(z));
+    }
+
+    /**
+     * Destroys the subtree rooted at @a x without rebalancing and gives its
+     * nodes back to the pool. Recurses on the right children and loops on the
+     * left ones.
+     */
+    void
+    _erase_subtree(_Node_ptr x) noexcept
+    {
+        while (x != nullptr)
+        {
+            _erase_subtree(x->_right);
+            _Node_ptr y = x->_left;
+            _drop_node(x);
+            x = y;
+        }
+    }
+
+    /**
+     * Unlinks every node and chains them in order through their left child.
+     * The tree is left empty and the first node is returned.
+     *
+     * A node is only chained once the in-order walk is past it, and the walk
+     * never reads the left child of such a node again.
+     */
+    _Node_ptr
+    _flatten() noexcept
+    {
+        _Node_ptr head = nullptr;
+        _Node_ptr prev = nullptr;
+        _Node_ptr x    = _header._left;
+
+        while (x != &_header)
+        {
+            _Node_ptr next = iterator::_increment(x);
+
+            if (prev == nullptr)
+                head = x;
+            else
+                prev->_left = x;
+            prev = x;
+            x    = next;
+        }
+
+        if (prev != nullptr)
+            prev->_left = nullptr;
+
+        _reset();
+        return head;
+    }
+
+    /**
+     * Links the @a n nodes chained in order through their right child from
+     * @a head into a perfectly balanced tree, which becomes the content of
+     * this empty tree.
+     */
+    void
+    _link_sorted(_Node_ptr head, size_type n) noexcept
+    {
+        if (n == 0)
+            return;
+
+        const size_type full = size_type(std::bit_width(n + 1)) - 1;
+
+        _root()          = _build_balanced(head, n, 0, full);
+        _root()->_parent = &_header;
+        _header._left    = _Node::_leftmost(_root());
+        _header._right   = _Node::_rightmost(_root());
+        _count           = n;
+    }
+
+    /**
+     * Builds a subtree from the next @a n nodes of the chain starting at
+     * @a list, by splitting the chain at its middle node, and advances
+     * @a list past them. The nodes are consumed in order, so the chain is
+     * never indexed.
+     */
+    _Node_ptr
+    _build_balanced(_Node_ptr &list, size_type n, size_type depth,
+                    size_type full) noexcept
+    {
+        if (n == 0)
+            return nullptr;
+
+        const size_type n_left = (n - 1) / 2;
+        _Node_ptr left = _build_balanced(list, n_left, depth + 1, full);
+
+        _Node_ptr x = list;
+        list        = list->_right;
+
+        x->_left = left;
+        if (left != nullptr)
+            left->_parent = x;
+
+        x->_right = _build_balanced(list, n - 1 - n_left, depth + 1, full);
+        if (x->_right != nullptr)
+            x->_right->_parent = x;
+
+        x->_tag = _Balance::_balanced_tag(depth, full, n);
+        _S_update(x);
+        return x;
+    }
+
+    /**
+     * Destroys the nodes of the subtree rooted at @a x, but leaves their
+     * memory to the pool, which is about to be released as a whole.
+     */
+    void
+    _destroy_values(_Node_ptr x) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type> ||
+                      !std::is_trivially_destructible_v<_Alloc_node>)
+        {
+            while (x != nullptr)
+            {
+                _destroy_values(x->_right);
+                _Node_ptr y = x->_left;
+                _destroy_node(x);
+                x = y;
+            }
+        }
+    }
+
+    /**
+     * Clones the nodes of @a other into this empty tree, with the same shape.
+     * The values are moved out of @a other if @a _Move.
+     */
+    template <bool _Move = false>
+    void
+    _clone(const _Bi_search_tree &other)
+    {
+        if (other._root() != nullptr)
+        {
+            _root()        = _copy<_Move>(other._root(), &_header);
+            _header._left  = _Node::_leftmost(_root());
+            _header._right = _Node::_rightmost(_root());
+            _count         = other._count;
+        }
+    }
+
+    /**
+     * Clones the subtree rooted at @a x and hangs it under @a p.
+     */
+    template <bool _Move>
+    _Node_ptr
+    _copy(_Const_ptr x, _Node_ptr p)
+    {
+        _Node_ptr top = _clone_node<_Move>(x);
+        top->_parent  = p;
+
+        try
+        {
+            if (x->_right != nullptr)
+                top->_right = _copy<_Move>(x->_right, top);
+            p = top;
+            x = x->_left;
+
+            while (x != nullptr)
+            {
+                _Node_ptr y = _clone_node<_Move>(x);
+                p->_left    = y;
+                y->_parent  = p;
+                if (x->_right != nullptr)
+                    y->_right = _copy<_Move>(x->_right, y);
+                p = y;
+                x = x->_left;
+            }
+        }
+        catch (...)
+        {
+            _erase_subtree(top);
+            throw;
+        }
+
+        return top;
+    }
+
+    template <bool _Move>
+    _Node_ptr
+    _clone_node(_Const_ptr x)
+    {
+        _Node_ptr y;
+        if constexpr (_Move)
+            y = _create_node(std::move(*const_cast<_Node_ptr>(x)->_valptr()));
+        else
+            y = _create_node(*x->_valptr());
+        y->_tag     = x->_tag;
+        y->_left    = nullptr;
+        y->_right   = nullptr;
+
+        if constexpr (_S_augmented)
+            static_cast<_Alloc_node *>(y)->_aug =
+                static_cast<const _Alloc_node *>(x)->_aug;
+
+        return y;
+    }
+
+    _Const_ptr
+    _lower_bound(_Const_ptr x, _Const_ptr y, const key_type &k) const
+    {
+        while (x != nullptr)
+        {
+            if (!_comp(_S_key(x), k))
+            {
+                y = x;
+                x = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+
+        return y;
+    }
+
+    _Const_ptr
+    _upper_bound(_Const_ptr x, _Const_ptr y, const key_type &k) const
+    {
+        while (x != nullptr)
+        {
+            if (_comp(k, _S_key(x)))
+            {
+                y = x;
+                x = x->_left;
+            }
+            else
+                x = x->_right;
+        }
+
+        return y;
+    }
+
+    /**
+     * Finds where a node with key @a k would be linked. Returns the pair
+     * (x, p) where p is the parent to be, or (node, nullptr) if a node with an
+     * equivalent key already exists.
+     */
+    std::pair<_Node_ptr, _Node_ptr>
+    _get_insert_unique_pos(const key_type &k)
+    {
+        _Node_ptr x = _root();
+        _Node_ptr y = &_header;
+        bool comp   = true;
+
+        while (x != nullptr)
+        {
+            y    = x;
+            comp = _comp(k, _S_key(x));
+            x    = comp ? x->_left : x->_right;
+        }
+
+        iterator j(y);
+        if (comp)
+        {
+            if (j == begin())
+                return {x, y};
+            --j;
+        }
+
+        if (_comp(_S_key(j._node), k))
+            return {x, y};
+
+        return {j._node, nullptr};
+    }
+
+    /**
+     * Returns the parent to be of a node with key @a k that goes after the
+     * nodes with an equivalent key.
+     */
+    _Node_ptr
+    _get_insert_equal_pos(const key_type &k)
+    {
+        _Node_ptr x = _root();
+        _Node_ptr y = &_header;
+
+        while (x != nullptr)
+        {
+            y = x;
+            x = _comp(k, _S_key(x)) ? x->_left : x->_right;
+        }
+
+        return y;
+    }
+
+    /**
+     * Same as _get_insert_unique_pos(), but checks first whether the key goes
+     * right before or right after @a hint.
+     */
+    std::pair<_Node_ptr, _Node_ptr>
+    _get_insert_hint_unique_pos(const_iterator hint, const key_type &k)
+    {
+        iterator pos = hint._const_cast();
+
+        if (pos._node == &_header)
+        {
+            if (size() > 0 && _comp(_S_key(_header._right), k))
+                return {nullptr, _header._right};
+
+            return _get_insert_unique_pos(k);
+        }
+
+        if (_comp(k, _S_key(pos._node)))
+        {
+            // Goes before the hint
+            if (pos._node == _header._left)
+                return {_header._left, _header._left};
+
+            iterator before = pos;
+            --before;
+            if (_comp(_S_key(before._node), k))
+            {
+                if (before._node->_right == nullptr)
+                    return {nullptr, before._node};
+                return {pos._node, pos._node};
+            }
+
+            return _get_insert_unique_pos(k);
+        }
+
+        if (_comp(_S_key(pos._node), k))
+        {
+            // Goes after the hint
+            if (pos._node == _header._right)
+                return {nullptr, _header._right};
+
+            iterator after = pos;
+            ++after;
+            if (_comp(k, _S_key(after._node)))
+            {
+                if (pos._node->_right == nullptr)
+                    return {nullptr, pos._node};
+                return {after._node, after._node};
+            }
+
+            return _get_insert_unique_pos(k);
+        }
+
+        // Equivalent key
+        return {pos._node, nullptr};
+    }
+
+    /**
+     * Links @a z under @a p as computed by one of the _get_insert_*_pos()
+     * functions.
+     */
+    iterator
+    _insert_node(_Node_ptr x, _Node_ptr p, _Node_ptr z)
+    {
+        const bool insert_left =
+            (x != nullptr || p == &_header || _comp(_S_key(z), _S_key(p)));
+
+        _Balance::_insert_and_rebalance(insert_left, z, p, _header,
+                                        _Node_update());
+        _update_path(z);
+        ++_count;
+
+        return iterator(z);
+    }
 };
 
 } // namespace opendsa
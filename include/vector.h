@@ -171,7 +171,7 @@ namespace opendsa
         ~vector()
         {
             using traits_t          = std::allocator_traits<allocator>;
-            const difference_type n = std::distance(_start, _finish);
+            const difference_type n = std::distance(_start, _end);
 
             for (auto curr = _start; curr != _finish; curr++)
                 traits_t::destroy(_alloc, std::addressof(*curr));
@@ -292,7 +292,7 @@ namespace opendsa
                 const size_type old_size = size();
 
                 pointer new_start = traits_t::allocate(_alloc, new_cap);
-                for (size_type i = 0; i < new_cap; i++)
+                for (size_type i = 0; i < old_size; i++)
                     traits_t::construct(_alloc,
                                         std::addressof(*(new_start + i)),
                                         *(_start + i));
@@ -487,6 +487,7 @@ namespace opendsa
                 std::move(normal_pos + 1, end(), normal_pos);
 
             _finish--;
+            std::allocator_traits<allocator>::destroy(_alloc, _finish);
 
             return normal_pos;
         }